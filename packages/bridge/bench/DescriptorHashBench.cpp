@@ -0,0 +1,119 @@
+// Times `hash()` and `equals()` on records of a few megabytes up to 64 MB,
+//  through the same `DescriptorHash` functions the wrappers call. `equals()`
+//  is timed on an equal copy that shares no storage (the worst case, since
+//  every byte is compared), on a copy that differs only in its last byte, and
+//  on a record whose size differs, which is settled without flattening.
+//
+// Runs against the portable engine, so it builds anywhere:
+//  `build/Release/ae_js_descriptor_hash_bench [max megabytes]`.
+
+#include "DescriptorHash.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace DescriptorHash = ae_js_bridge::DescriptorHash;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kFieldSize = 64 * 1024;
+constexpr int kRounds = 5;
+
+// A record of `fieldCount` 64 KB fields of pseudo-random bytes. `lastByte` is
+//  written to the very end of the last field.
+AEDesc MakeRecord(size_t fieldCount, char lastByte) {
+  AEDesc record;
+  AECreateList(nullptr, 0, true, &record);
+  std::vector<char> data(kFieldSize);
+  uint32_t state = 12345;
+  for (size_t field = 0; field < fieldCount; ++field) {
+    for (char &byte : data) {
+      state = state * 1103515245 + 12345;
+      byte = static_cast<char>(state >> 24);
+    }
+    if (field + 1 == fieldCount) {
+      data.back() = lastByte;
+    }
+    AEDesc value;
+    AECreateDesc(typeData, data.data(), static_cast<Size>(data.size()),
+                 &value);
+    AEPutKeyDesc(&record, 0x41000000u + static_cast<AEKeyword>(field),
+                 &value);
+    AEDisposeDesc(&value);
+  }
+  return record;
+}
+
+// The best of `kRounds` runs, in milliseconds.
+template <typename Run> double BestMilliseconds(Run run) {
+  double best = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    const Clock::time_point start = Clock::now();
+    run();
+    const double elapsed =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    if (round == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t maxMegabytes =
+      argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 64;
+
+  std::printf("%6s %12s %12s %12s %12s %12s  (ms)\n", "MB", "hash",
+              "hash GB/s", "equal", "last byte", "other size");
+  for (size_t megabytes = 1; megabytes <= maxMegabytes; megabytes *= 4) {
+    const size_t fieldCount = megabytes * 1024 * 1024 / kFieldSize;
+    AEDesc record = MakeRecord(fieldCount, 'a');
+    AEDesc copy = MakeRecord(fieldCount, 'a');
+    AEDesc lastByteDiffers = MakeRecord(fieldCount, 'b');
+    AEDesc smaller = MakeRecord(fieldCount - 1, 'a');
+
+    uint64_t hash = 0;
+    uint64_t copyHash = 0;
+    bool failed = DescriptorHash::HashDescriptor(&copy, &copyHash) != noErr;
+    const double hashing = BestMilliseconds([&] {
+      failed |= DescriptorHash::HashDescriptor(&record, &hash) != noErr;
+    });
+    bool equal = false;
+    bool lastByteEqual = true;
+    bool smallerEqual = true;
+    const double comparing = BestMilliseconds([&] {
+      failed |= DescriptorHash::DescriptorsEqual(&record, &copy, &equal) !=
+                noErr;
+    });
+    const double comparingLastByte = BestMilliseconds([&] {
+      failed |= DescriptorHash::DescriptorsEqual(&record, &lastByteDiffers,
+                                                 &lastByteEqual) != noErr;
+    });
+    const double comparingSize = BestMilliseconds([&] {
+      failed |= DescriptorHash::DescriptorsEqual(&record, &smaller,
+                                                 &smallerEqual) != noErr;
+    });
+
+    AEDisposeDesc(&record);
+    AEDisposeDesc(&copy);
+    AEDisposeDesc(&lastByteDiffers);
+    AEDisposeDesc(&smaller);
+    if (failed || hash != copyHash || !equal || lastByteEqual ||
+        smallerEqual) {
+      std::fprintf(stderr, "wrong result at %zu MB\n", megabytes);
+      return 1;
+    }
+
+    const double gigabytesPerSecond =
+        static_cast<double>(megabytes) / 1024 / (hashing / 1000);
+    std::printf("%6zu %12.2f %12.2f %12.2f %12.2f %12.4f\n", megabytes,
+                hashing, gigabytesPerSecond, comparing, comparingLastByte,
+                comparingSize);
+  }
+  return 0;
+}
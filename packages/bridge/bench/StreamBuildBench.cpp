@@ -0,0 +1,160 @@
+// Times building lists and records the way `AEListDescriptor::InitFromJS` and
+//  `AERecordDescriptor::InitFromJS` do, through an AEStream, against putting
+//  each item in with `AEPutDesc`/`AEPutKeyDesc`. Sizes go up to a million
+//  items; the time per item should stay flat as they grow. Putting items in
+//  one at a time is only timed up to `kMaxPutItems`, since `AEPutKeyDesc`
+//  checks every field already in the record, which makes those builds
+//  quadratic.
+//
+// Runs against the portable engine, so it builds anywhere:
+//  `build/Release/ae_js_stream_build_bench [max items]`. Exits with 1 if the
+//  time per streamed item at the largest size is more than 4 times what it is
+//  at the smallest.
+
+#include "AEPortable.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr long kMaxPutItems = 10000;
+
+// The items a build puts together: existing descriptors, as the wrappers hand
+//  them over.
+std::vector<AEDesc> MakeItems(long count) {
+  std::vector<AEDesc> items(static_cast<size_t>(count));
+  for (long index = 0; index < count; ++index) {
+    const double value = static_cast<double>(index);
+    AECreateDesc(typeIEEE64BitFloatingPoint, &value, sizeof(value),
+                 &items[static_cast<size_t>(index)]);
+  }
+  return items;
+}
+
+// Distinct for every index, since a record keeps one field per keyword.
+AEKeyword KeywordFor(long index) {
+  return 0x41000000u + static_cast<AEKeyword>(index);
+}
+
+// Closes `stream`, keeping what was written only if `err` is `noErr`.
+OSStatus CloseStream(AEStreamRef stream, OSStatus err, AEDesc *outDesc) {
+  if (err != noErr) {
+    AEStreamClose(stream, nullptr);
+    return err;
+  }
+  return AEStreamClose(stream, outDesc);
+}
+
+OSStatus StreamList(const std::vector<AEDesc> &items, AEDesc *outDesc) {
+  AEStreamRef stream = AEStreamOpen();
+  OSStatus err = AEStreamOpenList(stream);
+  for (size_t index = 0; index < items.size() && err == noErr; ++index) {
+    err = AEStreamWriteAEDesc(stream, &items[index]);
+  }
+  if (err == noErr) {
+    err = AEStreamCloseList(stream);
+  }
+  return CloseStream(stream, err, outDesc);
+}
+
+OSStatus StreamRecord(const std::vector<AEDesc> &items, AEDesc *outDesc) {
+  AEStreamRef stream = AEStreamOpen();
+  OSStatus err = AEStreamOpenRecord(stream, typeAERecord);
+  for (size_t index = 0; index < items.size() && err == noErr; ++index) {
+    err = AEStreamWriteKey(stream, KeywordFor(static_cast<long>(index)));
+    if (err == noErr) {
+      err = AEStreamWriteAEDesc(stream, &items[index]);
+    }
+  }
+  if (err == noErr) {
+    err = AEStreamCloseRecord(stream);
+  }
+  return CloseStream(stream, err, outDesc);
+}
+
+OSStatus PutList(const std::vector<AEDesc> &items, AEDesc *outDesc) {
+  OSStatus err = AECreateList(nullptr, 0, false, outDesc);
+  for (size_t index = 0; index < items.size() && err == noErr; ++index) {
+    err = AEPutDesc(outDesc, 0, &items[index]);
+  }
+  return err;
+}
+
+OSStatus PutRecord(const std::vector<AEDesc> &items, AEDesc *outDesc) {
+  OSStatus err = AECreateList(nullptr, 0, true, outDesc);
+  for (size_t index = 0; index < items.size() && err == noErr; ++index) {
+    err = AEPutKeyDesc(outDesc, KeywordFor(static_cast<long>(index)),
+                       &items[index]);
+  }
+  return err;
+}
+
+// Returns nanoseconds per item, or a negative number if the build failed.
+template <typename Build>
+double NanosecondsPerItem(const std::vector<AEDesc> &items, Build build) {
+  AEDesc built;
+  AEInitializeDesc(&built);
+  const Clock::time_point start = Clock::now();
+  OSStatus err = build(items, &built);
+  const Clock::duration elapsed = Clock::now() - start;
+  long count = 0;
+  if (err == noErr) {
+    err = AECountItems(&built, &count);
+  }
+  AEDisposeDesc(&built);
+  if (err != noErr || count != static_cast<long>(items.size())) {
+    std::fprintf(stderr, "build of %zu items failed (%d)\n", items.size(),
+                 static_cast<int>(err));
+    return -1;
+  }
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(items.size());
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const long maxItems = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+  std::printf("%10s %12s %12s %12s %12s  (ns per item)\n", "items",
+              "stream list", "put list", "stream reco", "put reco");
+  double firstPerItem = 0;
+  double lastPerItem = 0;
+  for (long count = 1000; count <= maxItems; count *= 10) {
+    std::vector<AEDesc> items = MakeItems(count);
+    const bool timePuts = count <= kMaxPutItems;
+    const double streamList = NanosecondsPerItem(items, StreamList);
+    const double putList = timePuts ? NanosecondsPerItem(items, PutList) : 0;
+    const double streamRecord = NanosecondsPerItem(items, StreamRecord);
+    const double putRecord =
+        timePuts ? NanosecondsPerItem(items, PutRecord) : 0;
+    for (AEDesc &item : items) {
+      AEDisposeDesc(&item);
+    }
+    if (streamList < 0 || putList < 0 || streamRecord < 0 || putRecord < 0) {
+      return 1;
+    }
+    if (timePuts) {
+      std::printf("%10ld %12.1f %12.1f %12.1f %12.1f\n", count, streamList,
+                  putList, streamRecord, putRecord);
+    } else {
+      std::printf("%10ld %12.1f %12s %12.1f %12s\n", count, streamList, "-",
+                  streamRecord, "-");
+    }
+
+    const double streamed = streamList + streamRecord;
+    if (firstPerItem == 0) {
+      firstPerItem = streamed;
+    }
+    lastPerItem = streamed;
+  }
+
+  if (lastPerItem > 4 * firstPerItem) {
+    std::fprintf(stderr, "streamed builds don't scale linearly\n");
+    return 1;
+  }
+  return 0;
+}
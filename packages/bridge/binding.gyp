@@ -1,39 +1,308 @@
 {
+    "variables": {
+        # Set to 1 (e.g. `node-gyp configure -- -Dae_js_portable_engine=1`) to
+        #   build the addon on top of the portable descriptor engine instead of
+        #   CoreServices.
+        "ae_js_portable_engine%": 0,
+        # Whether node-addon-api can be found. Always so on macOS; elsewhere the
+        #   addon is only built when it can be, so that the portable targets
+        #   above still configure without `npm install`.
+        "ae_js_node_addon_api%": "<!(node -e \"try { require.resolve('node-addon-api'); console.log(1) } catch { console.log(0) }\")"
+    },
     "targets": [
         {
-            "target_name": "ae_js_bridge_native",
+            # The threads outgoing Apple events are sent on, and the table
+            #   queued replies are matched up in. Independent of both
+            #   CoreServices and Node, so this builds on Linux as well.
+            "target_name": "ae_js_send_executor",
+            "type": "static_library",
             "sources": [
-                "src/native/ae_js_bridge.mm",
-                "src/native/AEDescriptor.mm",
-                "src/native/AppleEventAPI.mm",
-                "src/native/helpers.mm",
-                "src/native/OSError.mm",
-
+                "src/native/InFlightTable.cpp",
+                "src/native/SendExecutor.cpp",
             ],
-            "defines": [
-                "NODE_ADDON_API_CPP_EXCEPTIONS"
+            "cflags_cc": [
+                "-std=c++20",
+                "-pthread"
+            ],
+            "xcode_settings": {
+                "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                "CLANG_CXX_LIBRARY": "libc++",
+                "OTHER_CPLUSPLUSFLAGS": [
+                    "-std=c++20"
+                ]
+            }
+        },
+        {
+            # A CoreServices-free implementation of descriptors, behind the same
+            #   API the bridge uses from the Apple Event Manager. Unlike the
+            #   addon itself, this builds on Linux as well.
+            "target_name": "ae_js_descriptor_engine",
+            "type": "static_library",
+            "sources": [
+                "src/native/AEPortable.cpp",
+                "src/native/DescriptorEngine.cpp",
+            ],
+            "cflags_cc": [
+                "-std=c++20",
+                "-fexceptions"
+            ],
+            "cflags_cc!": [
+                "-fno-exceptions"
             ],
-            "include_dirs": [
-                "<!@(node -p \"require('node-addon-api').include\")"
-            ],
-            # Including this causes the build to emit a mock `node_modules` directory
-            #   one level up from our project root. This behavior is not desired, and
-            #   it's also (weirdly) not really documented anywhere. Removing it stops
-            #   this behavior and doesn't seem to affect the build in any other way.
-            # "dependencies": [
-            #     "<!(node -p \"require('node-addon-api').gyp\")"
-            # ],
             "xcode_settings": {
                 "MACOSX_DEPLOYMENT_TARGET": "13.3",
                 "CLANG_CXX_LIBRARY": "libc++",
                 "OTHER_CPLUSPLUSFLAGS": [
                     "-std=c++20",
                     "-fexceptions"
-                ],
-                "OTHER_CFLAGS": [
-                    "-fobjc-arc"
+                ]
+            }
+        },
+        {
+            # Round-trips descriptors through the portable engine's flattened
+            #   form, and feeds it truncated and damaged input.
+            "target_name": "ae_js_descriptor_engine_test",
+            "type": "executable",
+            "sources": [
+                "test/DescriptorEngineTest.cpp",
+            ],
+            "include_dirs": [
+                "src/native"
+            ],
+            "dependencies": [
+                "ae_js_descriptor_engine"
+            ],
+            "cflags_cc": [
+                "-std=c++20"
+            ],
+            "xcode_settings": {
+                "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                "CLANG_CXX_LIBRARY": "libc++",
+                "OTHER_CPLUSPLUSFLAGS": [
+                    "-std=c++20"
+                ]
+            }
+        },
+        {
+            # Races inserts, takes, removes and sweeps of the table queued
+            #   replies are matched up in, and checks deadlines expire on time.
+            "target_name": "ae_js_in_flight_table_test",
+            "type": "executable",
+            "sources": [
+                "test/InFlightTableTest.cpp",
+            ],
+            "include_dirs": [
+                "src/native"
+            ],
+            "dependencies": [
+                "ae_js_send_executor"
+            ],
+            "cflags_cc": [
+                "-std=c++20",
+                "-pthread"
+            ],
+            "ldflags": [
+                "-pthread"
+            ],
+            "xcode_settings": {
+                "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                "CLANG_CXX_LIBRARY": "libc++",
+                "OTHER_CPLUSPLUSFLAGS": [
+                    "-std=c++20"
+                ]
+            }
+        },
+        {
+            # Runs `SendExecutor` under load, with the portable engine's
+            #   `AESendMessage` standing in for a target that takes a while to
+            #   answer.
+            "target_name": "ae_js_send_executor_load_test",
+            "type": "executable",
+            "sources": [
+                "test/SendExecutorLoadTest.cpp",
+            ],
+            "include_dirs": [
+                "src/native"
+            ],
+            "dependencies": [
+                "ae_js_descriptor_engine",
+                "ae_js_send_executor"
+            ],
+            "cflags_cc": [
+                "-std=c++20",
+                "-pthread"
+            ],
+            "ldflags": [
+                "-pthread"
+            ],
+            "xcode_settings": {
+                "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                "CLANG_CXX_LIBRARY": "libc++",
+                "OTHER_CPLUSPLUSFLAGS": [
+                    "-std=c++20"
+                ]
+            }
+        },
+        {
+            # Times building lists and records through an AEStream, as the
+            #   descriptor constructors do, up to a million items.
+            "target_name": "ae_js_stream_build_bench",
+            "type": "executable",
+            "sources": [
+                "bench/StreamBuildBench.cpp",
+            ],
+            "include_dirs": [
+                "src/native"
+            ],
+            "dependencies": [
+                "ae_js_descriptor_engine"
+            ],
+            "cflags_cc": [
+                "-std=c++20"
+            ],
+            "xcode_settings": {
+                "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                "CLANG_CXX_LIBRARY": "libc++",
+                "OTHER_CPLUSPLUSFLAGS": [
+                    "-std=c++20"
+                ]
+            }
+        },
+        {
+            # Times `hash()` and `equals()` on records of up to 64 MB.
+            "target_name": "ae_js_descriptor_hash_bench",
+            "type": "executable",
+            "sources": [
+                "bench/DescriptorHashBench.cpp",
+                "src/native/DescriptorHash.cpp",
+            ],
+            "defines": [
+                "AEJS_USE_PORTABLE_ENGINE"
+            ],
+            "include_dirs": [
+                "src/native"
+            ],
+            "dependencies": [
+                "ae_js_descriptor_engine"
+            ],
+            "cflags_cc": [
+                "-std=c++20"
+            ],
+            "xcode_settings": {
+                "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                "CLANG_CXX_LIBRARY": "libc++",
+                "OTHER_CPLUSPLUSFLAGS": [
+                    "-std=c++20"
                 ]
             }
         }
+    ],
+    "conditions": [
+        ["OS=='mac' or ae_js_node_addon_api==1", {
+            "targets": [
+                {
+                    "target_name": "ae_js_bridge_native",
+                    "sources": [
+                        "src/native/ae_js_bridge.mm",
+                        "src/native/AEDescriptor.mm",
+                        "src/native/AETarget.mm",
+                        "src/native/AppleEventAPI.mm",
+                        "src/native/DescriptorHash.cpp",
+                        "src/native/DescriptorKind.mm",
+                        "src/native/helpers.mm",
+                        "src/native/ListBatchIterator.mm",
+                        "src/native/OSError.mm",
+                        "src/native/ValueConversion.mm",
+                    ],
+                    "defines": [
+                        "NODE_ADDON_API_CPP_EXCEPTIONS"
+                    ],
+                    # The descriptor engine is also what bounds-checks
+                    #   `deserialize()` input on CoreServices.
+                    "dependencies": [
+                        "ae_js_descriptor_engine",
+                        "ae_js_send_executor"
+                    ],
+                    "include_dirs": [
+                        "src/native",
+                        "<!@(node -p \"require('node-addon-api').include\")"
+                    ],
+                    # Including this causes the build to emit a mock `node_modules` directory
+                    #   one level up from our project root. This behavior is not desired, and
+                    #   it's also (weirdly) not really documented anywhere. Removing it stops
+                    #   this behavior and doesn't seem to affect the build in any other way.
+                    # "dependencies": [
+                    #     "<!(node -p \"require('node-addon-api').gyp\")"
+                    # ],
+                    "conditions": [
+                        ["OS=='mac'", {
+                            "sources": [
+                                "src/native/RunningApplications.mm"
+                            ],
+                            # For `NSRunningApplication`, which `AETarget`
+                            #   resolves bundle IDs and checks liveness with.
+                            "link_settings": {
+                                "libraries": [
+                                    "$(SDKROOT)/System/Library/Frameworks/AppKit.framework"
+                                ]
+                            }
+                        }, {
+                            # Without CoreServices, there is only the portable
+                            #   engine to build on.
+                            "sources": [
+                                "src/native/RunningApplicationsPortable.cpp"
+                            ],
+                            "defines": [
+                                "AEJS_USE_PORTABLE_ENGINE"
+                            ],
+                            "cflags_cc": [
+                                "-std=c++20",
+                                "-fexceptions"
+                            ],
+                            "cflags_cc!": [
+                                "-fno-exceptions"
+                            ],
+                            # None of the `.mm` files use Objective-C once
+                            #   `RunningApplications.mm` is left out, but the
+                            #   Makefile generator only compiles `.mm` files for
+                            #   macOS. This hands each one to the C++ compiler
+                            #   under a `.cpp` name instead.
+                            "rules": [
+                                {
+                                    "rule_name": "compile_mm_as_cpp",
+                                    "extension": "mm",
+                                    "outputs": [
+                                        "<(INTERMEDIATE_DIR)/<(RULE_INPUT_ROOT).cpp"
+                                    ],
+                                    "action": [
+                                        "cp",
+                                        "<(RULE_INPUT_PATH)",
+                                        "<(INTERMEDIATE_DIR)/<(RULE_INPUT_ROOT).cpp"
+                                    ],
+                                    "message": "Compiling <(RULE_INPUT_NAME) as C++",
+                                    "process_outputs_as_sources": 1
+                                }
+                            ]
+                        }],
+                        ["OS=='mac' and ae_js_portable_engine==1", {
+                            "defines": [
+                                "AEJS_USE_PORTABLE_ENGINE"
+                            ]
+                        }]
+                    ],
+                    "xcode_settings": {
+                        "MACOSX_DEPLOYMENT_TARGET": "13.3",
+                        "CLANG_CXX_LIBRARY": "libc++",
+                        "OTHER_CPLUSPLUSFLAGS": [
+                            "-std=c++20",
+                            "-fexceptions"
+                        ],
+                        "OTHER_CFLAGS": [
+                            "-fobjc-arc"
+                        ]
+                    }
+                }
+            ]
+        }]
     ]
-}
\ No newline at end of file
+}
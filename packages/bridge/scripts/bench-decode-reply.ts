@@ -0,0 +1,90 @@
+import { endianness } from "node:os";
+import { argv } from "node:process";
+
+import {
+    AEDescriptor,
+    AEEventDescriptor,
+    AETarget,
+    sendAppleEvent,
+    ToJSValueOptions,
+} from "#ae_js_bridge_native";
+
+// Compares how much time the event loop spends on each reply when it decodes
+//  the reply itself, with `toJSValue()`, against `decodeReply`, which decodes
+//  it on the send thread. The event asks System Events for the properties of
+//  every process, which makes for a reply of a few hundred records.
+//
+// Usage: node ./scripts/bench-decode-reply.js [sends] [bundle ID]
+
+const sendCount = Number(argv[2] ?? 50);
+const bundleID = argv[3] ?? "com.apple.systemevents";
+const options: ToJSValueOptions = { decodeScalars: true };
+
+const littleEndian = endianness() === "LE";
+
+// Type, enumeration and ordinal descriptors hold a FourCharCode as a
+//  native-endian uint32.
+function code(type: string, value: string): { type: string, data: Uint8Array } {
+    const dataView = new DataView(new ArrayBuffer(4));
+    let packed = 0;
+    for (let index = 0; index < 4; index++) {
+        packed = packed * 256 + value.charCodeAt(index);
+    }
+    dataView.setUint32(0, packed, littleEndian);
+    return { type, data: new Uint8Array(dataView.buffer) };
+}
+
+function makeEvent(target: AETarget): AEEventDescriptor {
+    const everyProcess = AEDescriptor.fromJSValue({
+        want: code("type", "prcs"),
+        from: null,
+        form: code("enum", "indx"),
+        seld: code("abso", "all "),
+    }, { descriptorType: "obj " });
+    const properties = AEDescriptor.fromJSValue({
+        want: code("type", "prop"),
+        from: everyProcess,
+        form: code("enum", "prop"),
+        seld: code("type", "pALL"),
+    }, { descriptorType: "obj " });
+    return target.createEvent("core", "getd", { "----": properties });
+}
+
+async function measure(
+    name: string,
+    send: () => Promise<unknown>
+): Promise<void> {
+    // One untimed send, so both sides are measured warm.
+    await send();
+    const start = performance.now();
+    const startUtilization = performance.eventLoopUtilization();
+    for (let index = 0; index < sendCount; index++) {
+        await send();
+    }
+    const utilization = performance.eventLoopUtilization(startUtilization);
+    const elapsed = performance.now() - start;
+    console.log(
+        `${name}: ${(utilization.active / sendCount).toFixed(3)} ms ` +
+        `of event loop time per reply, ` +
+        `${(elapsed / sendCount).toFixed(3)} ms per send`
+    );
+}
+
+const target = new AETarget({ bundleID });
+if (!target.isAlive()) {
+    throw new Error(`${bundleID} isn't running`);
+}
+const event = makeEvent(target);
+
+console.log(`Sending ${sendCount} events to ${bundleID}.`);
+await measure("toJSValue", async () => {
+    const reply = await sendAppleEvent(event, true);
+    return Object.fromEntries(
+        Object.entries(reply.parameters)
+            .map(([keyword, parameter]) =>
+                [keyword, parameter.toJSValue(options)])
+    );
+});
+await measure("decodeReply", () =>
+    sendAppleEvent(event, true, { decodeReply: options })
+);
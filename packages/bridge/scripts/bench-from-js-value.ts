@@ -0,0 +1,89 @@
+import { endianness } from "node:os";
+import { argv } from "node:process";
+
+import {
+    AEDataDescriptor,
+    AEDescriptor,
+    AEListDescriptor,
+    AENullDescriptor,
+    AERecordDescriptor,
+} from "#ae_js_bridge_native";
+
+// Compares building a descriptor tree in one native pass, with
+//  `AEDescriptor.fromJSValue`, against building it a node at a time through
+//  the descriptor constructors, as `AEJSDescriptor.fromValue` used to.
+//
+// Usage: node ./scripts/bench-from-js-value.js [items] [rounds]
+
+const itemCount = Number(argv[2] ?? 10_000);
+const rounds = Number(argv[3] ?? 10);
+
+function makeValue(count: number): unknown[] {
+    const items: unknown[] = [];
+    for (let index = 0; index < count; index++) {
+        items.push({
+            name: `item ${index}`,
+            indx: index,
+            flag: index % 2 === 0,
+            kids: [index, `${index}`, null],
+            deep: { leaf: index / 2 },
+        });
+    }
+    return items;
+}
+
+const encoder = new TextEncoder();
+const littleEndian = endianness() === "LE";
+
+function buildPerNode(value: unknown): AEDescriptor {
+    if (value === null) {
+        return new AENullDescriptor();
+    }
+    if (typeof value === "string") {
+        return new AEDataDescriptor("utf8", encoder.encode(value));
+    }
+    if (typeof value === "number") {
+        const dataView = new DataView(new ArrayBuffer(8));
+        dataView.setFloat64(0, value, littleEndian);
+        return new AEDataDescriptor("doub", new Uint8Array(dataView.buffer));
+    }
+    if (typeof value === "boolean") {
+        return new AEDataDescriptor("bool", new Uint8Array([value ? 1 : 0]));
+    }
+    if (Array.isArray(value)) {
+        return new AEListDescriptor("list", value.map(buildPerNode));
+    }
+    return new AERecordDescriptor(
+        "reco",
+        Object.fromEntries(
+            Object.entries(value as object)
+                .map(([key, field]) => [key, buildPerNode(field)])
+        )
+    );
+}
+
+function measure(name: string, build: () => AEDescriptor): AEDescriptor {
+    // One untimed round, so both sides are measured warm.
+    let built = build();
+    const times: number[] = [];
+    for (let round = 0; round < rounds; round++) {
+        const start = performance.now();
+        built = build();
+        times.push(performance.now() - start);
+    }
+    times.sort((a, b) => a - b);
+    const median = times[Math.floor(times.length / 2)];
+    console.log(
+        `${name}: median ${median.toFixed(2)} ms, ` +
+        `min ${times[0].toFixed(2)} ms over ${rounds} rounds`
+    );
+    return built;
+}
+
+const value = makeValue(itemCount);
+console.log(`Building a list of ${itemCount} nested records.`);
+const perNode = measure("per node", () => buildPerNode(value));
+const singlePass = measure("fromJSValue", () => AEDescriptor.fromJSValue(value));
+if (!perNode.equals(singlePass)) {
+    throw new Error("The two builds produced different descriptors");
+}
@@ -0,0 +1,38 @@
+import { readFileSync, writeFileSync } from "node:fs";
+import { join } from "node:path";
+import { fileURLToPath } from "node:url";
+
+// Generates `src/ts/codes.ts` from the native X-macro list, so the numeric
+//  constants on both sides come from the same place.
+
+const scriptPath = fileURLToPath(import.meta.url);
+const projectRoot = join(scriptPath, "..", "..");
+const definitionsPath = join(
+  projectRoot, "src", "native", "StandardFourCharCodes.def"
+);
+const outputPath = join(projectRoot, "src", "ts", "codes.ts");
+
+const entryPattern = /^AEJS_FOUR_CHAR_CODE\((\w+), "(.{4})"\)$/;
+
+const lines: string[] = [];
+for (const line of readFileSync(definitionsPath, "latin1").split("\n")) {
+  const match = entryPattern.exec(line.trim());
+  if (!match) {
+    continue;
+  }
+  const [, name, text] = match;
+  const code = Buffer.from(text, "latin1").readUInt32BE(0);
+  lines.push(
+    `/** \`'${text}'\` */\n` +
+    `export const ${name} = 0x${code.toString(16).padStart(8, "0")};`
+  );
+}
+
+const output = `// Generated by scripts/generate-codes.ts from
+//  src/native/StandardFourCharCodes.def. Do not edit by hand.
+
+${lines.join("\n")}
+`;
+
+writeFileSync(outputPath, output);
+console.log(`Wrote ${lines.length} codes to ${outputPath}.`);
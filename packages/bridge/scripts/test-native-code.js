@@ -1,2 +1,73 @@
-export {};
-// TODO: test the native code
+import { strict as assert } from "node:assert";
+import { test } from "node:test";
+import { AEDataDescriptor, AEDescriptor, AEListDescriptor, AERecordDescriptor, } from "#ae_js_bridge_native";
+// These need the addon, which only builds on macOS.
+test("fromJSValue builds nested arrays and records", () => {
+    const list = AEDescriptor.fromJSValue([
+        1,
+        "two",
+        [3, { abcd: "four" }],
+        { efgh: [5, null], ijkl: { mnop: true } },
+    ]);
+    assert.ok(list instanceof AEListDescriptor);
+    assert.equal(list.count, 4);
+    assert.equal(list.itemAt(0).asFloat64(), 1);
+    assert.equal(list.itemAt(1).asUtf8String(), "two");
+    const inner = list.itemAt(2);
+    assert.ok(inner instanceof AEListDescriptor);
+    assert.equal(inner.count, 2);
+    const innerRecord = inner.itemAt(1);
+    assert.ok(innerRecord instanceof AERecordDescriptor);
+    assert.equal(innerRecord.getField("abcd").asUtf8String(), "four");
+    const record = list.itemAt(3);
+    assert.ok(record instanceof AERecordDescriptor);
+    assert.deepEqual(record.keys(), ["efgh", "ijkl"]);
+    assert.equal(record.getField("efgh").count, 2);
+    const nested = record.getField("ijkl");
+    assert.equal(nested.getField("mnop").asBool(), true);
+});
+test("fromJSValue builds a record at the root", () => {
+    const record = AEDescriptor.fromJSValue({
+        abcd: [1, 2, 3],
+        efgh: { ijkl: "deep" },
+    });
+    assert.ok(record instanceof AERecordDescriptor);
+    assert.equal(record.count, 2);
+    assert.equal(record.getField("abcd").count, 3);
+});
+test("fromJSValue embeds existing descriptors without converting them", () => {
+    const existing = AEDescriptor.fromJSValue({
+        abcd: "kept",
+    });
+    const list = AEDescriptor.fromJSValue([
+        existing,
+        [existing],
+    ]);
+    assert.ok(list.itemAt(0).equals(existing));
+    assert.ok(list.itemAt(1).itemAt(0).equals(existing));
+});
+test("dataView copies the data once and shares it between views", () => {
+    const data = new AEDataDescriptor("abcd", new Uint8Array([1, 2, 3]));
+    const first = data.dataView();
+    const second = data.dataView();
+    assert.equal(first.buffer, second.buffer);
+    assert.deepEqual([...new Uint8Array(first.buffer)], [1, 2, 3]);
+    assert.deepEqual([...data.data], [1, 2, 3]);
+});
+test("deserialize round-trips serialize and rejects damaged input", () => {
+    const record = AEDescriptor.fromJSValue({
+        abcd: [1, "two", { efgh: null }],
+    });
+    const bytes = record.serialize();
+    assert.ok(AEDescriptor.deserialize(bytes).equals(record));
+    for (let length = 0; length < bytes.length; length++) {
+        assert.throws(() => AEDescriptor.deserialize(bytes.subarray(0, length)));
+    }
+    assert.throws(() => AEDescriptor.deserialize(Buffer.concat([bytes, Buffer.from([0])])));
+    // AEFlattenDesc's form, whose item count here claims far more items than
+    //  there are bytes for.
+    assert.equal(bytes.subarray(0, 4).toString("latin1"), "dle2");
+    const damaged = Buffer.from(bytes);
+    damaged[28] = 0x7f;
+    assert.throws(() => AEDescriptor.deserialize(damaged));
+});
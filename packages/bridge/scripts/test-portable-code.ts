@@ -0,0 +1,27 @@
+import { spawnSync } from "node:child_process";
+import { join } from "node:path";
+import { exit } from "node:process";
+import { fileURLToPath } from "node:url";
+
+// Runs the test targets that build without Node or CoreServices (see
+//  `binding.gyp`), so these run on Linux as well as macOS.
+
+const scriptPath = fileURLToPath(import.meta.url);
+const buildDirectory = join(scriptPath, "..", "..", "build", "Release");
+
+const tests = [
+    "ae_js_descriptor_engine_test",
+    "ae_js_in_flight_table_test",
+    "ae_js_send_executor_load_test",
+];
+
+let failed = 0;
+for (const test of tests) {
+    console.log(`# ${test}`);
+    const result = spawnSync(join(buildDirectory, test), { stdio: "inherit" });
+    if (result.error || result.status !== 0) {
+        console.log(`# ${test} failed`);
+        failed++;
+    }
+}
+exit(failed === 0 ? 0 : 1);
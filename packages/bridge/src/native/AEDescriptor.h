@@ -1,23 +1,31 @@
 #pragma once
 
+#include "AEPlatform.h"
+#include "DescriptorHash.h"
+#include "DescriptorKind.h"
 #include "OSError.h"
+#include "ValueConversion.h"
 #include "helpers.h"
 
-#include <CoreServices/CoreServices.h>
 #include <napi.h>
 
+#include <array>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace ae_js_bridge {
 namespace Descriptors {
-#define AEJS_CPP_DESCRIPTOR_CLASS_COMMON(ClassName)                            \
+#define AEJS_CPP_DESCRIPTOR_CLASS_COMMON(ClassName, KindName)                  \
 public:                                                                        \
   static constexpr const char *JSClassName = #ClassName;                       \
+  static constexpr DescriptorKind WrappedKind = DescriptorKind::KindName;      \
   using AEDescriptorWrapper<ClassName>::AEDescriptorWrapper;                   \
   void InitFromJS(const Napi::CallbackInfo &info);                             \
-  static std::vector<Napi::ClassPropertyDescriptor<ClassName>> JSProperties();
+  static std::vector<Napi::ClassPropertyDescriptor<ClassName>> JSProperties(   \
+      Napi::Env env);
 
 template <typename Derived> class AEDescriptorWrapper;
 class AEDescriptor;
@@ -28,37 +36,188 @@ class AERecordDescriptor;
 class AEEventDescriptor;
 class AEUnknownDescriptor;
 Napi::Value CopyAndWrapAEDescOrThrow(Napi::Env env, const AEDesc *desc);
+Napi::Value WrapOwnedAEDescOrThrow(Napi::Env env, AEDesc *desc);
+Napi::Value WrapSharedAEDescOrThrow(Napi::Env env, const SharedAEDesc &desc);
+// For callers that have already classified `desc`.
+Napi::Value WrapSharedAEDescOrThrow(Napi::Env env, const SharedAEDesc &desc,
+                                    DescriptorKind kind);
+// Tags every descriptor wrapper, so `UnwrapDescriptor` can tell them apart
+// from the addon's other wrapped classes (such as `AETarget`).
+inline constexpr napi_type_tag kDescriptorTypeTag = {0x9b3c5f0e2a7d4c61ull,
+                                                     0xd84e17a3b6f2095cull};
+// The descriptor `value` wraps, or null if it isn't a descriptor wrapper.
+AEDescriptorWrapper<AEDescriptor> *UnwrapDescriptor(const Napi::Value &value);
+// Flattens `desc` straight into a new Buffer, for `serialize()`.
+Napi::Value SerializeAEDescOrThrow(Napi::Env env, const AEDesc *desc);
+// Reads a return ID passed from JS. Throws, rather than truncating, unless it
+// is an integer that fits an `AEReturnID` (-32768 to 32767).
+bool ReturnIDFromJSOrThrow(const Napi::Value &value,
+                           AEReturnID *outReturnID);
+// Reads a transaction ID passed from JS, the same way, as an `AETransactionID`
+// (-2147483648 to 2147483647).
+bool TransactionIDFromJSOrThrow(const Napi::Value &value,
+                                AETransactionID *outTransactionID);
+// Creates an event addressed to `target`, with the descriptors in
+// `parameters` and `attributes` (keyed by keyword) put into it. The event is
+// only handed back, for the caller to own, if all of that succeeds.
+bool CreateAppleEventOrThrow(Napi::Env env, AEEventClass eventClass,
+                             AEEventID eventID, const AEAddressDesc *target,
+                             AEReturnID returnID,
+                             AETransactionID transactionID,
+                             const Napi::Object &parameters,
+                             const Napi::Object &attributes,
+                             AEDesc **outEvent);
+
+// Remembers the JS wrappers handed out for a descriptor's children, so asking
+// for the same child twice doesn't copy it out of its parent again. The
+// references are weak: a child nobody holds on to is still collected, and is
+// simply re-read from the parent the next time it is asked for.
+template <typename Key> class ChildWrapperCache {
+public:
+  Napi::Value Get(const Key &key) const {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+      return Napi::Value();
+    }
+    return it->second.Value();
+  }
+
+  void Set(const Key &key, const Napi::Object &wrapper) {
+    entries[key] = Napi::Weak(wrapper);
+  }
+
+private:
+  std::unordered_map<Key, Napi::ObjectReference> entries;
+};
 
 template <typename Derived>
 class AEDescriptorWrapper : public Napi::ObjectWrap<Derived> {
 public:
   static Napi::FunctionReference constructor;
+  // Set by `InitFromJS`, and adopted into `shared` once it returns.
   AEDesc *desc = nullptr;
 
   explicit AEDescriptorWrapper(const Napi::CallbackInfo &info)
-      : Napi::ObjectWrap<Derived>(info) {
+      : Napi::ObjectWrap<Derived>(info), kind(Derived::WrappedKind) {
+    this->Value().TypeTag(&kDescriptorTypeTag);
     if (info.Length() == 1 && info[0].IsExternal()) {
-      desc = info[0].As<Napi::External<AEDesc>>().Data();
+      shared = *info[0].As<Napi::External<SharedAEDesc>>().Data();
+      desc = shared.get();
       return;
     }
 
     static_cast<Derived *>(this)->InitFromJS(info);
-    if (!desc && !info.Env().IsExceptionPending()) {
+    if (desc) {
+      shared = AdoptAEDesc(desc);
+    } else if (!info.Env().IsExceptionPending()) {
       Napi::Error::New(info.Env(), "Descriptor initialization failed")
           .ThrowAsJavaScriptException();
     }
   }
 
-public:
-  ~AEDescriptorWrapper() override {
-    if (desc) {
-      AEDisposeDesc(desc);
-      delete desc;
+private:
+  DescriptorKind kind;
+  // Owns `desc`, possibly together with other wrappers and in-flight sends.
+  SharedAEDesc shared;
+  // Descriptors never change once wrapped, so the hash is computed once.
+  bool hasHash = false;
+  uint64_t hash = 0;
+
+  bool HashOnceOrThrow(Napi::Env env) {
+    if (!hasHash) {
+      OSStatus err = DescriptorHash::HashDescriptor(desc, &hash);
+      if (err != noErr) {
+        OSError::Throw(env, err, "AEFlattenDesc failed");
+        return false;
+      }
+      hasHash = true;
+    }
+    return true;
+  }
+
+  // How many coercions a wrapper remembers. Code reads a descriptor as a
+  // handful of types at most, so a few entries catch the repeats while
+  // keeping each wrapper's footprint fixed.
+  static constexpr size_t kMaxCoercions = 4;
+  struct Coercion {
+    DescType type = typeNull;
+    SharedAEDesc desc;
+  };
+  // The last few successful coercions, replaced oldest first. Failures aren't
+  // kept: remembering them would let a stream of bad types crowd out the
+  // useful entries, and failing again costs about as much as the lookup.
+  std::array<Coercion, kMaxCoercions> coercions;
+  size_t nextCoercion = 0;
+
+  // `CoerceOnce` for the scalar readers, throwing its error. `outDesc` keeps
+  // the result alive even if the memo later replaces it.
+  bool CoercedOrThrow(Napi::Env env, DescType targetType,
+                      SharedAEDesc *outDesc) {
+    OSErr err = CoerceOnce(targetType, outDesc);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AECoerceDesc failed");
+      return false;
+    }
+    return true;
+  }
+
+  bool CheckScalarReadOrThrow(const Napi::CallbackInfo &info,
+                              const char *usage) {
+    if (info.Length() != 0) {
+      Napi::TypeError::New(info.Env(), usage).ThrowAsJavaScriptException();
+      return false;
+    }
+    if (!desc) {
+      Napi::Error::New(info.Env(), "Uninitialized descriptor")
+          .ThrowAsJavaScriptException();
+      return false;
     }
+    return true;
   }
 
+public:
   const AEDesc *GetRawDescriptor() const { return desc; }
 
+  // Lets the descriptor outlive the wrapper without copying it.
+  const SharedAEDesc &GetSharedDescriptor() const { return shared; }
+
+  // Coerces the descriptor to `targetType`, answering from the memo when the
+  // type was coerced to recently. Coercing to the descriptor's own type
+  // shares it instead.
+  OSErr CoerceOnce(DescType targetType, SharedAEDesc *outDesc) {
+    if (targetType == desc->descriptorType) {
+      *outDesc = shared;
+      return noErr;
+    }
+    for (const Coercion &coercion : coercions) {
+      if (coercion.desc && coercion.type == targetType) {
+        *outDesc = coercion.desc;
+        return noErr;
+      }
+    }
+    AEDesc *coerced = new AEDesc;
+    OSErr err = AECoerceDesc(desc, targetType, coerced);
+    if (err != noErr) {
+      delete coerced;
+      return err;
+    }
+    Coercion &slot = coercions[nextCoercion];
+    nextCoercion = (nextCoercion + 1) % kMaxCoercions;
+    slot.type = targetType;
+    slot.desc = AdoptAEDesc(coerced);
+    *outDesc = slot.desc;
+    return noErr;
+  }
+
+  // Reads the hash if `hash()` has already computed it, without computing it.
+  bool GetCachedHash(uint64_t *outHash) const {
+    *outHash = hash;
+    return hasHash;
+  }
+
+  // Fixed by the wrapper class, so it never has to be probed again.
+  DescriptorKind GetKind() const { return kind; }
+
   DescType GetRawDescriptorType() const {
     if (!desc) {
       throw std::runtime_error("Uninitialized AEDesc");
@@ -67,14 +226,13 @@ public:
   }
 
   Napi::Value GetDescriptorTypeOrThrow(const Napi::CallbackInfo &info) {
-    return Napi::String::New(info.Env(),
-                             FourCharCodeToString(GetRawDescriptorType()));
+    return FourCharCodeToJS(info.Env(), GetRawDescriptorType());
   }
 
   Napi::Value AsOrThrow(const Napi::CallbackInfo &info) {
     Napi::Env env = info.Env();
-    if (info.Length() != 1 || !info[0].IsString()) {
-      Napi::TypeError::New(env, "as(descriptorType) expects a string")
+    if (info.Length() != 1 || !IsFourCharCodeValue(info[0])) {
+      Napi::TypeError::New(env, "as(descriptorType) expects a FourCharCode")
           .ThrowAsJavaScriptException();
       return env.Null();
     }
@@ -85,27 +243,162 @@ public:
       return env.Null();
     }
 
-    FourCharCode targetType =
-        StringToFourCharCode(info[0].As<Napi::String>().Utf8Value());
+    FourCharCode targetType = JSValueToFourCharCode(info[0]);
     if (targetType == 0) {
       Napi::Error::New(env, "Invalid descriptor type")
           .ThrowAsJavaScriptException();
       return env.Null();
     }
 
-    AEDesc *coerced = new AEDesc;
-    OSErr err = AECoerceDesc(desc, targetType, coerced);
+    SharedAEDesc coerced;
+    OSErr err = CoerceOnce(targetType, &coerced);
     if (err != noErr) {
-      delete coerced;
       OSError::Throw(env, err, "AECoerceDesc failed");
       return env.Null();
     }
 
-    return WrapAEDesc(env, coerced);
+    // A coercion can change the kind (e.g. wrapping an item in a list), so
+    // the result gets the wrapper class for its own kind.
+    return WrapSharedAEDescOrThrow(env, coerced);
+  }
+
+  Napi::Value ToJSValueOrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() > 1) {
+      Napi::TypeError::New(env, "toJSValue takes (options?)")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    if (!desc) {
+      Napi::Error::New(env, "Uninitialized descriptor")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    ValueConversion::ToJSValueOptions options;
+    if (!ValueConversion::ReadToJSValueOptionsOrThrow(
+            env, info.Length() == 1 ? info[0] : env.Undefined(), &options)) {
+      return env.Null();
+    }
+    return ValueConversion::DescToJSValueOrThrow(env, desc, kind, options);
+  }
+
+  Napi::Value AsUtf8StringOrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    std::string value;
+    SharedAEDesc source;
+    if (!CheckScalarReadOrThrow(info, "asUtf8String takes no arguments") ||
+        !CoercedOrThrow(env, typeUTF8Text, &source) ||
+        !ValueConversion::ReadUtf8StringOrThrow(env, source.get(), &value)) {
+      return env.Null();
+    }
+    return Napi::String::New(env, value);
+  }
+
+  Napi::Value AsFloat64OrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    double value = 0;
+    SharedAEDesc source;
+    if (!CheckScalarReadOrThrow(info, "asFloat64 takes no arguments") ||
+        !CoercedOrThrow(env, typeIEEE64BitFloatingPoint, &source) ||
+        !ValueConversion::ReadScalarOrThrow(
+            env, source.get(), typeIEEE64BitFloatingPoint, &value)) {
+      return env.Null();
+    }
+    return Napi::Number::New(env, value);
+  }
+
+  Napi::Value AsInt32OrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    int32_t value = 0;
+    SharedAEDesc source;
+    if (!CheckScalarReadOrThrow(info, "asInt32 takes no arguments") ||
+        !CoercedOrThrow(env, typeSInt32, &source) ||
+        !ValueConversion::ReadScalarOrThrow(env, source.get(), typeSInt32,
+                                            &value)) {
+      return env.Null();
+    }
+    return Napi::Number::New(env, value);
+  }
+
+  Napi::Value AsInt64OrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    int64_t value = 0;
+    SharedAEDesc source;
+    if (!CheckScalarReadOrThrow(info, "asInt64 takes no arguments") ||
+        !CoercedOrThrow(env, typeSInt64, &source) ||
+        !ValueConversion::ReadScalarOrThrow(env, source.get(), typeSInt64,
+                                            &value)) {
+      return env.Null();
+    }
+    // Not every 64-bit integer fits in a double.
+    return Napi::BigInt::New(env, value);
   }
 
-  static Napi::Object WrapAEDesc(Napi::Env env, AEDesc *rawDesc) {
-    return constructor.New({Napi::External<AEDesc>::New(env, rawDesc)});
+  Napi::Value AsBoolOrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    uint8_t value = 0;
+    SharedAEDesc source;
+    if (!CheckScalarReadOrThrow(info, "asBool takes no arguments") ||
+        !CoercedOrThrow(env, typeBoolean, &source) ||
+        !ValueConversion::ReadScalarOrThrow(env, source.get(), typeBoolean,
+                                            &value)) {
+      return env.Null();
+    }
+    return Napi::Boolean::New(env, value != 0);
+  }
+
+  Napi::Value SerializeOrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!CheckScalarReadOrThrow(info, "serialize takes no arguments")) {
+      return env.Null();
+    }
+    return SerializeAEDescOrThrow(env, desc);
+  }
+
+  Napi::Value HashOrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (!CheckScalarReadOrThrow(info, "hash takes no arguments") ||
+        !HashOnceOrThrow(env)) {
+      return env.Null();
+    }
+    return Napi::BigInt::New(env, hash);
+  }
+
+  Napi::Value EqualsOrThrow(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    AEDescriptorWrapper<AEDescriptor> *other =
+        info.Length() == 1 ? UnwrapDescriptor(info[0]) : nullptr;
+    if (!other) {
+      Napi::TypeError::New(env, "equals takes (AEDescriptor)")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (!desc || !other->desc) {
+      Napi::Error::New(env, "Uninitialized descriptor")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    // Hashes that are already known settle most unequal pairs for free.
+    uint64_t otherHash = 0;
+    if (hasHash && other->GetCachedHash(&otherHash) && hash != otherHash) {
+      return Napi::Boolean::New(env, false);
+    }
+    bool equal = false;
+    OSStatus err = DescriptorHash::DescriptorsEqual(
+        desc, other->GetRawDescriptor(), &equal);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AEFlattenDesc failed");
+      return env.Null();
+    }
+    return Napi::Boolean::New(env, equal);
+  }
+
+  static Napi::Object WrapAEDesc(Napi::Env env, SharedAEDesc rawDesc) {
+    // The constructor copies the pointer out before `New` returns.
+    return constructor.New({Napi::External<SharedAEDesc>::New(env, &rawDesc)});
   }
 
   static void Init(Napi::Env env, Napi::Object exports) {
@@ -113,10 +406,19 @@ public:
         Derived::InstanceAccessor("descriptorType",
                                   &Derived::GetDescriptorTypeOrThrow, nullptr),
         Derived::InstanceMethod("as", &Derived::AsOrThrow),
+        Derived::InstanceMethod("toJSValue", &Derived::ToJSValueOrThrow),
+        Derived::InstanceMethod("asUtf8String", &Derived::AsUtf8StringOrThrow),
+        Derived::InstanceMethod("asFloat64", &Derived::AsFloat64OrThrow),
+        Derived::InstanceMethod("asInt32", &Derived::AsInt32OrThrow),
+        Derived::InstanceMethod("asInt64", &Derived::AsInt64OrThrow),
+        Derived::InstanceMethod("asBool", &Derived::AsBoolOrThrow),
+        Derived::InstanceMethod("serialize", &Derived::SerializeOrThrow),
+        Derived::InstanceMethod("hash", &Derived::HashOrThrow),
+        Derived::InstanceMethod("equals", &Derived::EqualsOrThrow),
     };
 
     std::vector<Napi::ClassPropertyDescriptor<Derived>> extraProperties =
-        Derived::JSProperties();
+        Derived::JSProperties(env);
     properties.insert(properties.end(), extraProperties.begin(),
                       extraProperties.end());
 
@@ -156,45 +458,111 @@ template <typename Derived>
 Napi::FunctionReference AEDescriptorWrapper<Derived>::constructor;
 
 class AEDescriptor : public AEDescriptorWrapper<AEDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEDescriptor, Unknown)
+  static Napi::Value FromJSValueOrThrow(const Napi::CallbackInfo &info);
+  static Napi::Value DeserializeOrThrow(const Napi::CallbackInfo &info);
+  static Napi::Value CoerceAllOrThrow(const Napi::CallbackInfo &info);
 };
 
 class AENullDescriptor : public AEDescriptorWrapper<AENullDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AENullDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AENullDescriptor, Null)
 };
 
 class AEDataDescriptor : public AEDescriptorWrapper<AEDataDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEDataDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEDataDescriptor, Data)
   Napi::Value GetDataOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value DataViewOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value DataRangeOrThrow(const Napi::CallbackInfo &info);
+
+private:
+  // The descriptor's bytes, copied into an external buffer on the first
+  // `dataView()` call and shared by every view after it. Read-only by
+  // contract: a write through one view would show through all the others.
+  Napi::Reference<Napi::ArrayBuffer> dataSnapshot;
 };
 
 class AEListDescriptor : public AEDescriptorWrapper<AEListDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEListDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEListDescriptor, List)
   Napi::Value GetItemsOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetCountOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value ItemAtOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value IteratorOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value IterateOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value ToFloat64ArrayOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value ToInt32ArrayOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value ToStringArrayOrThrow(const Napi::CallbackInfo &info);
+  static Napi::Value FromTypedArrayOrThrow(const Napi::CallbackInfo &info);
+
+  bool CountItemsOrThrow(Napi::Env env, long *outCount);
+  // `index` is zero-based.
+  Napi::Value ItemOrThrow(Napi::Env env, long index);
+
+private:
+  long itemCount = -1;
+  ChildWrapperCache<long> itemCache;
 };
 
 class AERecordDescriptor : public AEDescriptorWrapper<AERecordDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AERecordDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AERecordDescriptor, Record)
   Napi::Value GetFieldsOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetCountOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetFieldOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value HasFieldOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value KeysOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value IteratorOrThrow(const Napi::CallbackInfo &info);
+
+  bool CountItemsOrThrow(Napi::Env env, long *outCount);
+  // `index` is zero-based. Returns the field's keyword through `outKeyword`.
+  Napi::Value EntryOrThrow(Napi::Env env, long index, AEKeyword *outKeyword);
+  // Returns `undefined` if the record has no field for `keyword`.
+  Napi::Value FieldOrThrow(Napi::Env env, AEKeyword keyword);
+
+private:
+  // `index` is zero-based. Reads just the keyword, without copying the field.
+  bool KeywordAtOrThrow(Napi::Env env, long index, AEKeyword *outKeyword);
+  // Maps each keyword to the position of its first field. Built on first use
+  //  for records big enough that scanning them per lookup costs more, and by
+  //  `keys()`, which reads every keyword anyway. Returns null otherwise, or if
+  //  an exception is pending.
+  const std::unordered_map<AEKeyword, long> *KeyIndexOrThrow(Napi::Env env,
+                                                             bool force);
+
+  long itemCount = -1;
+  std::vector<AEKeyword> keywordsByIndex;
+  // Fields read by position, and fields looked up by keyword. Kept apart
+  //  because a record can repeat a keyword, and a lookup has to return the
+  //  first field with it whichever positions have been read.
+  ChildWrapperCache<long> entryCache;
+  ChildWrapperCache<AEKeyword> fieldCache;
+  bool hasKeyIndex = false;
+  std::unordered_map<AEKeyword, long> keyIndex;
 };
 
 class AEEventDescriptor : public AEDescriptorWrapper<AEEventDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEEventDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEEventDescriptor, Event)
   Napi::Value GetEventClassOrThrow(const Napi::CallbackInfo &info);
   Napi::Value GetEventIDOrThrow(const Napi::CallbackInfo &info);
   Napi::Value GetTargetOrThrow(const Napi::CallbackInfo &info);
   Napi::Value GetReturnIDOrThrow(const Napi::CallbackInfo &info);
   Napi::Value GetTransactionIDOrThrow(const Napi::CallbackInfo &info);
   Napi::Value GetParametersOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetParameterOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetParameterStringOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetParameterInt32OrThrow(const Napi::CallbackInfo &info);
   Napi::Value GetAttributeOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetAttributesOrThrow(const Napi::CallbackInfo &info);
+
+private:
+  // Returns `undefined` if the event has no attribute for `keyword`.
+  Napi::Value AttributeOrThrow(Napi::Env env, AEKeyword keyword);
+
+  ChildWrapperCache<AEKeyword> parameterCache;
 };
 
 class AEUnknownDescriptor : public AEDescriptorWrapper<AEUnknownDescriptor> {
-  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEUnknownDescriptor)
+  AEJS_CPP_DESCRIPTOR_CLASS_COMMON(AEUnknownDescriptor, Unknown)
 };
 
-AEDescriptorWrapper<AEDescriptor> *UnwrapDescriptor(const Napi::Value &value);
-
 #undef AEJS_CPP_DESCRIPTOR_CLASS_COMMON
 } // namespace Descriptors
 } // namespace ae_js_bridge
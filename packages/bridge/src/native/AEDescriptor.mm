@@ -1,7 +1,14 @@
 #include "AEDescriptor.h"
+#include "DescriptorEngine.h"
+#include "ListBatchIterator.h"
 #include <napi.h>
 
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
 
 namespace ae_js_bridge {
 namespace Descriptors {
@@ -9,7 +16,7 @@ namespace {
 
 #define AEJS_DEFINE_EMPTY_JS_PROPERTIES(ClassName)                             \
   std::vector<Napi::ClassPropertyDescriptor<ClassName>>                        \
-  ClassName::JSProperties() {                                                  \
+  ClassName::JSProperties(Napi::Env) {                                         \
     return {};                                                                 \
   }
 
@@ -68,27 +75,28 @@ Napi::Object ReadKeyedItemsOrThrow(Napi::Env env, const AEDesc *source,
   Napi::Object result = Napi::Object::New(env);
   for (long index = 1; index <= count; ++index) {
     AEKeyword keyword = 0;
-    AEDesc itemDesc;
+    AEDesc *itemDesc = new AEDesc;
     OSErr getErr =
-        AEGetNthDesc(source, index, typeWildCard, &keyword, &itemDesc);
+        AEGetNthDesc(source, index, typeWildCard, &keyword, itemDesc);
     if (getErr != noErr) {
+      delete itemDesc;
       OSError::Throw(env, getErr, itemError);
       return Napi::Object::New(env);
     }
 
-    Napi::Value wrappedItem = CopyAndWrapAEDescOrThrow(env, &itemDesc);
-    AEDisposeDesc(&itemDesc);
+    // `AEGetNthDesc` already handed us our own copy, so wrap it directly.
+    Napi::Value wrappedItem = WrapOwnedAEDescOrThrow(env, itemDesc);
     if (env.IsExceptionPending()) {
       return Napi::Object::New(env);
     }
-    result.Set(FourCharCodeToString(keyword), wrappedItem);
+    result.Set(FourCharCodeToJS(env, keyword), wrappedItem);
   }
 
   return result;
 }
 
-template <typename PutFn>
-bool InsertKeywordMap(Napi::Env env, AEDesc *target, const Napi::Object &map,
+template <typename Target, typename PutFn>
+bool InsertKeywordMap(Napi::Env env, Target target, const Napi::Object &map,
                       const char *invalidValueMessage, const char *putError,
                       PutFn putFn) {
   Napi::Array keys = map.GetPropertyNames();
@@ -99,8 +107,7 @@ bool InsertKeywordMap(Napi::Env env, AEDesc *target, const Napi::Object &map,
       continue;
     }
 
-    FourCharCode keyword =
-        StringToFourCharCode(keyValue.As<Napi::String>().Utf8Value());
+    FourCharCode keyword = PropertyNameToFourCharCode(keyValue);
     if (keyword == 0) {
       Napi::Error::New(env, "Invalid keyword").ThrowAsJavaScriptException();
       return false;
@@ -121,78 +128,466 @@ bool InsertKeywordMap(Napi::Env env, AEDesc *target, const Napi::Object &map,
   return true;
 }
 
-enum class DescriptorKind {
-  Null,
-  Data,
-  List,
-  Record,
-  Event,
-  Unknown,
-};
+bool CountItemsOnceOrThrow(Napi::Env env, const AEDesc *source,
+                           long *cachedCount) {
+  if (*cachedCount >= 0) {
+    return true;
+  }
+  if (!source) {
+    Napi::Error::New(env, "Uninitialized descriptor")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
 
-DescriptorKind GetDescriptorKind(const AEDesc *desc) {
-  if (!desc) {
-    return DescriptorKind::Unknown;
+  long count = 0;
+  OSErr err = AECountItems(source, &count);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AECountItems failed");
+    return false;
+  }
+  // Descriptors are never mutated after construction, so the count is fixed.
+  *cachedCount = count;
+  return true;
+}
+
+bool ReadIndexValue(const Napi::Value &value, long *outIndex) {
+  if (!value.IsNumber()) {
+    return false;
+  }
+  const double index = value.As<Napi::Number>().DoubleValue();
+  if (!(std::fabs(index) <= 9007199254740991.0) ||
+      index != static_cast<double>(static_cast<long>(index))) {
+    return false;
+  }
+  *outIndex = static_cast<long>(index);
+  return true;
+}
+
+bool ReadIndexArgumentOrThrow(const Napi::CallbackInfo &info,
+                              const char *usage, long *outIndex) {
+  if (info.Length() != 1 || !ReadIndexValue(info[0], outIndex)) {
+    Napi::TypeError::New(info.Env(), usage).ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+bool ReadKeywordArgumentOrThrow(const Napi::CallbackInfo &info,
+                                const char *usage, const char *invalidMessage,
+                                AEKeyword *outKeyword) {
+  if (info.Length() != 1 || !IsFourCharCodeValue(info[0])) {
+    Napi::TypeError::New(info.Env(), usage).ThrowAsJavaScriptException();
+    return false;
+  }
+  *outKeyword = JSValueToFourCharCode(info[0]);
+  if (*outKeyword == 0) {
+    Napi::Error::New(info.Env(), invalidMessage).ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+// Builds a JS iterator over positions `[0, count)` of `owner`, producing each
+// value with `produce(owner, env, index)`. The iterator keeps the owner's JS
+// object alive for as long as the iterator itself is reachable.
+template <typename Wrapper, typename Produce>
+Napi::Object MakeIndexIterator(Napi::Env env, Wrapper *owner, long count,
+                               Produce produce) {
+  struct State {
+    Napi::ObjectReference owner;
+    long next = 0;
+    long count = 0;
+  };
+  auto state = std::make_shared<State>();
+  state->owner = Napi::Persistent(owner->Value());
+  state->count = count;
+
+  Napi::Object iterator = Napi::Object::New(env);
+  iterator.Set(
+      "next",
+      Napi::Function::New(
+          env,
+          [state, produce](const Napi::CallbackInfo &info) -> Napi::Value {
+            Napi::Env env = info.Env();
+            Napi::Object result = Napi::Object::New(env);
+            if (state->next >= state->count) {
+              result.Set("done", Napi::Boolean::New(env, true));
+              result.Set("value", env.Undefined());
+              return result;
+            }
+
+            Wrapper *wrapper =
+                Napi::ObjectWrap<Wrapper>::Unwrap(state->owner.Value());
+            Napi::Value value = produce(wrapper, env, state->next++);
+            if (env.IsExceptionPending()) {
+              return env.Undefined();
+            }
+            result.Set("done", Napi::Boolean::New(env, false));
+            result.Set("value", value);
+            return result;
+          },
+          "next"));
+  iterator.Set(Napi::Symbol::WellKnown(env, "iterator"),
+               Napi::Function::New(
+                   env, [](const Napi::CallbackInfo &info) -> Napi::Value {
+                     return info.This();
+                   }));
+  return iterator;
+}
+
+// Records with fewer fields than this are scanned by `AEGetKeyDesc` instead
+//  of being indexed, since a short scan is cheaper than building the index.
+constexpr long kKeyIndexThreshold = 16;
+
+template <typename Source, typename T>
+bool LoadNumber(const void *raw, Size size, T *out) {
+  if (size != static_cast<Size>(sizeof(Source))) {
+    return false;
   }
-  switch (desc->descriptorType) {
-  case typeNull:
-    return DescriptorKind::Null;
-  case typeAppleEvent:
-    return DescriptorKind::Event;
+  Source value;
+  std::memcpy(&value, raw, sizeof(Source));
+  *out = static_cast<T>(value);
+  return true;
+}
+
+// Converts an item of one of the common numeric types to `T`, when that loses
+//  nothing. Descriptor data is host-endian, so there is nothing to swap.
+template <typename T>
+bool LoadNumericItem(DescType type, const void *raw, Size size, T *out) {
+  switch (type) {
+  case typeSInt16:
+    return LoadNumber<int16_t>(raw, size, out);
+  case typeSInt32:
+    return LoadNumber<int32_t>(raw, size, out);
+  case typeIEEE32BitFloatingPoint:
+    if constexpr (std::is_floating_point_v<T>) {
+      return LoadNumber<float>(raw, size, out);
+    }
+    return false;
+  case typeIEEE64BitFloatingPoint:
+    if constexpr (std::is_floating_point_v<T>) {
+      return LoadNumber<double>(raw, size, out);
+    }
+    return false;
   default:
-    long itemCount = 0;
-    OSErr err = AECountItems(desc, &itemCount);
-    if (err == errAEWrongDataType) {
-      return DescriptorKind::Data;
-    } else if (err != noErr) {
-      return DescriptorKind::Unknown;
+    return false;
+  }
+}
+
+// Reads every item of `list` as a `T` straight into `out`. Items of the
+//  common numeric types are loaded as they are; anything else goes through
+//  the AE Manager's coercion to `targetType`, which fails for items that
+//  can't be represented.
+template <typename T>
+bool ReadNumericItemsOrThrow(Napi::Env env, const AEDesc *list, long count,
+                             DescType targetType, T *out) {
+  for (long index = 0; index < count; ++index) {
+    alignas(8) uint8_t raw[8];
+    DescType type = typeNull;
+    Size size = 0;
+    OSErr err = AEGetNthPtr(list, index + 1, typeWildCard, nullptr, &type, raw,
+                            sizeof(raw), &size);
+    if (err == noErr && LoadNumericItem(type, raw, size, &out[index])) {
+      continue;
+    }
+    err = AEGetNthPtr(list, index + 1, targetType, nullptr, nullptr,
+                      &out[index], sizeof(T), nullptr);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AEGetNthPtr failed");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether every `Source` value is exactly representable as an `Item`.
+template <typename Source, typename Item> constexpr bool IsLossless() {
+  if constexpr (std::is_floating_point_v<Source>) {
+    return std::is_floating_point_v<Item> && sizeof(Source) <= sizeof(Item);
+  } else {
+    return std::numeric_limits<Source>::digits <=
+               std::numeric_limits<Item>::digits &&
+           (std::is_signed_v<Item> || !std::is_signed_v<Source>);
+  }
+}
+
+// Builds a list of `Item`s of `itemType` from `length` `Source`s. Arrays that
+//  already hold `Item`s are streamed as they are; others are widened first in
+//  one tight loop, which the compiler vectorizes.
+template <typename Item, typename Source>
+bool BuildNumericListOrThrow(Napi::Env env, DescType itemType,
+                             const Source *values, size_t length,
+                             AEDesc *outDesc) {
+  if constexpr (!IsLossless<Source, Item>()) {
+    Napi::TypeError::New(env, "The array's values can't all be stored as "
+                              "this type")
+        .ThrowAsJavaScriptException();
+    return false;
+  } else {
+    std::vector<Item> widened;
+    const Item *items = nullptr;
+    if constexpr (std::is_same_v<Source, Item>) {
+      items = values;
+    } else {
+      widened.resize(length);
+      for (size_t index = 0; index < length; ++index) {
+        widened[index] = static_cast<Item>(values[index]);
+      }
+      items = widened.data();
+    }
+
+    ScopedAEStream stream;
+    if (!stream.Get()) {
+      OSError::Throw(env, memFullErr, "AEStreamOpen failed");
+      return false;
+    }
+    OSStatus err = AEStreamOpenList(stream.Get());
+    for (size_t index = 0; index < length && err == noErr; ++index) {
+      err = AEStreamWriteDesc(stream.Get(), itemType, &items[index],
+                              sizeof(Item));
+    }
+    if (err == noErr) {
+      err = AEStreamCloseList(stream.Get());
+    }
+    if (err != noErr) {
+      OSError::Throw(env, err, "AEStreamWriteDesc failed");
+      return false;
+    }
+    err = stream.Close(outDesc);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AEStreamClose failed");
+      return false;
     }
-    return AECheckIsRecord(desc) ? DescriptorKind::Record
-                                 : DescriptorKind::List;
+    return true;
+  }
+}
+
+template <typename Item>
+bool BuildNumericListOrThrow(Napi::Env env, DescType itemType,
+                             const Napi::TypedArray &array, AEDesc *outDesc) {
+  const void *data =
+      static_cast<const uint8_t *>(array.ArrayBuffer().Data()) +
+      array.ByteOffset();
+  const size_t length = array.ElementLength();
+  switch (array.TypedArrayType()) {
+  case napi_int8_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const int8_t *>(data), length, outDesc);
+  case napi_uint8_array:
+  case napi_uint8_clamped_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const uint8_t *>(data), length, outDesc);
+  case napi_int16_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const int16_t *>(data), length, outDesc);
+  case napi_uint16_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const uint16_t *>(data), length, outDesc);
+  case napi_int32_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const int32_t *>(data), length, outDesc);
+  case napi_uint32_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const uint32_t *>(data), length, outDesc);
+  case napi_bigint64_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const int64_t *>(data), length, outDesc);
+  case napi_biguint64_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const uint64_t *>(data), length, outDesc);
+  case napi_float32_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const float *>(data), length, outDesc);
+  case napi_float64_array:
+    return BuildNumericListOrThrow<Item>(
+        env, itemType, static_cast<const double *>(data), length, outDesc);
+  default:
+    Napi::TypeError::New(env, "Unsupported typed array type")
+        .ThrowAsJavaScriptException();
+    return false;
   }
 }
 
+// Checks `deserialize()`'s input is exactly one flattened descriptor before
+//  it is unflattened. Neither unflattener is told how long its input is, so
+//  nothing else stops it reading past the end.
+bool CheckFlattenedOrThrow(Napi::Env env, const Napi::Uint8Array &bytes) {
+  const size_t length = bytes.ByteLength();
+  if (length < DescriptorEngine::FlattenedHeaderSize) {
+    Napi::Error::New(env, "Serialized descriptor is truncated")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  size_t declaredSize = 0;
+  if (DescriptorEngine::FlattenedSizeFromHeader(bytes.Data(), &declaredSize) !=
+      noErr) {
+    OSError::Throw(env, errAECorruptData, "AEUnflattenDesc failed");
+    return false;
+  }
+  if (declaredSize != length) {
+    Napi::Error::New(env, declaredSize > length
+                              ? "Serialized descriptor is truncated"
+                              : "Serialized descriptor has trailing bytes")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+#if !defined(AEJS_USE_PORTABLE_ENGINE)
+  // The portable engine's `AEUnflattenDesc` checks as it goes; CoreServices'
+  //  trusts every size inside, so they are all checked here first.
+  if (DescriptorEngine::CheckFlattened(bytes.Data(), length) != noErr) {
+    OSError::Throw(env, errAECorruptData, "AEUnflattenDesc failed");
+    return false;
+  }
+#endif
+  return true;
+}
 } // namespace
 
+Napi::Value SerializeAEDescOrThrow(Napi::Env env, const AEDesc *desc) {
+  // Flattened straight into the Buffer's memory, which is left
+  // uninitialized since every byte gets written.
+  const Size size = AESizeOfFlattenedDesc(desc);
+  Napi::Buffer<uint8_t> buffer =
+      Napi::Buffer<uint8_t>::New(env, static_cast<size_t>(size));
+  Size written = 0;
+  OSStatus err = AEFlattenDesc(desc, reinterpret_cast<char *>(buffer.Data()),
+                               size, &written);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEFlattenDesc failed");
+    return env.Null();
+  }
+  return buffer;
+}
+
 AEDescriptorWrapper<AEDescriptor> *UnwrapDescriptor(const Napi::Value &value) {
   if (!value.IsObject()) {
     return nullptr;
   }
 
-  auto *wrapper =
-      Napi::ObjectWrap<AEDescriptor>::Unwrap(value.As<Napi::Object>());
-  if (!wrapper) {
+  // `AETarget` is an ObjectWrap too, so anything wrapped that doesn't carry
+  //  the descriptor tag must be turned away before it is cast.
+  bool isDescriptor = false;
+  if (napi_check_object_type_tag(value.Env(), value, &kDescriptorTypeTag,
+                                 &isDescriptor) != napi_ok ||
+      !isDescriptor) {
+    return nullptr;
+  }
+
+  // Not `ObjectWrap::Unwrap`, which throws for objects that don't wrap
+  //  anything. Callers probe plain arrays and objects with this.
+  void *wrapper = nullptr;
+  if (napi_unwrap(value.Env(), value, &wrapper) != napi_ok || !wrapper) {
     return nullptr;
   }
 
-  return wrapper;
+  return static_cast<AEDescriptor *>(wrapper);
+}
+
+bool ReturnIDFromJSOrThrow(const Napi::Value &value,
+                           AEReturnID *outReturnID) {
+  const double number = value.As<Napi::Number>().DoubleValue();
+  if (!(number >= std::numeric_limits<AEReturnID>::min() &&
+        number <= std::numeric_limits<AEReturnID>::max()) ||
+      number != std::trunc(number)) {
+    Napi::RangeError::New(value.Env(),
+                          "returnID must be an integer from -32768 to 32767")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  *outReturnID = static_cast<AEReturnID>(number);
+  return true;
+}
+
+bool TransactionIDFromJSOrThrow(const Napi::Value &value,
+                                AETransactionID *outTransactionID) {
+  const double number = value.As<Napi::Number>().DoubleValue();
+  if (!(number >= std::numeric_limits<AETransactionID>::min() &&
+        number <= std::numeric_limits<AETransactionID>::max()) ||
+      number != std::trunc(number)) {
+    Napi::RangeError::New(
+        value.Env(),
+        "transactionID must be an integer from -2147483648 to 2147483647")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  *outTransactionID = static_cast<AETransactionID>(number);
+  return true;
+}
+
+bool CreateAppleEventOrThrow(Napi::Env env, AEEventClass eventClass,
+                             AEEventID eventID, const AEAddressDesc *target,
+                             AEReturnID returnID,
+                             AETransactionID transactionID,
+                             const Napi::Object &parameters,
+                             const Napi::Object &attributes,
+                             AEDesc **outEvent) {
+  auto *event = new AEDesc;
+  OSErr err = AECreateAppleEvent(eventClass, eventID, target, returnID,
+                                 transactionID, event);
+  if (err != noErr) {
+    delete event;
+    OSError::Throw(env, err, "AECreateAppleEvent failed");
+    return false;
+  }
+
+  if (!InsertKeywordMap(
+          env, event, parameters, "Parameter values must be AEDescriptor",
+          "AEPutParamDesc failed",
+          [](AEDesc *target, AEKeyword keyword, const AEDesc *value) {
+            return AEPutParamDesc(target, keyword, value);
+          }) ||
+      !InsertKeywordMap(
+          env, event, attributes, "Attribute values must be AEDescriptor",
+          "AEPutAttributeDesc failed",
+          [](AEDesc *target, AEKeyword keyword, const AEDesc *value) {
+            return AEPutAttributeDesc(target, keyword, value);
+          })) {
+    AEDisposeDesc(event);
+    delete event;
+    return false;
+  }
+  *outEvent = event;
+  return true;
 }
 
 Napi::Value CopyAndWrapAEDescOrThrow(Napi::Env env, const AEDesc *desc) {
   AEDesc *copyDesc = new AEDesc;
-  OSErr err = AEDuplicateDesc(desc, copyDesc);
+  OSErr err = DuplicateAEDesc(desc, copyDesc);
   if (err != noErr) {
     delete copyDesc;
     OSError::Throw(env, err, "AEDuplicateDesc failed");
     return env.Undefined();
   }
-  DescriptorKind kind = GetDescriptorKind(copyDesc);
+  return WrapOwnedAEDescOrThrow(env, copyDesc);
+}
+
+Napi::Value WrapOwnedAEDescOrThrow(Napi::Env env, AEDesc *desc) {
+  return WrapSharedAEDescOrThrow(env, AdoptAEDesc(desc));
+}
+
+Napi::Value WrapSharedAEDescOrThrow(Napi::Env env, const SharedAEDesc &desc) {
+  return WrapSharedAEDescOrThrow(env, desc, GetDescriptorKind(desc.get()));
+}
+
+Napi::Value WrapSharedAEDescOrThrow(Napi::Env env, const SharedAEDesc &desc,
+                                    DescriptorKind kind) {
   switch (kind) {
   case DescriptorKind::Null:
-    return AENullDescriptor::WrapAEDesc(env, copyDesc);
+    return AENullDescriptor::WrapAEDesc(env, desc);
   case DescriptorKind::Data:
-    return AEDataDescriptor::WrapAEDesc(env, copyDesc);
+    return AEDataDescriptor::WrapAEDesc(env, desc);
   case DescriptorKind::List:
-    return AEListDescriptor::WrapAEDesc(env, copyDesc);
+    return AEListDescriptor::WrapAEDesc(env, desc);
   case DescriptorKind::Record:
-    return AERecordDescriptor::WrapAEDesc(env, copyDesc);
+    return AERecordDescriptor::WrapAEDesc(env, desc);
   case DescriptorKind::Event:
-    return AEEventDescriptor::WrapAEDesc(env, copyDesc);
+    return AEEventDescriptor::WrapAEDesc(env, desc);
   case DescriptorKind::Unknown:
-    return AEUnknownDescriptor::WrapAEDesc(env, copyDesc);
+    return AEUnknownDescriptor::WrapAEDesc(env, desc);
   }
 
-  return AEUnknownDescriptor::WrapAEDesc(env, copyDesc);
+  return AEUnknownDescriptor::WrapAEDesc(env, desc);
 }
 
 void AEDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
@@ -201,7 +596,109 @@ void AEDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
       .ThrowAsJavaScriptException();
 }
 
-AEJS_DEFINE_EMPTY_JS_PROPERTIES(AEDescriptor)
+Napi::Value AEDescriptor::FromJSValueOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 1 || info.Length() > 2) {
+    Napi::TypeError::New(env, "fromJSValue takes (value, hints?)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  ValueConversion::FromJSValueHints hints;
+  if (!ValueConversion::ReadFromJSValueHintsOrThrow(
+          env, info.Length() == 2 ? info[1] : env.Undefined(), &hints)) {
+    return env.Null();
+  }
+
+  // Held until it's wrapped, since reading the value can run JS that throws.
+  std::unique_ptr<AEDesc> built(new AEDesc);
+  if (!ValueConversion::JSValueToDescOrThrow(env, info[0], hints,
+                                             built.get())) {
+    return env.Null();
+  }
+  return WrapOwnedAEDescOrThrow(env, built.release());
+}
+
+Napi::Value AEDescriptor::DeserializeOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+    Napi::TypeError::New(env, "deserialize takes (Uint8Array)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Uint8Array bytes = info[0].As<Napi::Uint8Array>();
+  if (!CheckFlattenedOrThrow(env, bytes)) {
+    return env.Null();
+  }
+
+  // Unflattened straight out of the caller's memory.
+  AEDesc *unflattened = new AEDesc;
+  OSStatus err = AEUnflattenDesc(bytes.Data(), unflattened);
+  if (err != noErr) {
+    delete unflattened;
+    OSError::Throw(env, err, "AEUnflattenDesc failed");
+    return env.Null();
+  }
+  return WrapOwnedAEDescOrThrow(env, unflattened);
+}
+
+Napi::Value AEDescriptor::CoerceAllOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 2 || !info[0].IsArray() ||
+      !IsFourCharCodeValue(info[1])) {
+    Napi::TypeError::New(
+        env, "coerceAll takes (AEDescriptor[], descriptorType: FourCharCode)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  FourCharCode targetType = JSValueToFourCharCode(info[1]);
+  if (targetType == 0) {
+    Napi::Error::New(env, "Invalid descriptor type")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Array descriptors = info[0].As<Napi::Array>();
+  const uint32_t length = descriptors.Length();
+  Napi::Array results = Napi::Array::New(env, length);
+  Napi::Int32Array errors = Napi::Int32Array::New(env, length);
+  for (uint32_t index = 0; index < length; ++index) {
+    auto *wrapper = UnwrapDescriptor(descriptors[index]);
+    if (!wrapper || !wrapper->GetRawDescriptor()) {
+      Napi::TypeError::New(env, "coerceAll items must be AEDescriptors")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    // Goes through each wrapper's memo, so repeating a batch is cheap.
+    SharedAEDesc coerced;
+    OSErr err = wrapper->CoerceOnce(targetType, &coerced);
+    errors.Data()[index] = err;
+    if (err != noErr) {
+      results.Set(index, env.Null());
+      continue;
+    }
+    Napi::Value wrapped = WrapSharedAEDescOrThrow(env, coerced);
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
+    results.Set(index, wrapped);
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("results", results);
+  result.Set("errors", errors);
+  return result;
+}
+
+std::vector<Napi::ClassPropertyDescriptor<AEDescriptor>>
+AEDescriptor::JSProperties(Napi::Env) {
+  return {
+      StaticMethod("fromJSValue", &AEDescriptor::FromJSValueOrThrow),
+      StaticMethod("deserialize", &AEDescriptor::DeserializeOrThrow),
+      StaticMethod("coerceAll", &AEDescriptor::CoerceAllOrThrow),
+  };
+}
 
 void AENullDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
@@ -224,200 +721,835 @@ AEJS_DEFINE_EMPTY_JS_PROPERTIES(AENullDescriptor)
 
 void AEDataDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
-  if (info.Length() != 2 || !info[0].IsString() || !info[1].IsTypedArray()) {
+  if (info.Length() != 2 || !IsFourCharCodeValue(info[0]) ||
+      !info[1].IsTypedArray()) {
     Napi::TypeError::New(env, "AEDataDescriptor takes (type, Uint8Array)")
         .ThrowAsJavaScriptException();
     return;
   }
 
-  FourCharCode type =
-      StringToFourCharCode(info[0].As<Napi::String>().Utf8Value());
+  FourCharCode type = JSValueToFourCharCode(info[0]);
   if (type == 0) {
     Napi::Error::New(env, "Invalid descriptor type")
         .ThrowAsJavaScriptException();
     return;
   }
-  Napi::Uint8Array array = info[1].As<Napi::Uint8Array>();
+  Napi::Uint8Array array = info[1].As<Napi::Uint8Array>();
+
+  desc = new AEDesc;
+  OSErr err = AECreateDesc(type, array.Data(), array.ByteLength(), desc);
+  if (err != noErr) {
+    delete desc;
+    desc = nullptr;
+    OSError::Throw(env, err, "AECreateDesc failed");
+    return;
+  }
+  NoteDescriptorKind(type, DescriptorKind::Data);
+}
+
+Napi::Value AEDataDescriptor::GetDataOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  const Size size = AEGetDescDataSize(desc);
+  if (size < 0) {
+    Napi::Error::New(env, "AEGetDescDataSize failed")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<uint8_t> buffer =
+      Napi::Buffer<uint8_t>::New(env, static_cast<size_t>(size));
+  OSErr err = AEGetDescData(desc, buffer.Data(), size);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEGetDescData failed");
+    return env.Null();
+  }
+
+  return buffer;
+}
+
+Napi::Value AEDataDescriptor::DataViewOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 0) {
+    Napi::TypeError::New(env, "dataView takes no arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (dataSnapshot.IsEmpty()) {
+    const Size size = AEGetDescDataSize(desc);
+    if (size < 0) {
+      Napi::Error::New(env, "AEGetDescDataSize failed")
+          .ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    // CoreServices has no public way to borrow the descriptor's storage, so
+    // copy it out once, into memory the buffer owns and frees when it is
+    // collected. The wrapper holds on to the buffer, so every later view is
+    // free; data descriptors never change, so one copy serves them all.
+    Napi::ArrayBuffer buffer;
+    if (size == 0) {
+      buffer = Napi::ArrayBuffer::New(env, 0);
+    } else {
+      auto bytes = std::make_unique<uint8_t[]>(static_cast<size_t>(size));
+      OSErr err = AEGetDescData(desc, bytes.get(), size);
+      if (err != noErr) {
+        OSError::Throw(env, err, "AEGetDescData failed");
+        return env.Null();
+      }
+      buffer = Napi::ArrayBuffer::New(
+          env, bytes.get(), static_cast<size_t>(size),
+          [](Napi::Env, void *data) { delete[] static_cast<uint8_t *>(data); });
+      bytes.release();
+    }
+    dataSnapshot = Napi::Persistent(buffer);
+  }
+
+  return Napi::DataView::New(env, dataSnapshot.Value());
+}
+
+Napi::Value
+AEDataDescriptor::DataRangeOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long offset = 0;
+  long length = 0;
+  if (info.Length() != 2 ||
+      !ReadIndexValue(info[0], &offset) || !ReadIndexValue(info[1], &length)) {
+    Napi::TypeError::New(env,
+                         "dataRange takes (offset: integer, length: integer)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  const Size size = AEGetDescDataSize(desc);
+  if (offset < 0 || length < 0 || offset > size || length > size - offset) {
+    Napi::RangeError::New(env, "Data range is out of bounds")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<uint8_t> buffer =
+      Napi::Buffer<uint8_t>::New(env, static_cast<size_t>(length));
+  if (length > 0) {
+    OSErr err = AEGetDescDataRange(desc, buffer.Data(), offset, length);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AEGetDescDataRange failed");
+      return env.Null();
+    }
+  }
+  return buffer;
+}
+
+std::vector<Napi::ClassPropertyDescriptor<AEDataDescriptor>>
+AEDataDescriptor::JSProperties(Napi::Env) {
+  return {
+      InstanceAccessor("data", &AEDataDescriptor::GetDataOrThrow, nullptr),
+      InstanceMethod("dataView", &AEDataDescriptor::DataViewOrThrow),
+      InstanceMethod("dataRange", &AEDataDescriptor::DataRangeOrThrow),
+  };
+}
+
+void AEListDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 2 || !IsFourCharCodeValue(info[0]) ||
+      !info[1].IsArray()) {
+    Napi::TypeError::New(env, "AEListDescriptor takes (type, AEDescriptor[])")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  FourCharCode type = JSValueToFourCharCode(info[0]);
+  if (type == 0) {
+    Napi::Error::New(env, "Invalid descriptor type")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  Napi::Array items = info[1].As<Napi::Array>();
+
+  ScopedAEStream stream;
+  if (!stream.Get()) {
+    OSError::Throw(env, memFullErr, "AEStreamOpen failed");
+    return;
+  }
+  OSStatus err = AEStreamOpenList(stream.Get());
+  const uint32_t length = items.Length();
+  for (uint32_t i = 0; i < length && err == noErr; ++i) {
+    auto *wrapper = UnwrapDescriptor(items[i]);
+    if (!wrapper) {
+      Napi::Error::New(env, "Invalid AEDescriptor item")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+    err = AEStreamWriteAEDesc(stream.Get(), wrapper->GetRawDescriptor());
+  }
+  if (err == noErr) {
+    err = AEStreamCloseList(stream.Get());
+  }
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEStreamWriteAEDesc failed");
+    return;
+  }
+
+  desc = new AEDesc;
+  err = stream.Close(desc);
+  if (err != noErr) {
+    delete desc;
+    desc = nullptr;
+    OSError::Throw(env, err, "AEStreamClose failed");
+    return;
+  }
+  desc->descriptorType = type;
+  NoteDescriptorKind(type, DescriptorKind::List);
+}
+
+bool AEListDescriptor::CountItemsOrThrow(Napi::Env env, long *outCount) {
+  if (!CountItemsOnceOrThrow(env, desc, &itemCount)) {
+    return false;
+  }
+  *outCount = itemCount;
+  return true;
+}
+
+Napi::Value AEListDescriptor::ItemOrThrow(Napi::Env env, long index) {
+  Napi::Value cached = itemCache.Get(index);
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+
+  AEDesc *itemDesc = new AEDesc;
+  OSErr err = AEGetNthDesc(desc, index + 1, typeWildCard, nullptr, itemDesc);
+  if (err != noErr) {
+    delete itemDesc;
+    OSError::Throw(env, err, "AEGetNthDesc failed");
+    return env.Null();
+  }
+
+  // `AEGetNthDesc` already handed us our own copy, so wrap it directly.
+  Napi::Value wrappedItem = WrapOwnedAEDescOrThrow(env, itemDesc);
+  if (wrappedItem.IsObject()) {
+    itemCache.Set(index, wrappedItem.As<Napi::Object>());
+  }
+  return wrappedItem;
+}
+
+Napi::Value AEListDescriptor::GetItemsOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+
+  Napi::Array result = Napi::Array::New(env, static_cast<uint32_t>(count));
+  for (long index = 0; index < count; ++index) {
+    Napi::Value wrappedItem = ItemOrThrow(env, index);
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
+    result.Set(static_cast<uint32_t>(index), wrappedItem);
+  }
+
+  return result;
+}
+
+Napi::Value AEListDescriptor::GetCountOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  return Napi::Number::New(env, static_cast<double>(count));
+}
+
+Napi::Value AEListDescriptor::ItemAtOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long index = 0;
+  if (!ReadIndexArgumentOrThrow(info, "itemAt takes (index: integer)",
+                                &index)) {
+    return env.Undefined();
+  }
+
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Undefined();
+  }
+  if (index < 0 || index >= count) {
+    return env.Undefined();
+  }
+  return ItemOrThrow(env, index);
+}
+
+Napi::Value AEListDescriptor::IteratorOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  return MakeIndexIterator(
+      env, this, count,
+      [](AEListDescriptor *list, Napi::Env env, long index) {
+        return list->ItemOrThrow(env, index);
+      });
+}
+
+Napi::Value
+AEListDescriptor::ToFloat64ArrayOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 0) {
+    Napi::TypeError::New(env, "toFloat64Array takes no arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  Napi::Float64Array result =
+      Napi::Float64Array::New(env, static_cast<size_t>(count));
+  if (!ReadNumericItemsOrThrow(env, desc, count, typeIEEE64BitFloatingPoint,
+                               result.Data())) {
+    return env.Null();
+  }
+  return result;
+}
+
+Napi::Value
+AEListDescriptor::ToInt32ArrayOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 0) {
+    Napi::TypeError::New(env, "toInt32Array takes no arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  Napi::Int32Array result =
+      Napi::Int32Array::New(env, static_cast<size_t>(count));
+  if (!ReadNumericItemsOrThrow(env, desc, count, typeSInt32, result.Data())) {
+    return env.Null();
+  }
+  return result;
+}
+
+Napi::Value
+AEListDescriptor::ToStringArrayOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 0) {
+    Napi::TypeError::New(env, "toStringArray takes no arguments")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+
+  // Reused for every item, so reading a string doesn't allocate.
+  std::string utf8;
+  std::u16string utf16;
+  Napi::Array result = Napi::Array::New(env, static_cast<size_t>(count));
+  for (long index = 1; index <= count; ++index) {
+    DescType type = typeNull;
+    Size size = 0;
+    OSErr err = AESizeOfNthItem(desc, index, &type, &size);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AESizeOfNthItem failed");
+      return env.Null();
+    }
+
+    if (type == typeUnicodeText) {
+      utf16.resize(static_cast<size_t>(size) / sizeof(char16_t));
+      if (!utf16.empty()) {
+        err = AEGetNthPtr(desc, index, typeUnicodeText, nullptr, nullptr,
+                          utf16.data(), utf16.size() * sizeof(char16_t),
+                          nullptr);
+      }
+    } else if (type == typeUTF8Text) {
+      utf8.resize(static_cast<size_t>(size));
+      if (!utf8.empty()) {
+        err = AEGetNthPtr(desc, index, typeUTF8Text, nullptr, nullptr,
+                          utf8.data(), size, nullptr);
+      }
+    } else {
+      // Anything else (e.g. 'TEXT') is coerced by the AE Manager as it is
+      //  copied out.
+      AEDesc coerced;
+      err = AEGetNthDesc(desc, index, typeUTF8Text, nullptr, &coerced);
+      if (err == noErr) {
+        utf8.resize(static_cast<size_t>(AEGetDescDataSize(&coerced)));
+        if (!utf8.empty()) {
+          err = AEGetDescData(&coerced, utf8.data(),
+                              static_cast<Size>(utf8.size()));
+        }
+        AEDisposeDesc(&coerced);
+      }
+    }
+    if (err != noErr) {
+      OSError::Throw(env, err, "Reading list item as text failed");
+      return env.Null();
+    }
+
+    if (type == typeUnicodeText) {
+      const size_t skip = !utf16.empty() && utf16[0] == 0xFEFF ? 1 : 0;
+      result.Set(static_cast<uint32_t>(index - 1),
+                 Napi::String::New(env, utf16.data() + skip,
+                                   utf16.size() - skip));
+    } else {
+      result.Set(static_cast<uint32_t>(index - 1),
+                 Napi::String::New(env, utf8.data(), utf8.size()));
+    }
+  }
+  return result;
+}
+
+Napi::Value
+AEListDescriptor::FromTypedArrayOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 2 || !IsFourCharCodeValue(info[0]) ||
+      !info[1].IsTypedArray()) {
+    Napi::TypeError::New(env,
+                         "fromTypedArray takes (type: FourCharCode, array: "
+                         "TypedArray)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  const DescType itemType = JSValueToFourCharCode(info[0]);
+  Napi::TypedArray array = info[1].As<Napi::TypedArray>();
+
+  AEDesc *built = new AEDesc;
+  AEInitializeDesc(built);
+  bool ok = false;
+  switch (itemType) {
+  case typeSInt16:
+    ok = BuildNumericListOrThrow<int16_t>(env, itemType, array, built);
+    break;
+  case typeSInt32:
+    ok = BuildNumericListOrThrow<int32_t>(env, itemType, array, built);
+    break;
+  case typeUInt32:
+    ok = BuildNumericListOrThrow<uint32_t>(env, itemType, array, built);
+    break;
+  case typeSInt64:
+    ok = BuildNumericListOrThrow<int64_t>(env, itemType, array, built);
+    break;
+  case typeUInt64:
+    ok = BuildNumericListOrThrow<uint64_t>(env, itemType, array, built);
+    break;
+  case typeIEEE32BitFloatingPoint:
+    ok = BuildNumericListOrThrow<float>(env, itemType, array, built);
+    break;
+  case typeIEEE64BitFloatingPoint:
+    ok = BuildNumericListOrThrow<double>(env, itemType, array, built);
+    break;
+  default:
+    Napi::TypeError::New(env,
+                         "fromTypedArray type must be 'shor', 'long', 'magn', "
+                         "'comp', 'ucom', 'sing' or 'doub'")
+        .ThrowAsJavaScriptException();
+    break;
+  }
+  if (!ok) {
+    delete built;
+    return env.Null();
+  }
+  return WrapOwnedAEDescOrThrow(env, built);
+}
+
+Napi::Value AEListDescriptor::IterateOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() > 1) {
+    Napi::TypeError::New(env, "iterate takes (options?)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  ListBatchOptions options;
+  if (!ReadListBatchOptionsOrThrow(
+          env, info.Length() == 1 ? info[0] : env.Undefined(), &options)) {
+    return env.Null();
+  }
+
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  return MakeListBatchIterator(env, GetSharedDescriptor(), count, options);
+}
+
+std::vector<Napi::ClassPropertyDescriptor<AEListDescriptor>>
+AEListDescriptor::JSProperties(Napi::Env env) {
+  return {
+      InstanceAccessor("items", &AEListDescriptor::GetItemsOrThrow, nullptr),
+      InstanceAccessor("count", &AEListDescriptor::GetCountOrThrow, nullptr),
+      InstanceMethod("itemAt", &AEListDescriptor::ItemAtOrThrow),
+      InstanceMethod(Napi::Symbol::WellKnown(env, "iterator"),
+                     &AEListDescriptor::IteratorOrThrow),
+      InstanceMethod("iterate", &AEListDescriptor::IterateOrThrow),
+      InstanceMethod("toFloat64Array",
+                     &AEListDescriptor::ToFloat64ArrayOrThrow),
+      InstanceMethod("toInt32Array", &AEListDescriptor::ToInt32ArrayOrThrow),
+      InstanceMethod("toStringArray", &AEListDescriptor::ToStringArrayOrThrow),
+      StaticMethod("fromTypedArray", &AEListDescriptor::FromTypedArrayOrThrow),
+  };
+}
+
+void AERecordDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 2 || !IsFourCharCodeValue(info[0]) ||
+      !info[1].IsObject()) {
+    Napi::TypeError::New(
+        env, "AERecordDescriptor takes (type, Record<AEKeyword, AEDescriptor>)")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+
+  FourCharCode type = JSValueToFourCharCode(info[0]);
+  if (type == 0) {
+    Napi::Error::New(env, "Invalid descriptor type")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  Napi::Object fields = info[1].As<Napi::Object>();
+
+  ScopedAEStream stream;
+  if (!stream.Get()) {
+    OSError::Throw(env, memFullErr, "AEStreamOpen failed");
+    return;
+  }
+  OSStatus err = AEStreamOpenRecord(stream.Get(), type);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEStreamOpenRecord failed");
+    return;
+  }
+  if (!InsertKeywordMap(
+          env, stream.Get(), fields, "Record values must be AEDescriptor",
+          "AEStreamWriteAEDesc failed",
+          [](AEStreamRef target, AEKeyword keyword, const AEDesc *value) {
+            OSStatus writeErr = AEStreamWriteKey(target, keyword);
+            return writeErr != noErr ? writeErr
+                                     : AEStreamWriteAEDesc(target, value);
+          })) {
+    return;
+  }
+  err = AEStreamCloseRecord(stream.Get());
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEStreamCloseRecord failed");
+    return;
+  }
 
   desc = new AEDesc;
-  OSErr err = AECreateDesc(type, array.Data(), array.ByteLength(), desc);
+  err = stream.Close(desc);
   if (err != noErr) {
     delete desc;
     desc = nullptr;
-    OSError::Throw(env, err, "AECreateDesc failed");
+    OSError::Throw(env, err, "AEStreamClose failed");
+    return;
   }
+  NoteDescriptorKind(type, DescriptorKind::Record);
 }
 
-Napi::Value AEDataDescriptor::GetDataOrThrow(const Napi::CallbackInfo &info) {
-  Napi::Env env = info.Env();
-  if (!desc) {
-    Napi::Error::New(env, "Uninitialized descriptor")
-        .ThrowAsJavaScriptException();
-    return env.Null();
+bool AERecordDescriptor::CountItemsOrThrow(Napi::Env env, long *outCount) {
+  if (!CountItemsOnceOrThrow(env, desc, &itemCount)) {
+    return false;
   }
+  if (keywordsByIndex.size() != static_cast<size_t>(itemCount)) {
+    keywordsByIndex.assign(static_cast<size_t>(itemCount), 0);
+  }
+  *outCount = itemCount;
+  return true;
+}
 
-  const Size size = AEGetDescDataSize(desc);
-  if (size < 0) {
-    Napi::Error::New(env, "AEGetDescDataSize failed")
-        .ThrowAsJavaScriptException();
-    return env.Null();
+Napi::Value AERecordDescriptor::EntryOrThrow(Napi::Env env, long index,
+                                             AEKeyword *outKeyword) {
+  const AEKeyword knownKeyword = keywordsByIndex[static_cast<size_t>(index)];
+  if (knownKeyword != 0) {
+    Napi::Value cached = entryCache.Get(index);
+    if (!cached.IsEmpty()) {
+      *outKeyword = knownKeyword;
+      return cached;
+    }
   }
 
-  Napi::Buffer<uint8_t> buffer =
-      Napi::Buffer<uint8_t>::New(env, static_cast<size_t>(size));
-  OSErr err = AEGetDescData(desc, buffer.Data(), size);
+  AEKeyword keyword = 0;
+  AEDesc *fieldDesc = new AEDesc;
+  OSErr err =
+      AEGetNthDesc(desc, index + 1, typeWildCard, &keyword, fieldDesc);
   if (err != noErr) {
-    OSError::Throw(env, err, "AEGetDescData failed");
+    delete fieldDesc;
+    OSError::Throw(env, err, "AEGetNthDesc failed");
     return env.Null();
   }
+  keywordsByIndex[static_cast<size_t>(index)] = keyword;
+  *outKeyword = keyword;
 
-  return buffer;
-}
-
-std::vector<Napi::ClassPropertyDescriptor<AEDataDescriptor>>
-AEDataDescriptor::JSProperties() {
-  return {
-      InstanceAccessor("data", &AEDataDescriptor::GetDataOrThrow, nullptr),
-  };
+  // `AEGetNthDesc` already handed us our own copy, so wrap it directly.
+  Napi::Value wrappedField = WrapOwnedAEDescOrThrow(env, fieldDesc);
+  if (wrappedField.IsObject()) {
+    entryCache.Set(index, wrappedField.As<Napi::Object>());
+  }
+  return wrappedField;
 }
 
-void AEListDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
-  Napi::Env env = info.Env();
-  if (info.Length() != 2 || !info[0].IsString() || !info[1].IsArray()) {
-    Napi::TypeError::New(env, "AEListDescriptor takes (type, AEDescriptor[])")
+Napi::Value AERecordDescriptor::FieldOrThrow(Napi::Env env,
+                                             AEKeyword keyword) {
+  Napi::Value cached = fieldCache.Get(keyword);
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
         .ThrowAsJavaScriptException();
-    return;
+    return env.Undefined();
   }
 
-  FourCharCode type =
-      StringToFourCharCode(info[0].As<Napi::String>().Utf8Value());
-  if (type == 0) {
-    Napi::Error::New(env, "Invalid descriptor type")
-        .ThrowAsJavaScriptException();
-    return;
+  const auto *index = KeyIndexOrThrow(env, false);
+  if (env.IsExceptionPending()) {
+    return env.Undefined();
+  }
+  if (index) {
+    auto found = index->find(keyword);
+    if (found == index->end()) {
+      return env.Undefined();
+    }
+    AEKeyword foundKeyword = 0;
+    Napi::Value wrappedField =
+        EntryOrThrow(env, found->second, &foundKeyword);
+    if (wrappedField.IsObject()) {
+      fieldCache.Set(keyword, wrappedField.As<Napi::Object>());
+    }
+    return wrappedField;
   }
-  Napi::Array items = info[1].As<Napi::Array>();
 
-  desc = new AEDesc;
-  OSErr err = AECreateList(nullptr, 0, false, desc);
+  AEDesc *fieldDesc = new AEDesc;
+  OSErr err = AEGetKeyDesc(desc, keyword, typeWildCard, fieldDesc);
+  if (err == errAEDescNotFound) {
+    delete fieldDesc;
+    return env.Undefined();
+  }
   if (err != noErr) {
-    delete desc;
-    desc = nullptr;
-    OSError::Throw(env, err, "AECreateList failed");
-    return;
+    delete fieldDesc;
+    OSError::Throw(env, err, "AEGetKeyDesc failed");
+    return env.Undefined();
   }
 
-  desc->descriptorType = type;
-  const uint32_t length = items.Length();
-  for (uint32_t i = 0; i < length; ++i) {
-    auto *wrapper = UnwrapDescriptor(items[i]);
-    if (!wrapper) {
-      Napi::Error::New(env, "Invalid AEDescriptor item")
-          .ThrowAsJavaScriptException();
-      return;
-    }
+  Napi::Value wrappedField = WrapOwnedAEDescOrThrow(env, fieldDesc);
+  if (wrappedField.IsObject()) {
+    fieldCache.Set(keyword, wrappedField.As<Napi::Object>());
+  }
+  return wrappedField;
+}
 
-    OSErr putErr = AEPutDesc(desc, 0, wrapper->GetRawDescriptor());
-    if (putErr != noErr) {
-      OSError::Throw(env, putErr, "AEPutDesc failed");
-      return;
+bool AERecordDescriptor::KeywordAtOrThrow(Napi::Env env, long index,
+                                          AEKeyword *outKeyword) {
+  AEKeyword &known = keywordsByIndex[static_cast<size_t>(index)];
+  if (known != 0) {
+    *outKeyword = known;
+    return true;
+  }
+
+  // Asking for no data reads the keyword without copying the field.
+  AEKeyword keyword = 0;
+  DescType type = typeNull;
+  Size size = 0;
+  OSErr err = AEGetNthPtr(desc, index + 1, typeWildCard, &keyword, &type,
+                          nullptr, 0, &size);
+  if (err != noErr) {
+    // Fall back to copying the field out, for items `AEGetNthPtr` won't read.
+    AEDesc field;
+    err = AEGetNthDesc(desc, index + 1, typeWildCard, &keyword, &field);
+    if (err != noErr) {
+      OSError::Throw(env, err, "AEGetNthDesc failed");
+      return false;
     }
+    AEDisposeDesc(&field);
   }
+  known = keyword;
+  *outKeyword = keyword;
+  return true;
 }
 
-Napi::Value AEListDescriptor::GetItemsOrThrow(const Napi::CallbackInfo &info) {
-  Napi::Env env = info.Env();
+const std::unordered_map<AEKeyword, long> *
+AERecordDescriptor::KeyIndexOrThrow(Napi::Env env, bool force) {
+  if (hasKeyIndex) {
+    return &keyIndex;
+  }
   long count = 0;
-  OSErr countErr = AECountItems(desc, &count);
-  if (countErr != noErr) {
-    OSError::Throw(env, countErr, "AECountItems failed");
-    return env.Null();
+  if (!CountItemsOrThrow(env, &count)) {
+    return nullptr;
+  }
+  if (!force && count < kKeyIndexThreshold) {
+    return nullptr;
   }
 
-  Napi::Array result = Napi::Array::New(env, static_cast<uint32_t>(count));
-  for (long index = 1; index <= count; ++index) {
-    AEDesc itemDesc;
-    OSErr getErr = AEGetNthDesc(desc, index, typeWildCard, nullptr, &itemDesc);
-    if (getErr != noErr) {
-      OSError::Throw(env, getErr, "AEGetNthDesc failed");
-      return env.Null();
+  std::unordered_map<AEKeyword, long> built;
+  built.reserve(static_cast<size_t>(count));
+  for (long index = 0; index < count; ++index) {
+    AEKeyword keyword = 0;
+    if (!KeywordAtOrThrow(env, index, &keyword)) {
+      return nullptr;
     }
+    // `AEGetKeyDesc` finds the first field with a keyword, so keep that one.
+    built.emplace(keyword, index);
+  }
+  keyIndex = std::move(built);
+  hasKeyIndex = true;
+  return &keyIndex;
+}
+
+Napi::Value
+AERecordDescriptor::GetFieldsOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return Napi::Object::New(env);
+  }
 
-    Napi::Value wrappedItem = CopyAndWrapAEDescOrThrow(env, &itemDesc);
-    AEDisposeDesc(&itemDesc);
+  Napi::Object result = Napi::Object::New(env);
+  for (long index = 0; index < count; ++index) {
+    AEKeyword keyword = 0;
+    Napi::Value wrappedField = EntryOrThrow(env, index, &keyword);
     if (env.IsExceptionPending()) {
-      return env.Null();
+      return Napi::Object::New(env);
     }
-    result.Set(static_cast<uint32_t>(index - 1), wrappedItem);
+    result.Set(FourCharCodeToJS(env, keyword), wrappedField);
   }
-
   return result;
 }
 
-std::vector<Napi::ClassPropertyDescriptor<AEListDescriptor>>
-AEListDescriptor::JSProperties() {
-  return {
-      InstanceAccessor("items", &AEListDescriptor::GetItemsOrThrow, nullptr),
-  };
+Napi::Value
+AERecordDescriptor::GetCountOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  return Napi::Number::New(env, static_cast<double>(count));
 }
 
-void AERecordDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
+Napi::Value
+AERecordDescriptor::GetFieldOrThrow(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
-  if (info.Length() != 2 || !info[0].IsString() || !info[1].IsObject()) {
-    Napi::TypeError::New(
-        env, "AERecordDescriptor takes (type, Record<AEKeyword, AEDescriptor>)")
-        .ThrowAsJavaScriptException();
-    return;
+  AEKeyword keyword = 0;
+  if (!ReadKeywordArgumentOrThrow(info, "getField takes (keyword)",
+                                  "Invalid keyword", &keyword)) {
+    return env.Undefined();
   }
+  return FieldOrThrow(env, keyword);
+}
 
-  FourCharCode type =
-      StringToFourCharCode(info[0].As<Napi::String>().Utf8Value());
-  if (type == 0) {
-    Napi::Error::New(env, "Invalid descriptor type")
+Napi::Value
+AERecordDescriptor::HasFieldOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  AEKeyword keyword = 0;
+  if (!ReadKeywordArgumentOrThrow(info, "hasField takes (keyword)",
+                                  "Invalid keyword", &keyword)) {
+    return env.Undefined();
+  }
+  if (!fieldCache.Get(keyword).IsEmpty()) {
+    return Napi::Boolean::New(env, true);
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
         .ThrowAsJavaScriptException();
-    return;
+    return env.Undefined();
   }
-  Napi::Object fields = info[1].As<Napi::Object>();
 
-  desc = new AEDesc;
-  OSErr err = AECreateList(nullptr, 0, true, desc);
+  const auto *index = KeyIndexOrThrow(env, false);
+  if (env.IsExceptionPending()) {
+    return env.Undefined();
+  }
+  if (index) {
+    return Napi::Boolean::New(env, index->find(keyword) != index->end());
+  }
+
+  DescType type = typeNull;
+  Size size = 0;
+  OSErr err = AESizeOfKeyDesc(desc, keyword, &type, &size);
+  if (err == errAEDescNotFound) {
+    return Napi::Boolean::New(env, false);
+  }
   if (err != noErr) {
-    delete desc;
-    desc = nullptr;
-    OSError::Throw(env, err, "AECreateList(record) failed");
-    return;
+    OSError::Throw(env, err, "AESizeOfKeyDesc failed");
+    return env.Undefined();
   }
+  return Napi::Boolean::New(env, true);
+}
 
-  desc->descriptorType = type;
-  if (!InsertKeywordMap(
-          env, desc, fields, "Record values must be AEDescriptor",
-          "AEPutKeyDesc failed",
-          [](AEDesc *target, AEKeyword keyword, const AEDesc *value) {
-            return AEPutKeyDesc(target, keyword, value);
-          })) {
-    return;
+Napi::Value AERecordDescriptor::KeysOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (!KeyIndexOrThrow(env, true)) {
+    return env.Null();
   }
+  Napi::Array result = Napi::Array::New(env, keywordsByIndex.size());
+  for (size_t index = 0; index < keywordsByIndex.size(); ++index) {
+    result.Set(static_cast<uint32_t>(index),
+               FourCharCodeToJS(env, keywordsByIndex[index]));
+  }
+  return result;
 }
 
 Napi::Value
-AERecordDescriptor::GetFieldsOrThrow(const Napi::CallbackInfo &info) {
-  return ReadKeyedItemsOrThrow(info.Env(), desc, "AECountItems failed",
-                               "AEGetNthDesc failed");
+AERecordDescriptor::IteratorOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  long count = 0;
+  if (!CountItemsOrThrow(env, &count)) {
+    return env.Null();
+  }
+  return MakeIndexIterator(
+      env, this, count,
+      [](AERecordDescriptor *record, Napi::Env env,
+         long index) -> Napi::Value {
+        AEKeyword keyword = 0;
+        Napi::Value field = record->EntryOrThrow(env, index, &keyword);
+        if (env.IsExceptionPending()) {
+          return env.Undefined();
+        }
+        Napi::Array entry = Napi::Array::New(env, 2);
+        entry.Set(0u, FourCharCodeToJS(env, keyword));
+        entry.Set(1u, field);
+        return entry;
+      });
 }
 
 std::vector<Napi::ClassPropertyDescriptor<AERecordDescriptor>>
-AERecordDescriptor::JSProperties() {
+AERecordDescriptor::JSProperties(Napi::Env env) {
   return {
       InstanceAccessor("fields", &AERecordDescriptor::GetFieldsOrThrow,
                        nullptr),
+      InstanceAccessor("count", &AERecordDescriptor::GetCountOrThrow,
+                       nullptr),
+      InstanceMethod("getField", &AERecordDescriptor::GetFieldOrThrow),
+      InstanceMethod("hasField", &AERecordDescriptor::HasFieldOrThrow),
+      InstanceMethod("keys", &AERecordDescriptor::KeysOrThrow),
+      // Kept for compatibility; `getField` is the same method.
+      InstanceMethod("fieldAt", &AERecordDescriptor::GetFieldOrThrow),
+      InstanceMethod(Napi::Symbol::WellKnown(env, "iterator"),
+                     &AERecordDescriptor::IteratorOrThrow),
   };
 }
 
 void AEEventDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
-  if (info.Length() != 7 || !info[0].IsString() || !info[1].IsString() ||
-      !info[2].IsObject() || !info[3].IsNumber() || !info[4].IsNumber() ||
-      !info[5].IsObject() || !info[6].IsObject()) {
+  if (info.Length() != 7 || !IsFourCharCodeValue(info[0]) ||
+      !IsFourCharCodeValue(info[1]) || !info[2].IsObject() ||
+      !info[3].IsNumber() || !info[4].IsNumber() || !info[5].IsObject() ||
+      !info[6].IsObject()) {
     Napi::TypeError::New(
         env, "AEEventDescriptor takes (eventClass, eventID, target, returnID, "
              "transactionID, parameters, attributes)")
@@ -425,14 +1557,12 @@ void AEEventDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
     return;
   }
 
-  FourCharCode eventClass =
-      StringToFourCharCode(info[0].As<Napi::String>().Utf8Value());
+  FourCharCode eventClass = JSValueToFourCharCode(info[0]);
   if (eventClass == 0) {
     Napi::Error::New(env, "Invalid event class").ThrowAsJavaScriptException();
     return;
   }
-  FourCharCode eventID =
-      StringToFourCharCode(info[1].As<Napi::String>().Utf8Value());
+  FourCharCode eventID = JSValueToFourCharCode(info[1]);
   if (eventID == 0) {
     Napi::Error::New(env, "Invalid event ID").ThrowAsJavaScriptException();
     return;
@@ -445,39 +1575,20 @@ void AEEventDescriptor::InitFromJS(const Napi::CallbackInfo &info) {
     return;
   }
 
-  AEReturnID returnID =
-      static_cast<AEReturnID>(info[3].As<Napi::Number>().Int32Value());
-  AETransactionID transactionID =
-      static_cast<AETransactionID>(info[4].As<Napi::Number>().Int32Value());
-  Napi::Object parameters = info[5].As<Napi::Object>();
-  Napi::Object attributes = info[6].As<Napi::Object>();
-
-  desc = new AEDesc;
-  OSErr err =
-      AECreateAppleEvent(eventClass, eventID, targetWrapper->GetRawDescriptor(),
-                         returnID, transactionID, desc);
-  if (err != noErr) {
-    delete desc;
-    desc = nullptr;
-    OSError::Throw(env, err, "AECreateAppleEvent failed");
+  AEReturnID returnID = kAutoGenerateReturnID;
+  if (!ReturnIDFromJSOrThrow(info[3], &returnID)) {
     return;
   }
-
-  if (!InsertKeywordMap(
-          env, desc, parameters, "Parameter values must be AEDescriptor",
-          "AEPutParamDesc failed",
-          [](AEDesc *target, AEKeyword keyword, const AEDesc *value) {
-            return AEPutParamDesc(target, keyword, value);
-          })) {
+  AETransactionID transactionID = kAnyTransactionID;
+  if (!TransactionIDFromJSOrThrow(info[4], &transactionID)) {
     return;
   }
+  Napi::Object parameters = info[5].As<Napi::Object>();
+  Napi::Object attributes = info[6].As<Napi::Object>();
 
-  InsertKeywordMap(env, desc, attributes,
-                   "Attribute values must be AEDescriptor",
-                   "AEPutAttributeDesc failed",
-                   [](AEDesc *target, AEKeyword keyword, const AEDesc *value) {
-                     return AEPutAttributeDesc(target, keyword, value);
-                   });
+  CreateAppleEventOrThrow(env, eventClass, eventID,
+                          targetWrapper->GetRawDescriptor(), returnID,
+                          transactionID, parameters, attributes, &desc);
 }
 
 Napi::Value
@@ -488,7 +1599,7 @@ AEEventDescriptor::GetEventClassOrThrow(const Napi::CallbackInfo &info) {
                             "AEGetAttributePtr(keyEventClassAttr) failed")) {
     return env.Null();
   }
-  return Napi::String::New(env, FourCharCodeToString(eventClass));
+  return FourCharCodeToJS(env, eventClass);
 }
 
 Napi::Value
@@ -499,7 +1610,7 @@ AEEventDescriptor::GetEventIDOrThrow(const Napi::CallbackInfo &info) {
                             "AEGetAttributePtr(keyEventIDAttr) failed")) {
     return env.Null();
   }
-  return Napi::String::New(env, FourCharCodeToString(eventID));
+  return FourCharCodeToJS(env, eventID);
 }
 
 Napi::Value
@@ -510,9 +1621,8 @@ AEEventDescriptor::GetTargetOrThrow(const Napi::CallbackInfo &info) {
                                 "AEGetAttributeDesc(keyAddressAttr) failed")) {
     return env.Null();
   }
-  Napi::Value wrappedTarget = CopyAndWrapAEDescOrThrow(env, &targetDesc);
-  AEDisposeDesc(&targetDesc);
-  return wrappedTarget;
+  // Already our own copy; the wrapper takes it over rather than copying again.
+  return WrapOwnedAEDescOrThrow(env, new AEDesc(targetDesc));
 }
 
 Napi::Value
@@ -545,34 +1655,175 @@ AEEventDescriptor::GetParametersOrThrow(const Napi::CallbackInfo &info) {
 }
 
 Napi::Value
-AEEventDescriptor::GetAttributeOrThrow(const Napi::CallbackInfo &info) {
+AEEventDescriptor::GetParameterOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  AEKeyword keyword = 0;
+  if (!ReadKeywordArgumentOrThrow(info, "getParameter takes (keyword)",
+                                  "Invalid parameter keyword", &keyword)) {
+    return env.Undefined();
+  }
+  Napi::Value cached = parameterCache.Get(keyword);
+  if (!cached.IsEmpty()) {
+    return cached;
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  AEDesc *parameterDesc = new AEDesc;
+  OSErr err = AEGetParamDesc(desc, keyword, typeWildCard, parameterDesc);
+  if (err == errAEDescNotFound) {
+    delete parameterDesc;
+    return env.Undefined();
+  }
+  if (err != noErr) {
+    delete parameterDesc;
+    OSError::Throw(env, err, "AEGetParamDesc failed");
+    return env.Undefined();
+  }
+
+  // `AEGetParamDesc` already handed us our own copy, so wrap it directly.
+  Napi::Value wrappedParameter = WrapOwnedAEDescOrThrow(env, parameterDesc);
+  if (wrappedParameter.IsObject()) {
+    parameterCache.Set(keyword, wrappedParameter.As<Napi::Object>());
+  }
+  return wrappedParameter;
+}
+
+Napi::Value
+AEEventDescriptor::GetParameterStringOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  AEKeyword keyword = 0;
+  if (!ReadKeywordArgumentOrThrow(info, "getParameterString takes (keyword)",
+                                  "Invalid parameter keyword", &keyword)) {
+    return env.Undefined();
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Most parameters fit here, and are read with a single call.
+  char stackBuffer[256];
+  Size size = 0;
+  OSErr err = AEGetParamPtr(desc, keyword, typeUTF8Text, nullptr, stackBuffer,
+                            sizeof(stackBuffer), &size);
+  if (err == errAEDescNotFound) {
+    return env.Undefined();
+  }
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEGetParamPtr(typeUTF8Text) failed");
+    return env.Undefined();
+  }
+  if (size <= static_cast<Size>(sizeof(stackBuffer))) {
+    return Napi::String::New(env, stackBuffer, static_cast<size_t>(size));
+  }
+
+  std::string heapBuffer(static_cast<size_t>(size), '\0');
+  err = AEGetParamPtr(desc, keyword, typeUTF8Text, nullptr, heapBuffer.data(),
+                      size, &size);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEGetParamPtr(typeUTF8Text) failed");
+    return env.Undefined();
+  }
+  return Napi::String::New(env, heapBuffer);
+}
+
+Napi::Value
+AEEventDescriptor::GetParameterInt32OrThrow(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
-  if (info.Length() != 1 || !info[0].IsString()) {
-    Napi::TypeError::New(env, "getAttribute takes (keyword)")
+  AEKeyword keyword = 0;
+  if (!ReadKeywordArgumentOrThrow(info, "getParameterInt32 takes (keyword)",
+                                  "Invalid parameter keyword", &keyword)) {
+    return env.Undefined();
+  }
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
         .ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
-  FourCharCode keyword =
-      StringToFourCharCode(info[0].As<Napi::String>().Utf8Value());
-  if (keyword == 0) {
-    Napi::Error::New(env, "Invalid attribute keyword")
+  int32_t value = 0;
+  Size size = 0;
+  OSErr err = AEGetParamPtr(desc, keyword, typeSInt32, nullptr, &value,
+                            sizeof(value), &size);
+  if (err == errAEDescNotFound) {
+    return env.Undefined();
+  }
+  if (err == noErr && size != static_cast<Size>(sizeof(value))) {
+    err = errAECorruptData;
+  }
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEGetParamPtr(typeSInt32) failed");
+    return env.Undefined();
+  }
+  return Napi::Number::New(env, value);
+}
+
+Napi::Value AEEventDescriptor::AttributeOrThrow(Napi::Env env,
+                                                AEKeyword keyword) {
+  if (!desc) {
+    Napi::Error::New(env, "Uninitialized descriptor")
         .ThrowAsJavaScriptException();
     return env.Undefined();
   }
-  AEDesc attributeDesc;
-  OSErr err = AEGetAttributeDesc(desc, keyword, typeWildCard, &attributeDesc);
+  AEDesc *attributeDesc = new AEDesc;
+  OSErr err = AEGetAttributeDesc(desc, keyword, typeWildCard, attributeDesc);
   if (err != noErr) {
+    delete attributeDesc;
+    return env.Undefined();
+  }
+  // `AEGetAttributeDesc` already handed us our own copy, so wrap it directly.
+  return WrapOwnedAEDescOrThrow(env, attributeDesc);
+}
+
+Napi::Value
+AEEventDescriptor::GetAttributeOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  AEKeyword keyword = 0;
+  if (!ReadKeywordArgumentOrThrow(info, "getAttribute takes (keyword)",
+                                  "Invalid attribute keyword", &keyword)) {
+    return env.Undefined();
+  }
+  return AttributeOrThrow(env, keyword);
+}
+
+Napi::Value
+AEEventDescriptor::GetAttributesOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "getAttributes takes (keywords: AEKeyword[])")
+        .ThrowAsJavaScriptException();
     return env.Undefined();
   }
 
-  Napi::Value wrappedAttribute = CopyAndWrapAEDescOrThrow(env, &attributeDesc);
-  AEDisposeDesc(&attributeDesc);
-  return wrappedAttribute;
+  Napi::Array keywords = info[0].As<Napi::Array>();
+  const uint32_t length = keywords.Length();
+  Napi::Array result = Napi::Array::New(env, length);
+  for (uint32_t i = 0; i < length; ++i) {
+    Napi::Value keywordValue = keywords.Get(i);
+    AEKeyword keyword = IsFourCharCodeValue(keywordValue)
+                            ? JSValueToFourCharCode(keywordValue)
+                            : 0;
+    if (keyword == 0) {
+      Napi::Error::New(env, "Invalid attribute keyword")
+          .ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    Napi::Value attribute = AttributeOrThrow(env, keyword);
+    if (env.IsExceptionPending()) {
+      return env.Undefined();
+    }
+    result.Set(i, attribute);
+  }
+  return result;
 }
 
 std::vector<Napi::ClassPropertyDescriptor<AEEventDescriptor>>
-AEEventDescriptor::JSProperties() {
+AEEventDescriptor::JSProperties(Napi::Env) {
   return {
       InstanceAccessor("eventClass", &AEEventDescriptor::GetEventClassOrThrow,
                        nullptr),
@@ -585,7 +1836,13 @@ AEEventDescriptor::JSProperties() {
                        &AEEventDescriptor::GetTransactionIDOrThrow, nullptr),
       InstanceAccessor("parameters", &AEEventDescriptor::GetParametersOrThrow,
                        nullptr),
+      InstanceMethod("getParameter", &AEEventDescriptor::GetParameterOrThrow),
+      InstanceMethod("getParameterString",
+                     &AEEventDescriptor::GetParameterStringOrThrow),
+      InstanceMethod("getParameterInt32",
+                     &AEEventDescriptor::GetParameterInt32OrThrow),
       InstanceMethod("getAttribute", &AEEventDescriptor::GetAttributeOrThrow),
+      InstanceMethod("getAttributes", &AEEventDescriptor::GetAttributesOrThrow),
   };
 }
 
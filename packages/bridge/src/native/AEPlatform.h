@@ -0,0 +1,11 @@
+#pragma once
+
+// The Apple Event Manager the bridge is built against: CoreServices by
+//  default, or the portable descriptor engine when `AEJS_USE_PORTABLE_ENGINE`
+//  is defined (see `binding.gyp`).
+
+#if defined(AEJS_USE_PORTABLE_ENGINE)
+#include "AEPortable.h"
+#else
+#include <CoreServices/CoreServices.h>
+#endif
@@ -0,0 +1,659 @@
+#include "AEPortable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Engine = ae_js_bridge::DescriptorEngine;
+
+namespace {
+// Copies the (coerced) data of `desc` out like the AE Manager's `...Ptr`
+//  getters do: as much as fits, while reporting the full size.
+OSErr CopyOut(AEDesc *desc, DescType *typeCode, void *dataPtr,
+              Size maximumSize, Size *actualSize) {
+  if (typeCode) {
+    *typeCode = desc->descriptorType;
+  }
+  const Size size = AEGetDescDataSize(desc);
+  if (actualSize) {
+    *actualSize = size;
+  }
+  OSErr err = noErr;
+  if (dataPtr && maximumSize > 0) {
+    err = AEGetDescData(desc, dataPtr, maximumSize);
+  }
+  AEDisposeDesc(desc);
+  return err;
+}
+
+OSErr SizeOf(AEDesc *desc, DescType *typeCode, Size *dataSize) {
+  return CopyOut(desc, typeCode, nullptr, 0, dataSize);
+}
+
+// Builds a temporary data descriptor for the `...Ptr` setters.
+template <typename Put>
+OSErr PutData(DescType typeCode, const void *dataPtr, Size dataSize, Put put) {
+  AEDesc desc;
+  OSErr err = AECreateDesc(typeCode, dataPtr, dataSize, &desc);
+  if (err != noErr) {
+    return err;
+  }
+  err = put(desc);
+  AEDisposeDesc(&desc);
+  return err;
+}
+
+struct InstalledHandler {
+  AEEventHandlerUPP handler;
+  SRefCon refcon;
+};
+
+std::mutex handlersMutex;
+std::map<std::pair<AEEventClass, AEEventID>, InstalledHandler> handlers;
+
+// See `AEPortableSimulateSends`.
+std::atomic<int64_t> simulatedLatency{0};
+std::atomic<OSErr> simulatedResult{procNotFound};
+
+AEReturnID ReturnIDOf(const AppleEvent *event) {
+  AEReturnID returnID = 0;
+  AEGetAttributePtr(event, keyReturnIDAttr, typeSInt16, nullptr, &returnID,
+                    sizeof(returnID), nullptr);
+  return returnID;
+}
+
+OSErr MakeAnswer(AEReturnID returnID, AppleEvent *answer) {
+  AEAddressDesc target;
+  AEInitializeDesc(&target);
+  return AECreateAppleEvent(kCoreEventClass, kAEAnswer, &target, returnID,
+                            kAnyTransactionID, answer);
+}
+
+// Queued replies waiting out their simulated latency, soonest first. One
+//  thread, started on first use and never stopped, dispatches them. Never
+//  destroyed either, since that thread may still be waiting on it at exit.
+struct ScheduledAnswer {
+  std::chrono::steady_clock::time_point due;
+  AEReturnID returnID;
+
+  bool operator>(const ScheduledAnswer &other) const {
+    return due > other.due;
+  }
+};
+
+struct AnswerQueue {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::priority_queue<ScheduledAnswer, std::vector<ScheduledAnswer>,
+                      std::greater<ScheduledAnswer>>
+      scheduled;
+  bool threadStarted = false;
+};
+
+AnswerQueue &Answers() {
+  static AnswerQueue *answers = new AnswerQueue;
+  return *answers;
+}
+
+void DispatchAnswer(AEReturnID returnID) {
+  InstalledHandler installed{};
+  {
+    std::lock_guard<std::mutex> lock(handlersMutex);
+    auto it = handlers.find({kCoreEventClass, kAEAnswer});
+    if (it == handlers.end()) {
+      return;
+    }
+    installed = it->second;
+  }
+  AppleEvent answer;
+  if (MakeAnswer(returnID, &answer) != noErr) {
+    return;
+  }
+  AppleEvent reply;
+  AEInitializeDesc(&reply);
+  installed.handler(&answer, &reply, installed.refcon);
+  AEDisposeDesc(&reply);
+  AEDisposeDesc(&answer);
+}
+
+void DispatchAnswers() {
+  AnswerQueue &answers = Answers();
+  std::unique_lock<std::mutex> lock(answers.mutex);
+  for (;;) {
+    if (answers.scheduled.empty()) {
+      answers.changed.wait(lock);
+      continue;
+    }
+    const ScheduledAnswer next = answers.scheduled.top();
+    if (std::chrono::steady_clock::now() < next.due) {
+      answers.changed.wait_until(lock, next.due);
+      continue;
+    }
+    answers.scheduled.pop();
+    lock.unlock();
+    DispatchAnswer(next.returnID);
+    lock.lock();
+  }
+}
+
+void ScheduleAnswer(const AppleEvent *event,
+                    std::chrono::microseconds latency) {
+  AnswerQueue &answers = Answers();
+  std::lock_guard<std::mutex> lock(answers.mutex);
+  answers.scheduled.push(
+      {std::chrono::steady_clock::now() + latency, ReturnIDOf(event)});
+  if (!answers.threadStarted) {
+    answers.threadStarted = true;
+    std::thread(DispatchAnswers).detach();
+  }
+  answers.changed.notify_one();
+}
+} // namespace
+
+void AEInitializeDesc(AEDesc *desc) { Engine::Initialize(desc); }
+
+OSErr AECreateDesc(DescType typeCode, const void *dataPtr, Size dataSize,
+                   AEDesc *result) {
+  if (dataSize < 0) {
+    return paramErr;
+  }
+  return Engine::CreateData(typeCode, dataPtr, static_cast<size_t>(dataSize),
+                            result);
+}
+
+OSErr AEDisposeDesc(AEDesc *theAEDesc) { return Engine::Dispose(theAEDesc); }
+
+OSErr AEDuplicateDesc(const AEDesc *theAEDesc, AEDesc *result) {
+  if (!theAEDesc || !result) {
+    return paramErr;
+  }
+  return Engine::Duplicate(*theAEDesc, result);
+}
+
+OSErr AEReplaceDescData(DescType typeCode, const void *dataPtr, Size dataSize,
+                        AEDesc *theAEDesc) {
+  if (dataSize < 0) {
+    return paramErr;
+  }
+  return Engine::ReplaceData(typeCode, dataPtr, static_cast<size_t>(dataSize),
+                             theAEDesc);
+}
+
+Size AEGetDescDataSize(const AEDesc *theAEDesc) {
+  return theAEDesc ? static_cast<Size>(Engine::DataSize(*theAEDesc)) : 0;
+}
+
+OSErr AEGetDescData(const AEDesc *theAEDesc, void *dataPtr, Size maximumSize) {
+  if (!theAEDesc || maximumSize < 0) {
+    return paramErr;
+  }
+  return Engine::GetData(*theAEDesc, dataPtr,
+                         static_cast<size_t>(maximumSize));
+}
+
+OSErr AEGetDescDataRange(const AEDesc *dataDesc, void *buffer, Size offset,
+                         Size length) {
+  if (!dataDesc || offset < 0 || length < 0) {
+    return paramErr;
+  }
+  return Engine::GetDataRange(*dataDesc, buffer, static_cast<size_t>(offset),
+                              static_cast<size_t>(length));
+}
+
+OSErr AECoerceDesc(const AEDesc *theAEDesc, DescType toType, AEDesc *result) {
+  if (!theAEDesc) {
+    return paramErr;
+  }
+  return Engine::Coerce(*theAEDesc, toType, result);
+}
+
+OSErr AECoercePtr(DescType typeCode, const void *dataPtr, Size dataSize,
+                  DescType toType, AEDesc *result) {
+  return PutData(typeCode, dataPtr, dataSize, [&](const AEDesc &desc) {
+    return AECoerceDesc(&desc, toType, result);
+  });
+}
+
+OSErr AECreateList(const void *, Size factoredSize, Boolean isRecord,
+                   AEDescList *resultList) {
+  // Factored lists are an optimization the engine doesn't need.
+  if (factoredSize != 0) {
+    return paramErr;
+  }
+  return Engine::CreateList(isRecord, resultList);
+}
+
+Boolean AECheckIsRecord(const AEDesc *theDesc) {
+  return theDesc && Engine::IsRecord(*theDesc);
+}
+
+OSErr AECountItems(const AEDescList *theAEDescList, long *theCount) {
+  if (!theAEDescList || !theCount) {
+    return paramErr;
+  }
+  return Engine::CountItems(*theAEDescList, theCount);
+}
+
+OSErr AEGetNthDesc(const AEDescList *theAEDescList, long index,
+                   DescType desiredType, AEKeyword *theAEKeyword,
+                   AEDesc *result) {
+  if (!theAEDescList || !result) {
+    return paramErr;
+  }
+  return Engine::GetNthDesc(*theAEDescList, index, desiredType, theAEKeyword,
+                            result);
+}
+
+OSErr AEGetNthPtr(const AEDescList *theAEDescList, long index,
+                  DescType desiredType, AEKeyword *theAEKeyword,
+                  DescType *typeCode, void *dataPtr, Size maximumSize,
+                  Size *actualSize) {
+  if (!theAEDescList) {
+    return paramErr;
+  }
+  // Asking for no data, as when only the keyword is wanted, needs no copy.
+  if (desiredType == typeWildCard && (!dataPtr || maximumSize <= 0)) {
+    size_t size = 0;
+    OSErr err = Engine::PeekNth(*theAEDescList, index, theAEKeyword, typeCode,
+                                &size);
+    if (err == noErr && actualSize) {
+      *actualSize = static_cast<Size>(size);
+    }
+    return err;
+  }
+  AEDesc desc;
+  OSErr err =
+      AEGetNthDesc(theAEDescList, index, desiredType, theAEKeyword, &desc);
+  if (err != noErr) {
+    return err;
+  }
+  return CopyOut(&desc, typeCode, dataPtr, maximumSize, actualSize);
+}
+
+OSErr AESizeOfNthItem(const AEDescList *theAEDescList, long index,
+                      DescType *typeCode, Size *dataSize) {
+  if (!theAEDescList) {
+    return paramErr;
+  }
+  size_t size = 0;
+  OSErr err =
+      Engine::PeekNth(*theAEDescList, index, nullptr, typeCode, &size);
+  if (err == noErr && dataSize) {
+    *dataSize = static_cast<Size>(size);
+  }
+  return err;
+}
+
+OSErr AEPutDesc(AEDescList *theAEDescList, long index,
+                const AEDesc *theAEDesc) {
+  if (!theAEDesc) {
+    return paramErr;
+  }
+  return Engine::PutDesc(theAEDescList, index, *theAEDesc);
+}
+
+OSErr AEPutPtr(AEDescList *theAEDescList, long index, DescType typeCode,
+               const void *dataPtr, Size dataSize) {
+  return PutData(typeCode, dataPtr, dataSize, [&](const AEDesc &desc) {
+    return AEPutDesc(theAEDescList, index, &desc);
+  });
+}
+
+OSErr AEDeleteItem(AEDescList *theAEDescList, long index) {
+  return Engine::DeleteItem(theAEDescList, index);
+}
+
+OSErr AEPutKeyDesc(AERecord *theAERecord, AEKeyword theAEKeyword,
+                   const AEDesc *theAEDesc) {
+  if (!theAEDesc) {
+    return paramErr;
+  }
+  return Engine::PutKeyDesc(theAERecord, theAEKeyword, *theAEDesc);
+}
+
+OSErr AEGetKeyDesc(const AERecord *theAERecord, AEKeyword theAEKeyword,
+                   DescType desiredType, AEDesc *result) {
+  if (!theAERecord || !result) {
+    return paramErr;
+  }
+  return Engine::GetKeyDesc(*theAERecord, theAEKeyword, desiredType, result);
+}
+
+OSErr AEGetKeyPtr(const AERecord *theAERecord, AEKeyword theAEKeyword,
+                  DescType desiredType, DescType *typeCode, void *dataPtr,
+                  Size maximumSize, Size *actualSize) {
+  AEDesc desc;
+  OSErr err = AEGetKeyDesc(theAERecord, theAEKeyword, desiredType, &desc);
+  if (err != noErr) {
+    return err;
+  }
+  return CopyOut(&desc, typeCode, dataPtr, maximumSize, actualSize);
+}
+
+OSErr AESizeOfKeyDesc(const AERecord *theAERecord, AEKeyword theAEKeyword,
+                      DescType *typeCode, Size *dataSize) {
+  if (!theAERecord) {
+    return paramErr;
+  }
+  size_t size = 0;
+  OSErr err = Engine::PeekKey(*theAERecord, theAEKeyword, typeCode, &size);
+  if (err == noErr && dataSize) {
+    *dataSize = static_cast<Size>(size);
+  }
+  return err;
+}
+
+OSErr AEDeleteKeyDesc(AERecord *theAERecord, AEKeyword theAEKeyword) {
+  return Engine::DeleteKeyDesc(theAERecord, theAEKeyword);
+}
+
+OSErr AECreateAppleEvent(AEEventClass theAEEventClass, AEEventID theAEEventID,
+                         const AEAddressDesc *target, AEReturnID returnID,
+                         AETransactionID transactionID, AppleEvent *result) {
+  return Engine::CreateAppleEvent(theAEEventClass, theAEEventID, target,
+                                  returnID, transactionID, result);
+}
+
+OSErr AEPutParamDesc(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                     const AEDesc *theAEDesc) {
+  return AEPutKeyDesc(theAppleEvent, theAEKeyword, theAEDesc);
+}
+
+OSErr AEPutParamPtr(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                    DescType typeCode, const void *dataPtr, Size dataSize) {
+  return PutData(typeCode, dataPtr, dataSize, [&](const AEDesc &desc) {
+    return AEPutParamDesc(theAppleEvent, theAEKeyword, &desc);
+  });
+}
+
+OSErr AEGetParamDesc(const AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                     DescType desiredType, AEDesc *result) {
+  return AEGetKeyDesc(theAppleEvent, theAEKeyword, desiredType, result);
+}
+
+OSErr AEGetParamPtr(const AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                    DescType desiredType, DescType *actualType, void *dataPtr,
+                    Size maximumSize, Size *actualSize) {
+  return AEGetKeyPtr(theAppleEvent, theAEKeyword, desiredType, actualType,
+                     dataPtr, maximumSize, actualSize);
+}
+
+OSErr AESizeOfParam(const AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                    DescType *typeCode, Size *dataSize) {
+  return AESizeOfKeyDesc(theAppleEvent, theAEKeyword, typeCode, dataSize);
+}
+
+OSErr AEDeleteParam(AppleEvent *theAppleEvent, AEKeyword theAEKeyword) {
+  return AEDeleteKeyDesc(theAppleEvent, theAEKeyword);
+}
+
+OSErr AEPutAttributeDesc(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                         const AEDesc *theAEDesc) {
+  if (!theAEDesc) {
+    return paramErr;
+  }
+  return Engine::PutAttributeDesc(theAppleEvent, theAEKeyword, *theAEDesc);
+}
+
+OSErr AEPutAttributePtr(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                        DescType typeCode, const void *dataPtr, Size dataSize) {
+  return PutData(typeCode, dataPtr, dataSize, [&](const AEDesc &desc) {
+    return AEPutAttributeDesc(theAppleEvent, theAEKeyword, &desc);
+  });
+}
+
+OSErr AEGetAttributeDesc(const AppleEvent *theAppleEvent,
+                         AEKeyword theAEKeyword, DescType desiredType,
+                         AEDesc *result) {
+  if (!theAppleEvent || !result) {
+    return paramErr;
+  }
+  return Engine::GetAttributeDesc(*theAppleEvent, theAEKeyword, desiredType,
+                                  result);
+}
+
+OSErr AEGetAttributePtr(const AppleEvent *theAppleEvent,
+                        AEKeyword theAEKeyword, DescType desiredType,
+                        DescType *typeCode, void *dataPtr, Size maximumSize,
+                        Size *actualSize) {
+  AEDesc desc;
+  OSErr err =
+      AEGetAttributeDesc(theAppleEvent, theAEKeyword, desiredType, &desc);
+  if (err != noErr) {
+    return err;
+  }
+  return CopyOut(&desc, typeCode, dataPtr, maximumSize, actualSize);
+}
+
+OSErr AESizeOfAttribute(const AppleEvent *theAppleEvent,
+                        AEKeyword theAEKeyword, DescType *typeCode,
+                        Size *dataSize) {
+  AEDesc desc;
+  OSErr err =
+      AEGetAttributeDesc(theAppleEvent, theAEKeyword, typeWildCard, &desc);
+  if (err != noErr) {
+    return err;
+  }
+  return SizeOf(&desc, typeCode, dataSize);
+}
+
+Size AESizeOfFlattenedDesc(const AEDesc *theAEDesc) {
+  return theAEDesc ? static_cast<Size>(Engine::FlattenedSize(*theAEDesc)) : 0;
+}
+
+OSStatus AEFlattenDesc(const AEDesc *theAEDesc, void *buffer, Size bufferSize,
+                       Size *actualSize) {
+  if (!theAEDesc || bufferSize < 0) {
+    return paramErr;
+  }
+  size_t written = 0;
+  Engine::Status status = Engine::Flatten(
+      *theAEDesc, buffer, static_cast<size_t>(bufferSize), &written);
+  if (actualSize) {
+    *actualSize = static_cast<Size>(written);
+  }
+  return status;
+}
+
+// Like the original, this trusts the buffer to be as long as its header says.
+OSStatus AEUnflattenDesc(const void *buffer, AEDesc *result) {
+  if (!buffer || !result) {
+    return paramErr;
+  }
+  size_t size = 0;
+  Engine::Status status = Engine::FlattenedSizeFromHeader(buffer, &size);
+  if (status != noErr) {
+    AEInitializeDesc(result);
+    return status;
+  }
+  return Engine::Unflatten(buffer, size, result);
+}
+
+AEStreamRef AEStreamOpen() { return Engine::OpenStream(); }
+
+OSStatus AEStreamClose(AEStreamRef ref, AEDesc *desc) {
+  return Engine::CloseStream(ref, desc);
+}
+
+OSStatus AEStreamOpenList(AEStreamRef ref) {
+  return ref ? Engine::StreamOpenList(ref) : paramErr;
+}
+
+OSStatus AEStreamCloseList(AEStreamRef ref) {
+  return ref ? Engine::StreamCloseList(ref) : paramErr;
+}
+
+OSStatus AEStreamOpenRecord(AEStreamRef ref, DescType newType) {
+  return ref ? Engine::StreamOpenRecord(ref, newType) : paramErr;
+}
+
+OSStatus AEStreamCloseRecord(AEStreamRef ref) {
+  return ref ? Engine::StreamCloseRecord(ref) : paramErr;
+}
+
+OSStatus AEStreamWriteKey(AEStreamRef ref, AEKeyword key) {
+  return ref ? Engine::StreamWriteKey(ref, key) : paramErr;
+}
+
+OSStatus AEStreamWriteDesc(AEStreamRef ref, DescType newType, const void *data,
+                           Size length) {
+  if (!ref || length < 0) {
+    return paramErr;
+  }
+  return Engine::StreamWriteData(ref, newType, data,
+                                 static_cast<size_t>(length));
+}
+
+OSStatus AEStreamWriteAEDesc(AEStreamRef ref, const AEDesc *desc) {
+  if (!ref || !desc) {
+    return paramErr;
+  }
+  return Engine::StreamWriteDesc(ref, *desc);
+}
+
+OSStatus AESendMessage(const AppleEvent *event, AppleEvent *reply,
+                       AESendMode sendMode, long timeOutInTicks) {
+  if (!event || event->descriptorType != typeAppleEvent) {
+    return errAENotAppleEvent;
+  }
+  if (reply) {
+    AEInitializeDesc(reply);
+  }
+
+  const std::chrono::microseconds latency{
+      simulatedLatency.load(std::memory_order_relaxed)};
+  const OSErr result = simulatedResult.load(std::memory_order_relaxed);
+  const AESendMode replyMode = sendMode & kAEWaitReply;
+  if (replyMode == kAEQueueReply && result == noErr) {
+    ScheduleAnswer(event, latency);
+  }
+  if (replyMode != kAEWaitReply) {
+    // Nothing to wait for: the event is only handed over.
+    return result;
+  }
+
+  // The AE Manager's default timeout is about a minute.
+  const long ticks = timeOutInTicks == kAEDefaultTimeout ? 3600
+                                                         : timeOutInTicks;
+  if (ticks != kNoTimeOut) {
+    const std::chrono::microseconds timeout{
+        static_cast<int64_t>(ticks) * 1000000 / 60};
+    if (latency > timeout) {
+      std::this_thread::sleep_for(timeout);
+      return errAETimeout;
+    }
+  }
+  std::this_thread::sleep_for(latency);
+  if (result != noErr || !reply) {
+    return result;
+  }
+
+  return MakeAnswer(ReturnIDOf(event), reply);
+}
+
+void AEPortableSimulateSends(std::chrono::microseconds latency, OSErr result) {
+  simulatedLatency.store(std::max<int64_t>(0, latency.count()),
+                         std::memory_order_relaxed);
+  simulatedResult.store(result, std::memory_order_relaxed);
+}
+
+AEEventHandlerUPP NewAEEventHandlerUPP(AEEventHandlerProcPtr userRoutine) {
+  return userRoutine;
+}
+
+void DisposeAEEventHandlerUPP(AEEventHandlerUPP) {}
+
+OSErr AEInstallEventHandler(AEEventClass theAEEventClass,
+                            AEEventID theAEEventID,
+                            AEEventHandlerUPP handler, SRefCon handlerRefcon,
+                            Boolean) {
+  if (!handler) {
+    return paramErr;
+  }
+  std::lock_guard<std::mutex> lock(handlersMutex);
+  handlers[{theAEEventClass, theAEEventID}] = {handler, handlerRefcon};
+  return noErr;
+}
+
+OSErr AERemoveEventHandler(AEEventClass theAEEventClass,
+                           AEEventID theAEEventID, AEEventHandlerUPP handler,
+                           Boolean) {
+  std::lock_guard<std::mutex> lock(handlersMutex);
+  auto it = handlers.find({theAEEventClass, theAEEventID});
+  if (it == handlers.end() || (handler && it->second.handler != handler)) {
+    return errAEHandlerNotFound;
+  }
+  handlers.erase(it);
+  return noErr;
+}
+
+// Only simulated `aevt/ansr` replies are ever dispatched to the installed
+//  handlers, and nothing needs to suspend those, so there is never a current
+//  event to suspend or resume.
+OSErr AESuspendTheCurrentEvent(const AppleEvent *) { return noErr; }
+
+OSErr AEResumeTheCurrentEvent(const AppleEvent *, const AppleEvent *,
+                              AEEventHandlerUPP, SRefCon) {
+  return noErr;
+}
+
+const char *GetMacOSStatusErrorString(OSStatus err) {
+  switch (err) {
+  case noErr:
+    return "noErr";
+  case paramErr:
+    return "paramErr";
+  case memFullErr:
+    return "memFullErr";
+  case procNotFound:
+    return "procNotFound";
+  case errAECoercionFail:
+    return "errAECoercionFail";
+  case errAEDescNotFound:
+    return "errAEDescNotFound";
+  case errAECorruptData:
+    return "errAECorruptData";
+  case errAEWrongDataType:
+    return "errAEWrongDataType";
+  case errAENotAEDesc:
+    return "errAENotAEDesc";
+  case errAEBadListItem:
+    return "errAEBadListItem";
+  case errAENotAppleEvent:
+    return "errAENotAppleEvent";
+  case errAEEventNotHandled:
+    return "errAEEventNotHandled";
+  case errAEReplyNotValid:
+    return "errAEReplyNotValid";
+  case errAEUnknownSendMode:
+    return "errAEUnknownSendMode";
+  case errAEWaitCanceled:
+    return "errAEWaitCanceled";
+  case errAETimeout:
+    return "errAETimeout";
+  case errAEHandlerNotFound:
+    return "errAEHandlerNotFound";
+  case errAEIllegalIndex:
+    return "errAEIllegalIndex";
+  case errAEStreamBadNesting:
+    return "errAEStreamBadNesting";
+  case errAEStreamAlreadyConverted:
+    return "errAEStreamAlreadyConverted";
+  case errAEBufferTooSmall:
+    return "errAEBufferTooSmall";
+  case errOSAGeneralError:
+    return "errOSAGeneralError";
+  default:
+    return "";
+  }
+}
+
+const char *GetMacOSStatusCommentString(OSStatus) { return ""; }
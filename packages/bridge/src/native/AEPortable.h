@@ -0,0 +1,333 @@
+#pragma once
+
+// The subset of the Apple Event Manager API the bridge uses, implemented on
+//  top of the portable descriptor engine. Names, types and error codes match
+//  CoreServices, so the bridge compiles unchanged against either. These have
+//  C++ linkage, so they never collide with the real CoreServices symbols.
+
+#include "DescriptorEngine.h"
+
+#include <chrono>
+#include <cstdint>
+
+typedef int16_t OSErr;
+typedef int32_t OSStatus;
+typedef unsigned char Boolean;
+typedef int8_t SInt8;
+typedef uint8_t UInt8;
+typedef int16_t SInt16;
+typedef uint16_t UInt16;
+typedef int32_t SInt32;
+typedef uint32_t UInt32;
+typedef int64_t SInt64;
+typedef uint64_t UInt64;
+typedef long Size;
+typedef void *SRefCon;
+typedef uint32_t FourCharCode;
+typedef FourCharCode OSType;
+
+typedef FourCharCode DescType;
+typedef FourCharCode AEKeyword;
+typedef FourCharCode AEEventClass;
+typedef FourCharCode AEEventID;
+typedef SInt16 AEReturnID;
+typedef SInt32 AETransactionID;
+typedef SInt32 AESendMode;
+
+typedef ae_js_bridge::DescriptorEngine::Descriptor AEDesc;
+typedef AEDesc AEDescList;
+typedef AEDescList AERecord;
+typedef AEDesc AEAddressDesc;
+typedef AERecord AppleEvent;
+
+typedef ae_js_bridge::DescriptorEngine::Stream *AEStreamRef;
+
+typedef OSErr (*AEEventHandlerProcPtr)(const AppleEvent *theAppleEvent,
+                                       AppleEvent *reply, SRefCon handlerRefcon);
+typedef AEEventHandlerProcPtr AEEventHandlerUPP;
+
+inline constexpr OSErr noErr = 0;
+inline constexpr OSErr paramErr = ae_js_bridge::DescriptorEngine::Errors::ParamErr;
+inline constexpr OSErr memFullErr =
+    ae_js_bridge::DescriptorEngine::Errors::MemFullErr;
+inline constexpr OSErr procNotFound = -600;
+inline constexpr OSErr errAECoercionFail =
+    ae_js_bridge::DescriptorEngine::Errors::CoercionFail;
+inline constexpr OSErr errAEDescNotFound =
+    ae_js_bridge::DescriptorEngine::Errors::DescNotFound;
+inline constexpr OSErr errAECorruptData =
+    ae_js_bridge::DescriptorEngine::Errors::CorruptData;
+inline constexpr OSErr errAEWrongDataType =
+    ae_js_bridge::DescriptorEngine::Errors::WrongDataType;
+inline constexpr OSErr errAENotAEDesc =
+    ae_js_bridge::DescriptorEngine::Errors::NotAEDesc;
+inline constexpr OSErr errAEBadListItem =
+    ae_js_bridge::DescriptorEngine::Errors::BadListItem;
+inline constexpr OSErr errAENotAppleEvent =
+    ae_js_bridge::DescriptorEngine::Errors::NotAppleEvent;
+inline constexpr OSErr errAEEventNotHandled = -1708;
+inline constexpr OSErr errAEReplyNotValid = -1709;
+inline constexpr OSErr errAEUnknownSendMode = -1710;
+inline constexpr OSErr errAEWaitCanceled = -1711;
+inline constexpr OSErr errAETimeout = -1712;
+inline constexpr OSErr errAEHandlerNotFound = -1717;
+inline constexpr OSErr errAEIllegalIndex =
+    ae_js_bridge::DescriptorEngine::Errors::IllegalIndex;
+inline constexpr OSErr errAEStreamBadNesting =
+    ae_js_bridge::DescriptorEngine::Errors::StreamBadNesting;
+inline constexpr OSErr errAEStreamAlreadyConverted =
+    ae_js_bridge::DescriptorEngine::Errors::StreamAlreadyConverted;
+inline constexpr OSErr errAEBufferTooSmall =
+    ae_js_bridge::DescriptorEngine::Errors::BufferTooSmall;
+inline constexpr OSErr errOSAGeneralError = -2700;
+
+inline constexpr DescType typeNull = ae_js_bridge::DescriptorEngine::Types::Null;
+inline constexpr DescType typeWildCard =
+    ae_js_bridge::DescriptorEngine::Types::WildCard;
+inline constexpr DescType typeAEList =
+    ae_js_bridge::DescriptorEngine::Types::List;
+inline constexpr DescType typeAERecord =
+    ae_js_bridge::DescriptorEngine::Types::Record;
+inline constexpr DescType typeAppleEvent =
+    ae_js_bridge::DescriptorEngine::Types::AppleEvent;
+inline constexpr DescType typeSInt16 =
+    ae_js_bridge::DescriptorEngine::Types::SInt16;
+inline constexpr DescType typeSInt32 =
+    ae_js_bridge::DescriptorEngine::Types::SInt32;
+inline constexpr DescType typeSInt64 =
+    ae_js_bridge::DescriptorEngine::Types::SInt64;
+inline constexpr DescType typeUInt16 =
+    ae_js_bridge::DescriptorEngine::Types::UInt16;
+inline constexpr DescType typeUInt32 =
+    ae_js_bridge::DescriptorEngine::Types::UInt32;
+inline constexpr DescType typeUInt64 =
+    ae_js_bridge::DescriptorEngine::Types::UInt64;
+inline constexpr DescType typeIEEE32BitFloatingPoint =
+    ae_js_bridge::DescriptorEngine::Types::Float32;
+inline constexpr DescType typeIEEE64BitFloatingPoint =
+    ae_js_bridge::DescriptorEngine::Types::Float64;
+inline constexpr DescType typeBoolean =
+    ae_js_bridge::DescriptorEngine::Types::Boolean;
+inline constexpr DescType typeTrue = ae_js_bridge::DescriptorEngine::Types::True;
+inline constexpr DescType typeFalse =
+    ae_js_bridge::DescriptorEngine::Types::False;
+inline constexpr DescType typeChar = ae_js_bridge::DescriptorEngine::Types::Char;
+inline constexpr DescType typeUTF8Text =
+    ae_js_bridge::DescriptorEngine::Types::UTF8Text;
+inline constexpr DescType typeUnicodeText =
+    ae_js_bridge::DescriptorEngine::Types::UnicodeText;
+inline constexpr DescType typeType = ae_js_bridge::DescriptorEngine::Types::Type;
+inline constexpr DescType typeEnumerated =
+    ae_js_bridge::DescriptorEngine::Types::Enumerated;
+inline constexpr DescType typeKeyword =
+    ae_js_bridge::DescriptorEngine::Types::Keyword;
+inline constexpr DescType typeProperty =
+    ae_js_bridge::DescriptorEngine::Types::Property;
+inline constexpr DescType type128BitFloatingPoint =
+    ae_js_bridge::DescriptorEngine::MakeCode("ldbl");
+inline constexpr DescType typeDecimalStruct =
+    ae_js_bridge::DescriptorEngine::MakeCode("decm");
+inline constexpr DescType typeUTF16ExternalRepresentation =
+    ae_js_bridge::DescriptorEngine::MakeCode("ut16");
+inline constexpr DescType typeAbsoluteOrdinal =
+    ae_js_bridge::DescriptorEngine::MakeCode("abso");
+inline constexpr DescType typeLongDateTime =
+    ae_js_bridge::DescriptorEngine::MakeCode("ldt ");
+inline constexpr DescType typeData =
+    ae_js_bridge::DescriptorEngine::MakeCode("tdta");
+inline constexpr DescType typeFileURL =
+    ae_js_bridge::DescriptorEngine::MakeCode("furl");
+inline constexpr DescType typeFSRef =
+    ae_js_bridge::DescriptorEngine::MakeCode("fsrf");
+inline constexpr DescType typeAlias =
+    ae_js_bridge::DescriptorEngine::MakeCode("alis");
+inline constexpr DescType typeBookmarkData =
+    ae_js_bridge::DescriptorEngine::MakeCode("bmrk");
+inline constexpr DescType typeApplicationBundleID =
+    ae_js_bridge::DescriptorEngine::MakeCode("bund");
+inline constexpr DescType typeApplicationURL =
+    ae_js_bridge::DescriptorEngine::MakeCode("aprl");
+inline constexpr DescType typeKernelProcessID =
+    ae_js_bridge::DescriptorEngine::MakeCode("kpid");
+inline constexpr DescType typeProcessSerialNumber =
+    ae_js_bridge::DescriptorEngine::MakeCode("psn ");
+inline constexpr DescType typeObjectSpecifier =
+    ae_js_bridge::DescriptorEngine::MakeCode("obj ");
+inline constexpr DescType typeInsertionLoc =
+    ae_js_bridge::DescriptorEngine::MakeCode("insl");
+inline constexpr DescType typeRangeDescriptor =
+    ae_js_bridge::DescriptorEngine::MakeCode("rang");
+inline constexpr DescType typeCompDescriptor =
+    ae_js_bridge::DescriptorEngine::MakeCode("cmpd");
+inline constexpr DescType typeLogicalDescriptor =
+    ae_js_bridge::DescriptorEngine::MakeCode("logi");
+inline constexpr DescType typeWhoseDescriptor =
+    ae_js_bridge::DescriptorEngine::MakeCode("whos");
+
+inline constexpr AEKeyword keyEventClassAttr =
+    ae_js_bridge::DescriptorEngine::Keywords::EventClassAttr;
+inline constexpr AEKeyword keyEventIDAttr =
+    ae_js_bridge::DescriptorEngine::Keywords::EventIDAttr;
+inline constexpr AEKeyword keyAddressAttr =
+    ae_js_bridge::DescriptorEngine::Keywords::AddressAttr;
+inline constexpr AEKeyword keyReturnIDAttr =
+    ae_js_bridge::DescriptorEngine::Keywords::ReturnIDAttr;
+inline constexpr AEKeyword keyTransactionIDAttr =
+    ae_js_bridge::DescriptorEngine::Keywords::TransactionIDAttr;
+inline constexpr AEKeyword keyTimeoutAttr =
+    ae_js_bridge::DescriptorEngine::MakeCode("timo");
+inline constexpr AEKeyword keySenderPIDAttr =
+    ae_js_bridge::DescriptorEngine::MakeCode("spid");
+inline constexpr AEKeyword keyDirectObject =
+    ae_js_bridge::DescriptorEngine::MakeCode("----");
+inline constexpr AEKeyword keyErrorNumber =
+    ae_js_bridge::DescriptorEngine::MakeCode("errn");
+inline constexpr AEKeyword keyErrorString =
+    ae_js_bridge::DescriptorEngine::MakeCode("errs");
+inline constexpr AEKeyword kOSAErrorNumber = keyErrorNumber;
+inline constexpr AEKeyword kOSAErrorMessage = keyErrorString;
+
+inline constexpr AESendMode kAENoReply = 0x00000001;
+inline constexpr AESendMode kAEQueueReply = 0x00000002;
+inline constexpr AESendMode kAEWaitReply = 0x00000003;
+inline constexpr AESendMode kAENeverInteract = 0x00000010;
+inline constexpr AESendMode kAECanInteract = 0x00000020;
+inline constexpr AESendMode kAEAlwaysInteract = 0x00000030;
+inline constexpr AESendMode kAECanSwitchLayer = 0x00000040;
+inline constexpr AESendMode kAEDontRecord = 0x00001000;
+
+inline constexpr long kAEDefaultTimeout = -1;
+inline constexpr long kNoTimeOut = -2;
+inline constexpr AEReturnID kAutoGenerateReturnID =
+    ae_js_bridge::DescriptorEngine::AutoGenerateReturnID;
+inline constexpr AETransactionID kAnyTransactionID = 0;
+inline constexpr long kAENoDispatch = 0;
+inline constexpr AEEventClass kCoreEventClass =
+    ae_js_bridge::DescriptorEngine::MakeCode("aevt");
+inline constexpr AEEventID kAEAnswer =
+    ae_js_bridge::DescriptorEngine::MakeCode("ansr");
+
+void AEInitializeDesc(AEDesc *desc);
+OSErr AECreateDesc(DescType typeCode, const void *dataPtr, Size dataSize,
+                   AEDesc *result);
+OSErr AEDisposeDesc(AEDesc *theAEDesc);
+OSErr AEDuplicateDesc(const AEDesc *theAEDesc, AEDesc *result);
+OSErr AEReplaceDescData(DescType typeCode, const void *dataPtr, Size dataSize,
+                        AEDesc *theAEDesc);
+Size AEGetDescDataSize(const AEDesc *theAEDesc);
+OSErr AEGetDescData(const AEDesc *theAEDesc, void *dataPtr, Size maximumSize);
+OSErr AEGetDescDataRange(const AEDesc *dataDesc, void *buffer, Size offset,
+                         Size length);
+OSErr AECoerceDesc(const AEDesc *theAEDesc, DescType toType, AEDesc *result);
+OSErr AECoercePtr(DescType typeCode, const void *dataPtr, Size dataSize,
+                  DescType toType, AEDesc *result);
+
+OSErr AECreateList(const void *factoringPtr, Size factoredSize,
+                   Boolean isRecord, AEDescList *resultList);
+Boolean AECheckIsRecord(const AEDesc *theDesc);
+OSErr AECountItems(const AEDescList *theAEDescList, long *theCount);
+OSErr AEGetNthDesc(const AEDescList *theAEDescList, long index,
+                   DescType desiredType, AEKeyword *theAEKeyword,
+                   AEDesc *result);
+OSErr AEGetNthPtr(const AEDescList *theAEDescList, long index,
+                  DescType desiredType, AEKeyword *theAEKeyword,
+                  DescType *typeCode, void *dataPtr, Size maximumSize,
+                  Size *actualSize);
+OSErr AESizeOfNthItem(const AEDescList *theAEDescList, long index,
+                      DescType *typeCode, Size *dataSize);
+OSErr AEPutDesc(AEDescList *theAEDescList, long index, const AEDesc *theAEDesc);
+OSErr AEPutPtr(AEDescList *theAEDescList, long index, DescType typeCode,
+               const void *dataPtr, Size dataSize);
+OSErr AEDeleteItem(AEDescList *theAEDescList, long index);
+
+OSErr AEPutKeyDesc(AERecord *theAERecord, AEKeyword theAEKeyword,
+                   const AEDesc *theAEDesc);
+OSErr AEGetKeyDesc(const AERecord *theAERecord, AEKeyword theAEKeyword,
+                   DescType desiredType, AEDesc *result);
+OSErr AEGetKeyPtr(const AERecord *theAERecord, AEKeyword theAEKeyword,
+                  DescType desiredType, DescType *typeCode, void *dataPtr,
+                  Size maximumSize, Size *actualSize);
+OSErr AESizeOfKeyDesc(const AERecord *theAERecord, AEKeyword theAEKeyword,
+                      DescType *typeCode, Size *dataSize);
+OSErr AEDeleteKeyDesc(AERecord *theAERecord, AEKeyword theAEKeyword);
+
+OSErr AECreateAppleEvent(AEEventClass theAEEventClass, AEEventID theAEEventID,
+                         const AEAddressDesc *target, AEReturnID returnID,
+                         AETransactionID transactionID, AppleEvent *result);
+OSErr AEPutParamDesc(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                     const AEDesc *theAEDesc);
+OSErr AEPutParamPtr(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                    DescType typeCode, const void *dataPtr, Size dataSize);
+OSErr AEGetParamDesc(const AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                     DescType desiredType, AEDesc *result);
+OSErr AEGetParamPtr(const AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                    DescType desiredType, DescType *actualType, void *dataPtr,
+                    Size maximumSize, Size *actualSize);
+OSErr AESizeOfParam(const AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                    DescType *typeCode, Size *dataSize);
+OSErr AEDeleteParam(AppleEvent *theAppleEvent, AEKeyword theAEKeyword);
+OSErr AEPutAttributeDesc(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                         const AEDesc *theAEDesc);
+OSErr AEPutAttributePtr(AppleEvent *theAppleEvent, AEKeyword theAEKeyword,
+                        DescType typeCode, const void *dataPtr, Size dataSize);
+OSErr AEGetAttributeDesc(const AppleEvent *theAppleEvent,
+                         AEKeyword theAEKeyword, DescType desiredType,
+                         AEDesc *result);
+OSErr AEGetAttributePtr(const AppleEvent *theAppleEvent,
+                        AEKeyword theAEKeyword, DescType desiredType,
+                        DescType *typeCode, void *dataPtr, Size maximumSize,
+                        Size *actualSize);
+OSErr AESizeOfAttribute(const AppleEvent *theAppleEvent,
+                        AEKeyword theAEKeyword, DescType *typeCode,
+                        Size *dataSize);
+
+// The flattened form is the engine's own (see `DescriptorEngine::Flatten`),
+//  not CoreServices'.
+Size AESizeOfFlattenedDesc(const AEDesc *theAEDesc);
+OSStatus AEFlattenDesc(const AEDesc *theAEDesc, void *buffer, Size bufferSize,
+                       Size *actualSize);
+OSStatus AEUnflattenDesc(const void *buffer, AEDesc *result);
+
+AEStreamRef AEStreamOpen();
+OSStatus AEStreamClose(AEStreamRef ref, AEDesc *desc);
+OSStatus AEStreamOpenList(AEStreamRef ref);
+OSStatus AEStreamCloseList(AEStreamRef ref);
+OSStatus AEStreamOpenRecord(AEStreamRef ref, DescType newType);
+OSStatus AEStreamCloseRecord(AEStreamRef ref);
+OSStatus AEStreamWriteKey(AEStreamRef ref, AEKeyword key);
+OSStatus AEStreamWriteDesc(AEStreamRef ref, DescType newType, const void *data,
+                           Size length);
+OSStatus AEStreamWriteAEDesc(AEStreamRef ref, const AEDesc *desc);
+
+// There are no other processes to address without the real Apple Event
+//  Manager, so sending only stands in for a round trip, as set up by
+//  `AEPortableSimulateSends`: by default it fails with `procNotFound` at once.
+OSStatus AESendMessage(const AppleEvent *event, AppleEvent *reply,
+                       AESendMode sendMode, long timeOutInTicks);
+
+// Not part of the Apple Event Manager. Makes every later `AESendMessage` take
+//  `latency` and then fail with `result`, or, when `result` is `noErr`,
+//  succeed with an empty `aevt/ansr` reply carrying the event's return ID. A
+//  latency past the send's timeout fails with `errAETimeout` once the timeout
+//  has passed. With `kAEQueueReply`, the send returns at once, and the reply
+//  is dispatched to the installed `aevt/ansr` handler, on a thread of its
+//  own, once `latency` has passed. Lets sending be load-tested without a
+//  target to send to.
+void AEPortableSimulateSends(std::chrono::microseconds latency, OSErr result);
+
+AEEventHandlerUPP NewAEEventHandlerUPP(AEEventHandlerProcPtr userRoutine);
+void DisposeAEEventHandlerUPP(AEEventHandlerUPP userUPP);
+OSErr AEInstallEventHandler(AEEventClass theAEEventClass,
+                            AEEventID theAEEventID,
+                            AEEventHandlerUPP handler, SRefCon handlerRefcon,
+                            Boolean isSysHandler);
+OSErr AERemoveEventHandler(AEEventClass theAEEventClass,
+                           AEEventID theAEEventID, AEEventHandlerUPP handler,
+                           Boolean isSysHandler);
+OSErr AESuspendTheCurrentEvent(const AppleEvent *theAppleEvent);
+OSErr AEResumeTheCurrentEvent(const AppleEvent *theAppleEvent,
+                              const AppleEvent *reply,
+                              AEEventHandlerUPP dispatcher, SRefCon handlerRefcon);
+
+const char *GetMacOSStatusErrorString(OSStatus err);
+const char *GetMacOSStatusCommentString(OSStatus err);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AEPlatform.h"
+#include "helpers.h"
+
+#include <napi.h>
+
+#include <sys/types.h>
+
+#include <string>
+
+namespace ae_js_bridge {
+// An application events are sent to, with its address descriptor built once
+//  and kept, so that creating an event doesn't mean building (and unwrapping)
+//  a target descriptor first.
+//
+// A bundle ID is resolved to the process running it, when there is one, and
+//  addressed by process ID; the Apple Event Manager then doesn't have to look
+//  the application up again on every send, and the target can tell whether
+//  that process is still alive. Once it isn't (a send fails with
+//  `procNotFound`), `resolve()` looks the bundle ID up again.
+class AETarget : public Napi::ObjectWrap<AETarget> {
+public:
+  static constexpr const char *JSClassName = "AETarget";
+
+  // `new AETarget({ bundleID } | { pid } | { url })`.
+  explicit AETarget(const Napi::CallbackInfo &info);
+
+  static void Init(Napi::Env env, Napi::Object exports);
+
+private:
+  enum class Addressing { BundleID, ProcessID, URL };
+
+  Napi::Value GetAddressOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value GetPIDOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value IsAliveOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value ResolveOrThrow(const Napi::CallbackInfo &info);
+  Napi::Value CreateEventOrThrow(const Napi::CallbackInfo &info);
+
+  // (Re)builds `address`. Only bundle IDs have anything to look up; the
+  //  others are built once, by the constructor.
+  bool ResolveAddressOrThrow(Napi::Env env);
+  // `true` or `false`, or `null` where it can't be told without sending.
+  Napi::Value Liveness(Napi::Env env) const;
+
+  Addressing addressing = Addressing::ProcessID;
+  // The bundle ID or URL the target was created with.
+  std::string name;
+  // The process the target is addressed to, or 0 if it isn't addressed by
+  //  process ID.
+  pid_t pid = 0;
+  SharedAEDesc address;
+};
+} // namespace ae_js_bridge
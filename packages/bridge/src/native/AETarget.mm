@@ -0,0 +1,232 @@
+#include "AETarget.h"
+
+#include "AEDescriptor.h"
+#include "DescriptorKind.h"
+#include "OSError.h"
+#include "RunningApplications.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace ae_js_bridge {
+namespace {
+const char *const kUsage = "AETarget takes ({ bundleID: string } | "
+                           "{ pid: number } | { url: string })";
+
+bool CreateAddressOrThrow(Napi::Env env, DescType type, const void *data,
+                          size_t size, SharedAEDesc *outAddress) {
+  auto *address = new AEDesc;
+  OSErr err = AECreateDesc(type, data, static_cast<Size>(size), address);
+  if (err != noErr) {
+    delete address;
+    OSError::Throw(env, err, "AECreateDesc failed");
+    return false;
+  }
+  *outAddress = AdoptAEDesc(address);
+  return true;
+}
+
+// Reads an optional `parameters`/`attributes` argument.
+bool ReadKeywordMapOrThrow(Napi::Env env, const Napi::Value &value,
+                           const char *name, Napi::Object *outMap) {
+  if (value.IsUndefined()) {
+    *outMap = Napi::Object::New(env);
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, std::string(name) + " must be an object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  *outMap = value.As<Napi::Object>();
+  return true;
+}
+} // namespace
+
+AETarget::AETarget(const Napi::CallbackInfo &info)
+    : Napi::ObjectWrap<AETarget>(info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, kUsage).ThrowAsJavaScriptException();
+    return;
+  }
+  Napi::Object spec = info[0].As<Napi::Object>();
+  Napi::Value bundleID = spec.Get("bundleID");
+  Napi::Value pidValue = spec.Get("pid");
+  Napi::Value url = spec.Get("url");
+  const int given = !bundleID.IsUndefined() + !pidValue.IsUndefined() +
+                    !url.IsUndefined();
+  if (given != 1) {
+    Napi::TypeError::New(env, kUsage).ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (!pidValue.IsUndefined()) {
+    const double number =
+        pidValue.IsNumber() ? pidValue.As<Napi::Number>().DoubleValue() : 0;
+    if (!(number >= 1) || number != std::floor(number) ||
+        number > std::numeric_limits<pid_t>::max()) {
+      Napi::TypeError::New(env, "pid must be a positive integer")
+          .ThrowAsJavaScriptException();
+      return;
+    }
+    addressing = Addressing::ProcessID;
+    pid = static_cast<pid_t>(number);
+    CreateAddressOrThrow(env, typeKernelProcessID, &pid, sizeof(pid),
+                         &address);
+    return;
+  }
+
+  const Napi::Value &nameValue = bundleID.IsUndefined() ? url : bundleID;
+  if (!nameValue.IsString() ||
+      nameValue.As<Napi::String>().Utf8Value().empty()) {
+    Napi::TypeError::New(env, bundleID.IsUndefined()
+                                  ? "url must be a non-empty string"
+                                  : "bundleID must be a non-empty string")
+        .ThrowAsJavaScriptException();
+    return;
+  }
+  name = nameValue.As<Napi::String>().Utf8Value();
+  if (bundleID.IsUndefined()) {
+    addressing = Addressing::URL;
+    CreateAddressOrThrow(env, typeApplicationURL, name.data(), name.size(),
+                         &address);
+    return;
+  }
+  addressing = Addressing::BundleID;
+  ResolveAddressOrThrow(env);
+}
+
+bool AETarget::ResolveAddressOrThrow(Napi::Env env) {
+  if (addressing != Addressing::BundleID) {
+    return true;
+  }
+  const pid_t found = RunningApplications::FindProcessForBundleID(name);
+  if (address && found == pid) {
+    return true;
+  }
+  // Not running: left to the Apple Event Manager, which fails the send with
+  //  `procNotFound` until it is.
+  SharedAEDesc resolved;
+  const bool created =
+      found != 0
+          ? CreateAddressOrThrow(env, typeKernelProcessID, &found,
+                                 sizeof(found), &resolved)
+          : CreateAddressOrThrow(env, typeApplicationBundleID, name.data(),
+                                 name.size(), &resolved);
+  if (!created) {
+    return false;
+  }
+  // Events created so far keep the old address; only new ones get this.
+  address = resolved;
+  pid = found;
+  return true;
+}
+
+Napi::Value AETarget::Liveness(Napi::Env env) const {
+  switch (addressing) {
+  case Addressing::ProcessID:
+    return Napi::Boolean::New(env,
+                              RunningApplications::IsProcessRunning(pid, ""));
+  case Addressing::BundleID:
+    return Napi::Boolean::New(
+        env, pid != 0
+                 ? RunningApplications::IsProcessRunning(pid, name)
+                 : RunningApplications::FindProcessForBundleID(name) != 0);
+  case Addressing::URL:
+    break;
+  }
+  return env.Null();
+}
+
+Napi::Value AETarget::GetAddressOrThrow(const Napi::CallbackInfo &info) {
+  // Shared with the target, not copied: descriptors never change once
+  //  wrapped, and `resolve()` replaces the address rather than changing it.
+  return Descriptors::WrapSharedAEDescOrThrow(info.Env(), address);
+}
+
+Napi::Value AETarget::GetPIDOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (pid == 0) {
+    return env.Null();
+  }
+  return Napi::Number::New(env, pid);
+}
+
+Napi::Value AETarget::IsAliveOrThrow(const Napi::CallbackInfo &info) {
+  return Liveness(info.Env());
+}
+
+Napi::Value AETarget::ResolveOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (!ResolveAddressOrThrow(env)) {
+    return env.Null();
+  }
+  return Liveness(env);
+}
+
+Napi::Value AETarget::CreateEventOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 2 || !IsFourCharCodeValue(info[0]) ||
+      !IsFourCharCodeValue(info[1]) ||
+      (!info[4].IsUndefined() && !info[4].IsNumber()) ||
+      (!info[5].IsUndefined() && !info[5].IsNumber())) {
+    Napi::TypeError::New(env, "createEvent takes (eventClass, eventID, "
+                              "parameters?, attributes?, returnID?, "
+                              "transactionID?)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  FourCharCode eventClass = JSValueToFourCharCode(info[0]);
+  if (eventClass == 0) {
+    Napi::Error::New(env, "Invalid event class").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  FourCharCode eventID = JSValueToFourCharCode(info[1]);
+  if (eventID == 0) {
+    Napi::Error::New(env, "Invalid event ID").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Object parameters;
+  Napi::Object attributes;
+  if (!ReadKeywordMapOrThrow(env, info[2], "parameters", &parameters) ||
+      !ReadKeywordMapOrThrow(env, info[3], "attributes", &attributes)) {
+    return env.Null();
+  }
+  AEReturnID returnID = kAutoGenerateReturnID;
+  if (!info[4].IsUndefined() &&
+      !Descriptors::ReturnIDFromJSOrThrow(info[4], &returnID)) {
+    return env.Null();
+  }
+  AETransactionID transactionID = kAnyTransactionID;
+  if (!info[5].IsUndefined() &&
+      !Descriptors::TransactionIDFromJSOrThrow(info[5], &transactionID)) {
+    return env.Null();
+  }
+
+  AEDesc *event = nullptr;
+  if (!Descriptors::CreateAppleEventOrThrow(
+          env, eventClass, eventID, address.get(), returnID, transactionID,
+          parameters, attributes, &event)) {
+    return env.Null();
+  }
+  return Descriptors::WrapSharedAEDescOrThrow(
+      env, AdoptAEDesc(event), Descriptors::DescriptorKind::Event);
+}
+
+void AETarget::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function ctor = DefineClass(
+      env, JSClassName,
+      {
+          InstanceAccessor("address", &AETarget::GetAddressOrThrow, nullptr),
+          InstanceAccessor("pid", &AETarget::GetPIDOrThrow, nullptr),
+          InstanceMethod("isAlive", &AETarget::IsAliveOrThrow),
+          InstanceMethod("resolve", &AETarget::ResolveOrThrow),
+          InstanceMethod("createEvent", &AETarget::CreateEventOrThrow),
+      });
+  exports.Set(JSClassName, ctor);
+}
+} // namespace ae_js_bridge
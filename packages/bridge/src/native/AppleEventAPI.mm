@@ -1,49 +1,434 @@
 #include "AppleEventAPI.h"
 
 #include "AEDescriptor.h"
+#include "AEPlatform.h"
+#include "DescriptorHash.h"
+#include "InFlightTable.h"
 #include "OSError.h"
+#include "SendExecutor.h"
+#include "ValueConversion.h"
 
+#if !defined(AEJS_USE_PORTABLE_ENGINE)
 #include <Carbon/Carbon.h>
-#include <CoreServices/CoreServices.h>
+#endif
 #include <napi.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace ae_js_bridge {
 
 namespace AppleEventAPI {
 namespace Sending {
-class SendAppleEventWorker : public Napi::AsyncWorker {
+struct SendOptions {
+  // Whether the reply's parameters are decoded on the worker thread and
+  //  resolved as plain values instead of a reply wrapper.
+  bool decodeReply = false;
+  ValueConversion::ToJSValueOptions replyOptions;
+  // Ticks (1/60 s) to wait for a reply, or `kAEDefaultTimeout`/`kNoTimeOut`.
+  long timeoutTicks = kAEDefaultTimeout;
+  // Interaction and recording flags, combined with the reply mode when sent.
+  AESendMode modeFlags = 0;
+  // The caller's `AbortSignal`, if any.
+  Napi::Value signal;
+  // Whether to send with `kAEQueueReply` and wait for the reply without a
+  //  thread (see `QueuedReplies`).
+  bool queueReply = false;
+};
+
+bool ReadTimeoutOrThrow(Napi::Env env, const Napi::Value &value,
+                        long *outTicks) {
+  const double milliseconds =
+      value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : -1;
+  if (!(milliseconds >= 0)) {
+    Napi::TypeError::New(env, "timeoutMs must be a non-negative number")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  if (std::isinf(milliseconds)) {
+    *outTicks = kNoTimeOut;
+    return true;
+  }
+  // Rounded up, so that a short timeout still waits at least one tick rather
+  //  than giving up before the event is even delivered.
+  const double ticks = std::ceil(milliseconds * 60 / 1000);
+  *outTicks = static_cast<long>(
+      std::clamp(ticks, 1.0,
+                 static_cast<double>(std::numeric_limits<int32_t>::max())));
+  return true;
+}
+
+bool ReadModeOrThrow(Napi::Env env, const Napi::Value &value,
+                     AESendMode *outFlags) {
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "mode must be an object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Object mode = value.As<Napi::Object>();
+  static const std::pair<const char *, AESendMode> flags[] = {
+      {"neverInteract", kAENeverInteract},
+      {"canSwitchLayer", kAECanSwitchLayer},
+      {"dontRecord", kAEDontRecord},
+  };
+  for (const auto &[name, flag] : flags) {
+    Napi::Value flagValue = mode.Get(name);
+    if (flagValue.IsUndefined()) {
+      continue;
+    }
+    if (!flagValue.IsBoolean()) {
+      Napi::TypeError::New(env, std::string("mode.") + name +
+                                    " must be a boolean")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    if (flagValue.As<Napi::Boolean>().Value()) {
+      *outFlags |= flag;
+    }
+  }
+  return true;
+}
+
+bool ReadSignalOrThrow(Napi::Env env, const Napi::Value &value) {
+  if (!value.IsObject() ||
+      !value.As<Napi::Object>().Get("aborted").IsBoolean() ||
+      !value.As<Napi::Object>().Get("addEventListener").IsFunction()) {
+    Napi::TypeError::New(env, "signal must be an AbortSignal")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+// Reads `{ expectReply?, decodeReply?, timeoutMs?, mode?, signal?,
+//  queueReply? }`, where `decodeReply` is a boolean or `toJSValue` options.
+//  `outExpectReply` is only touched when `expectReply` is present.
+bool ReadSendOptionsOrThrow(Napi::Env env, const Napi::Value &value,
+                            SendOptions *outOptions, bool *outExpectReply) {
+  if (value.IsUndefined()) {
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "sendAppleEvent options must be an object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Object object = value.As<Napi::Object>();
+
+  Napi::Value expectReply = object.Get("expectReply");
+  if (expectReply.IsBoolean()) {
+    *outExpectReply = expectReply.As<Napi::Boolean>().Value();
+  } else if (!expectReply.IsUndefined()) {
+    Napi::TypeError::New(env, "expectReply must be a boolean")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Value timeoutMs = object.Get("timeoutMs");
+  if (!timeoutMs.IsUndefined() &&
+      !ReadTimeoutOrThrow(env, timeoutMs, &outOptions->timeoutTicks)) {
+    return false;
+  }
+
+  Napi::Value mode = object.Get("mode");
+  if (!mode.IsUndefined() &&
+      !ReadModeOrThrow(env, mode, &outOptions->modeFlags)) {
+    return false;
+  }
+
+  Napi::Value queueReply = object.Get("queueReply");
+  if (queueReply.IsBoolean()) {
+    outOptions->queueReply = queueReply.As<Napi::Boolean>().Value();
+  } else if (!queueReply.IsUndefined()) {
+    Napi::TypeError::New(env, "queueReply must be a boolean")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Value signal = object.Get("signal");
+  if (!signal.IsUndefined()) {
+    if (!ReadSignalOrThrow(env, signal)) {
+      return false;
+    }
+    outOptions->signal = signal;
+  }
+
+  Napi::Value decodeReply = object.Get("decodeReply");
+  if (decodeReply.IsBoolean()) {
+    outOptions->decodeReply = decodeReply.As<Napi::Boolean>().Value();
+  } else if (decodeReply.IsObject()) {
+    outOptions->decodeReply = true;
+    return ValueConversion::ReadToJSValueOptionsOrThrow(
+        env, decodeReply, &outOptions->replyOptions);
+  } else if (!decodeReply.IsUndefined()) {
+    Napi::TypeError::New(env,
+                         "decodeReply must be a boolean or toJSValue options")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+Napi::Value AbortReason(Napi::Env env, Napi::Object signal) {
+  Napi::Value reason = signal.Get("reason");
+  if (!reason.IsUndefined()) {
+    return reason;
+  }
+  Napi::Error error = Napi::Error::New(env, "The operation was aborted");
+  error.Set("name", Napi::String::New(env, "AbortError"));
+  return error.Value();
+}
+
+// A send's promise, settled exactly once: by the worker when the send
+//  finishes, or by the abort listener as soon as the signal fires. Only
+//  `aborted` is read off the JS thread.
+class PendingSend : public std::enable_shared_from_this<PendingSend> {
 public:
-  SendAppleEventWorker(Napi::Env env, AEDesc *request, bool expectReply)
-      : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)),
-        requestDesc(request), shouldExpectReply(expectReply) {}
+  explicit PendingSend(Napi::Env env)
+      : deferred(Napi::Promise::Deferred::New(env)) {}
+
+  Napi::Promise GetPromise() { return deferred.Promise(); }
+  bool IsSettled() const { return settled; }
+  bool IsAborted() const { return aborted.load(std::memory_order_acquire); }
+
+  void ListenForAbort(Napi::Env env, Napi::Object abortSignal) {
+    std::weak_ptr<PendingSend> weak = weak_from_this();
+    Napi::Function listener = Napi::Function::New(
+        env, [weak](const Napi::CallbackInfo &info) -> Napi::Value {
+          if (std::shared_ptr<PendingSend> pending = weak.lock()) {
+            pending->Abort(info.Env());
+          }
+          return info.Env().Undefined();
+        });
+    abortSignal.Get("addEventListener")
+        .As<Napi::Function>()
+        .Call(abortSignal, {Napi::String::New(env, "abort"), listener});
+    signal = Napi::Persistent(abortSignal);
+    abortListener = Napi::Persistent(listener);
+  }
+
+  // Runs `callback` if the signal aborts the send, before the promise is
+  //  rejected.
+  void OnAbort(std::function<void(Napi::Env)> callback) {
+    onAbort = std::move(callback);
+  }
 
-  ~SendAppleEventWorker() override {
-    if (requestDesc) {
-      AEDisposeDesc(requestDesc);
-      delete requestDesc;
+  void Resolve(Napi::Value value) {
+    if (Settle()) {
+      deferred.Resolve(value);
+    }
+  }
+
+  void Reject(Napi::Value error) {
+    if (Settle()) {
+      deferred.Reject(error);
+    }
+  }
+
+private:
+  void Abort(Napi::Env env) {
+    if (settled) {
+      return;
+    }
+    aborted.store(true, std::memory_order_release);
+    if (onAbort) {
+      onAbort(env);
     }
+    Reject(AbortReason(env, signal.Value()));
+  }
+
+  bool Settle() {
+    if (settled) {
+      return false;
+    }
+    settled = true;
+    if (!signal.IsEmpty()) {
+      Napi::Object abortSignal = signal.Value();
+      abortSignal.Get("removeEventListener")
+          .As<Napi::Function>()
+          .Call(abortSignal, {Napi::String::New(abortSignal.Env(), "abort"),
+                              abortListener.Value()});
+      signal.Reset();
+      abortListener.Reset();
+    }
+    onAbort = nullptr;
+    return true;
+  }
+
+  Napi::Promise::Deferred deferred;
+  bool settled = false;
+  std::atomic<bool> aborted{false};
+  Napi::ObjectReference signal;
+  Napi::FunctionReference abortListener;
+  std::function<void(Napi::Env)> onAbort;
+};
+
+// Sends run on a dedicated executor instead of libuv's thread pool (see
+//  `SendExecutor`). It is created on the first send and never destroyed: a
+//  thread blocked in `AESendMessage` would otherwise hold up exit until it
+//  timed out.
+namespace Executor {
+std::mutex mutex;
+SendExecutor::Options options;
+SendExecutor *shared = nullptr;
+
+SendExecutor &Get() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!shared) {
+    shared = new SendExecutor(options);
+  }
+  return *shared;
+}
+
+// Sends are spread over the executor's threads by target, keyed by the
+//  event's address attribute. Events with no address share key 0.
+uint64_t TargetKeyOf(const AEDesc *event) {
+  AEDesc address;
+  if (AEGetAttributeDesc(reinterpret_cast<const AppleEvent *>(event),
+                         keyAddressAttr, typeWildCard, &address) != noErr) {
+    return 0;
+  }
+  std::vector<uint8_t> data(static_cast<size_t>(AEGetDescDataSize(&address)));
+  uint64_t key = 0;
+  if (AEGetDescData(&address, data.data(), static_cast<Size>(data.size())) ==
+      noErr) {
+    key = DescriptorHash::HashBytes(data.data(), data.size(),
+                                    address.descriptorType);
+  }
+  AEDisposeDesc(&address);
+  return key;
+}
+} // namespace Executor
+
+// Carries finished sends back to the JS thread of the env that made them.
+//  Only referenced while that env has sends outstanding, so it never keeps
+//  the event loop alive by itself.
+class CompletionChannel
+    : public std::enable_shared_from_this<CompletionChannel> {
+public:
+  // On the JS thread: keeps the loop alive until a matching `Post` has run.
+  void Hold(Napi::Env env) {
+    if (outstanding++ == 0) {
+      tsfn.Ref(env);
+    }
+  }
+
+  // On the JS thread: gives up a `Hold` that won't be followed by a `Post`.
+  void Unhold(Napi::Env env) {
+    if (--outstanding == 0) {
+      tsfn.Unref(env);
+    }
+  }
+
+  // From any thread: runs `complete` on the JS thread, then gives up the
+  //  `Hold` it answers. Dropped if the env is being torn down.
+  void Post(std::function<void(Napi::Env)> complete) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closed) {
+      return;
+    }
+    tsfn.NonBlockingCall([self = shared_from_this(),
+                          complete = std::move(complete)](Napi::Env env,
+                                                          Napi::Function) {
+      complete(env);
+      self->Unhold(env);
+    });
+  }
+
+private:
+  friend std::shared_ptr<CompletionChannel> GetChannelOrThrow(Napi::Env env);
+  friend void CloseChannel(void *data);
+
+  Napi::ThreadSafeFunction tsfn;
+  // JS thread only.
+  size_t outstanding = 0;
+  // Guards `closed`, and every call into `tsfn` off the JS thread, so that
+  //  nothing is posted to an env that is being torn down.
+  std::mutex mutex;
+  bool closed = false;
+};
+
+std::mutex channelsMutex;
+std::unordered_map<napi_env, std::shared_ptr<CompletionChannel>> channels;
+
+void CloseChannel(void *data) {
+  auto env = static_cast<napi_env>(data);
+  std::shared_ptr<CompletionChannel> channel;
+  {
+    std::lock_guard<std::mutex> lock(channelsMutex);
+    auto it = channels.find(env);
+    if (it == channels.end()) {
+      return;
+    }
+    channel = std::move(it->second);
+    channels.erase(it);
+  }
+  std::lock_guard<std::mutex> lock(channel->mutex);
+  channel->closed = true;
+  channel->tsfn.Release();
+}
+
+std::shared_ptr<CompletionChannel> GetChannelOrThrow(Napi::Env env) {
+  std::lock_guard<std::mutex> lock(channelsMutex);
+  auto it = channels.find(env);
+  if (it != channels.end()) {
+    return it->second;
+  }
+  if (napi_add_env_cleanup_hook(env, CloseChannel,
+                                static_cast<void *>(env)) != napi_ok) {
+    Napi::Error::New(env, "Failed to register Apple event send cleanup")
+        .ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  auto channel = std::make_shared<CompletionChannel>();
+  channel->tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function(),
+                                                "AppleEventSend", 0, 1);
+  channel->tsfn.Unref(env);
+  channels.emplace(env, channel);
+  return channel;
+}
+
+// One send: `Run` on an executor thread, then `Finish` on the JS thread.
+class SendTask {
+public:
+  SendTask(std::shared_ptr<PendingSend> pending, SharedAEDesc request,
+           bool expectReply, const SendOptions &options)
+      : pending(std::move(pending)), requestDesc(std::move(request)),
+        shouldExpectReply(expectReply), decodeReply(options.decodeReply),
+        replyOptions(options.replyOptions),
+        sendMode((expectReply ? kAEWaitReply : kAENoReply) |
+                 options.modeFlags),
+        timeoutTicks(options.timeoutTicks) {}
+
+  ~SendTask() {
     if (replyDesc) {
       AEDisposeDesc(replyDesc);
       delete replyDesc;
     }
   }
 
-  Napi::Promise GetPromise() { return deferred.Promise(); }
-
-  void Execute() override {
+  void Run() {
     if (!requestDesc) {
-      errorCode = paramErr;
-      errorMessage = "Missing Apple event request descriptor";
-      SetError(errorMessage);
+      Fail(paramErr, "Missing Apple event request descriptor");
+      return;
+    }
+    // Aborted while still queued: the promise has already been rejected, so
+    //  give the thread straight back instead of sending.
+    if (pending->IsAborted()) {
       return;
     }
 
@@ -54,89 +439,677 @@ public:
     }
 
     OSErr err = AESendMessage(
-        reinterpret_cast<const AppleEvent *>(requestDesc), replyPtr,
-        shouldExpectReply ? kAEWaitReply : kAENoReply, kAEDefaultTimeout);
+        reinterpret_cast<const AppleEvent *>(requestDesc.get()), replyPtr,
+        sendMode, timeoutTicks);
     if (err != noErr) {
-      errorCode = err;
-      errorMessage = "AESendMessage failed";
-      SetError(errorMessage);
+      Fail(err, "AESendMessage failed");
+      return;
+    }
+
+    if (shouldExpectReply && decodeReply && !pending->IsAborted()) {
+      // Only the JS values are left for `Finish` to build; the reply itself
+      //  is no longer needed, so it is disposed of here too.
+      decodedReply = std::make_unique<ValueConversion::DecodedTree>();
+      ValueConversion::DecodeDescTree(replyDesc,
+                                      Descriptors::DescriptorKind::Record,
+                                      replyOptions, decodedReply.get());
+      AEDisposeDesc(replyDesc);
+      delete replyDesc;
+      replyDesc = nullptr;
     }
   }
 
-  void OnOK() override {
-    Napi::Env env = Env();
+  // Marks the send as failed without (or after) running it.
+  void Fail(OSErr err, std::string message) {
+    errorCode = err;
+    errorMessage = std::move(message);
+  }
+
+  // Builds what the send produced: the reply, its decoded parameters, or
+  //  null when no reply was expected. On failure, returns null and sets
+  //  `*outError` instead.
+  Napi::Value Finish(Napi::Env env, Napi::Value *outError) {
+    if (errorCode != noErr) {
+      *outError = OSError::New(env, errorCode, errorMessage);
+      return env.Null();
+    }
     if (!shouldExpectReply) {
-      deferred.Resolve(env.Null());
-      return;
+      return env.Null();
+    }
+
+    if (decodedReply) {
+      Napi::Value parameters = ValueConversion::MaterializeDecodedTreeOrThrow(
+          env, decodedReply.get());
+      if (env.IsExceptionPending()) {
+        *outError = env.GetAndClearPendingException().Value();
+        return env.Null();
+      }
+      return parameters;
     }
 
+    // The reply is ours alone, so the wrapper takes it over as it is.
     AEDesc *result = replyDesc;
-    Napi::Value wrapped = Descriptors::CopyAndWrapAEDescOrThrow(env, result);
+    replyDesc = nullptr;
+    Napi::Value wrapped = Descriptors::WrapOwnedAEDescOrThrow(env, result);
     if (env.IsExceptionPending()) {
-      Napi::Error error = env.GetAndClearPendingException();
-      deferred.Reject(error.Value());
-      return;
+      *outError = env.GetAndClearPendingException().Value();
+      return env.Null();
     }
     if (wrapped.IsUndefined() || wrapped.IsNull()) {
-      deferred.Reject(
-          Napi::Error::New(env, "Failed to wrap Apple event reply").Value());
-      return;
+      *outError =
+          Napi::Error::New(env, "Failed to wrap Apple event reply").Value();
+      return env.Null();
     }
-    deferred.Resolve(wrapped);
-  }
-
-  void OnError(const Napi::Error &) override {
-    deferred.Reject(OSError::New(Env(), errorCode, errorMessage));
+    return wrapped;
   }
 
 private:
-  Napi::Promise::Deferred deferred;
-  AEDesc *requestDesc = nullptr;
+  std::shared_ptr<PendingSend> pending;
+  // Shared with the event's wrapper: nothing changes a wrapped descriptor, so
+  //  the send can read it off the JS thread without a copy of its own.
+  SharedAEDesc requestDesc;
   AEDesc *replyDesc = nullptr;
   bool shouldExpectReply = false;
+  bool decodeReply = false;
+  ValueConversion::ToJSValueOptions replyOptions;
+  AESendMode sendMode;
+  long timeoutTicks;
+  std::unique_ptr<ValueConversion::DecodedTree> decodedReply;
   OSErr errorCode = noErr;
   std::string errorMessage;
 };
-Napi::Value SendAppleEvent(const Napi::CallbackInfo &info) {
-  Napi::Env env = info.Env();
-  if (info.Length() != 2 || !info[0].IsObject() || !info[1].IsBoolean()) {
-    Napi::TypeError::New(env, "sendAppleEvent takes (event, expectReply)")
-        .ThrowAsJavaScriptException();
+
+#define SEND_QUEUE_FULL_ERROR_MESSAGE                                          \
+  "The Apple event send queue, or its target's share of it, is full"
+
+// Hands `task` to the executor, to settle `pending` on `env`'s JS thread.
+//  Rejects right away if the executor's queue is full.
+void DispatchSend(Napi::Env env, std::shared_ptr<CompletionChannel> channel,
+                  std::shared_ptr<SendTask> task,
+                  std::shared_ptr<PendingSend> pending, uint64_t target) {
+  channel->Hold(env);
+  const bool queued =
+      Executor::Get().Submit(target, [channel, task, pending] {
+        task->Run();
+        channel->Post([task, pending](Napi::Env env) {
+          if (pending->IsSettled()) {
+            return;
+          }
+          Napi::Value error;
+          Napi::Value result = task->Finish(env, &error);
+          if (!error.IsEmpty()) {
+            pending->Reject(error);
+          } else {
+            pending->Resolve(result);
+          }
+        });
+      });
+  if (!queued) {
+    channel->Unhold(env);
+    pending->Reject(OSError::New(env, memFullErr,
+                                 SEND_QUEUE_FULL_ERROR_MESSAGE));
+  }
+}
+
+// A whole batch of sends, settled together once the last one finishes. Only
+//  a window of them is queued at a time; each finished send queues the next,
+//  so a large batch neither floods the executor's queue nor waits on the JS
+//  thread between sends.
+class BatchSend : public std::enable_shared_from_this<BatchSend> {
+public:
+  BatchSend(std::shared_ptr<CompletionChannel> channel,
+            std::shared_ptr<PendingSend> pending,
+            std::vector<std::unique_ptr<SendTask>> tasks,
+            std::vector<uint64_t> targets)
+      : channel(std::move(channel)), pending(std::move(pending)),
+        tasks(std::move(tasks)), targets(std::move(targets)),
+        remaining(this->tasks.size()) {}
+
+  void Start(Napi::Env env) {
+    if (tasks.empty()) {
+      Settle(env);
+      return;
+    }
+    channel->Hold(env);
+    const size_t window = std::min<size_t>(
+        tasks.size(), 2 * Executor::Get().GetOptions().threads);
+    for (size_t index = 0; index < window; ++index) {
+      DispatchNext();
+    }
+  }
+
+private:
+  // Queues the next unsent task, if any. Safe to call from any thread.
+  void DispatchNext() {
+    for (;;) {
+      const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+      if (index >= tasks.size()) {
+        return;
+      }
+      std::shared_ptr<BatchSend> self = shared_from_this();
+      const bool queued =
+          Executor::Get().Submit(targets[index], [self, index] {
+            self->tasks[index]->Run();
+            self->DispatchNext();
+            self->FinishOne();
+          });
+      if (queued) {
+        return;
+      }
+      tasks[index]->Fail(memFullErr, SEND_QUEUE_FULL_ERROR_MESSAGE);
+      FinishOne();
+    }
+  }
+
+  void FinishOne() {
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      channel->Post(
+          [self = shared_from_this()](Napi::Env env) { self->Settle(env); });
+    }
+  }
+
+  void Settle(Napi::Env env) {
+    if (pending->IsSettled()) {
+      return;
+    }
+    Napi::Array results =
+        Napi::Array::New(env, static_cast<uint32_t>(tasks.size()));
+    Napi::Array errors =
+        Napi::Array::New(env, static_cast<uint32_t>(tasks.size()));
+    for (size_t index = 0; index < tasks.size(); ++index) {
+      Napi::Value error;
+      Napi::Value result = tasks[index]->Finish(env, &error);
+      results.Set(static_cast<uint32_t>(index), result);
+      errors.Set(static_cast<uint32_t>(index),
+                 error.IsEmpty() ? env.Null() : error);
+    }
+    Napi::Object outcome = Napi::Object::New(env);
+    outcome.Set("results", results);
+    outcome.Set("errors", errors);
+    pending->Resolve(outcome);
+  }
+
+  std::shared_ptr<CompletionChannel> channel;
+  std::shared_ptr<PendingSend> pending;
+  // Each is only touched by one executor thread at a time, then by the JS
+  //  thread once all of them are done.
+  std::vector<std::unique_ptr<SendTask>> tasks;
+  std::vector<uint64_t> targets;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> remaining;
+};
+
+// Sends made with `queueReply` don't hold a thread while they wait: the event
+//  goes out with `kAEQueueReply`, and its reply comes back as an `aevt/ansr`
+//  event, which a native handler matches to the waiting send by return ID.
+//  Sends whose deadline passes are swept out by one thread, which sleeps
+//  whenever nothing is waiting.
+namespace QueuedReplies {
+struct Waiter {
+  std::shared_ptr<PendingSend> pending;
+  std::shared_ptr<CompletionChannel> channel;
+  bool decodeReply = false;
+  ValueConversion::ToJSValueOptions replyOptions;
+};
+
+// How often waiting sends are checked for having timed out.
+constexpr std::chrono::milliseconds kSweepInterval{100};
+
+struct State {
+  InFlightTable table;
+  std::mutex mutex;
+  // Guarded by `mutex`.
+  bool started = false;
+  OSErr installErr = noErr;
+  std::condition_variable sweeperWake;
+  std::atomic<bool> sweeperIdle{false};
+};
+
+// Never destroyed: the answer handler and the sweeper may still be using it
+//  at exit.
+State &GetState() {
+  static State *state = new State;
+  return *state;
+}
+
+void Settle(const std::shared_ptr<Waiter> &waiter,
+            std::function<Napi::Value(Napi::Env, Napi::Value *)> finish) {
+  waiter->channel->Post([waiter, finish = std::move(finish)](Napi::Env env) {
+    if (waiter->pending->IsSettled()) {
+      return;
+    }
+    Napi::Value error;
+    Napi::Value result = finish(env, &error);
+    if (env.IsExceptionPending()) {
+      error = env.GetAndClearPendingException().Value();
+    }
+    if (!error.IsEmpty()) {
+      waiter->pending->Reject(error);
+    } else {
+      waiter->pending->Resolve(result);
+    }
+  });
+}
+
+void Fail(const std::shared_ptr<Waiter> &waiter, OSErr err,
+          std::string message) {
+  Settle(waiter, [err, message = std::move(message)](
+                     Napi::Env env, Napi::Value *outError) -> Napi::Value {
+    *outError = OSError::New(env, err, message);
     return env.Null();
+  });
+}
+
+// The answer only lives as long as this call, so it is decoded or copied
+//  here, on whichever thread the AE Manager dispatches it on.
+OSErr AnswerHandler(const AppleEvent *answer, AppleEvent *, SRefCon) {
+  AEReturnID returnID = 0;
+  if (AEGetAttributePtr(answer, keyReturnIDAttr, typeSInt16, nullptr,
+                        &returnID, sizeof(returnID), nullptr) != noErr) {
+    return errAEEventNotHandled;
+  }
+  std::shared_ptr<Waiter> waiter(
+      static_cast<Waiter *>(GetState().table.Take(returnID)));
+  if (!waiter) {
+    return errAEEventNotHandled;
+  }
+
+  if (waiter->decodeReply) {
+    auto decoded = std::make_shared<ValueConversion::DecodedTree>();
+    ValueConversion::DecodeDescTree(reinterpret_cast<const AEDesc *>(answer),
+                                    Descriptors::DescriptorKind::Record,
+                                    waiter->replyOptions, decoded.get());
+    Settle(waiter, [decoded](Napi::Env env, Napi::Value *) {
+      return ValueConversion::MaterializeDecodedTreeOrThrow(env,
+                                                            decoded.get());
+    });
+    return noErr;
+  }
+
+  auto *copy = new AEDesc;
+  OSErr err =
+      DuplicateAEDesc(reinterpret_cast<const AEDesc *>(answer), copy);
+  if (err != noErr) {
+    delete copy;
+    Fail(waiter, err, "Failed to copy Apple event reply");
+    return noErr;
+  }
+  SharedAEDesc reply = AdoptAEDesc(copy);
+  Settle(waiter, [reply](Napi::Env env, Napi::Value *) {
+    return Descriptors::WrapSharedAEDescOrThrow(env, reply);
+  });
+  return noErr;
+}
+
+void Sweep() {
+  for (;;) {
+    {
+      State &state = GetState();
+      std::unique_lock<std::mutex> lock(state.mutex);
+      state.sweeperIdle.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      state.sweeperWake.wait(lock, [&] { return state.table.Size() > 0; });
+      state.sweeperIdle.store(false);
+    }
+    std::this_thread::sleep_for(kSweepInterval);
+    GetState().table.Sweep(
+        InFlightTable::Clock::now(), [](int16_t, void *cookie) {
+          Fail(std::shared_ptr<Waiter>(static_cast<Waiter *>(cookie)),
+               errAETimeout,
+               "Timed out waiting for a queued Apple event reply");
+        });
+  }
+}
+
+void WakeSweeper() {
+  State &state = GetState();
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (state.sweeperIdle.load()) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.sweeperWake.notify_one();
+  }
+}
+
+// Installs the answer handler and starts the sweeper, once per process.
+OSErr EnsureStarted() {
+  State &state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (!state.started) {
+    state.started = true;
+    state.installErr = AEInstallEventHandler(
+        kCoreEventClass, kAEAnswer, NewAEEventHandlerUPP(AnswerHandler),
+        nullptr, false);
+    if (state.installErr == noErr) {
+      std::thread(Sweep).detach();
+    }
+  }
+  return state.installErr;
+}
+
+InFlightTable::Clock::time_point DeadlineFor(long timeoutTicks) {
+  if (timeoutTicks == kNoTimeOut) {
+    return InFlightTable::Clock::time_point::max();
+  }
+  // The AE Manager's default timeout is about a minute.
+  const long ticks = timeoutTicks == kAEDefaultTimeout ? 3600 : timeoutTicks;
+  return InFlightTable::Clock::now() +
+         std::chrono::milliseconds(static_cast<int64_t>(ticks) * 1000 / 60);
+}
+
+// Sends `event` with `kAEQueueReply`, settling `pending` once its reply
+//  arrives or its deadline passes.
+void Send(Napi::Env env, std::shared_ptr<CompletionChannel> channel,
+          std::shared_ptr<PendingSend> pending, const SharedAEDesc &event,
+          const SendOptions &options) {
+  OSErr err = EnsureStarted();
+  if (err != noErr) {
+    pending->Reject(OSError::New(
+        env, err, "Failed to install the queued Apple event reply handler"));
+    return;
+  }
+  AEReturnID returnID = 0;
+  err = AEGetAttributePtr(reinterpret_cast<const AppleEvent *>(event.get()),
+                          keyReturnIDAttr, typeSInt16, nullptr, &returnID,
+                          sizeof(returnID), nullptr);
+  if (err != noErr) {
+    pending->Reject(
+        OSError::New(env, err, "Failed to read the event's return ID"));
+    return;
+  }
+
+  auto waiter = std::make_unique<Waiter>(Waiter{
+      pending, channel, options.decodeReply, options.replyOptions});
+  Waiter *raw = waiter.get();
+  InFlightTable &table = GetState().table;
+  if (!table.Insert(returnID, raw, DeadlineFor(options.timeoutTicks))) {
+    pending->Reject(OSError::New(
+        env, paramErr,
+        "An Apple event with return ID " + std::to_string(returnID) +
+            " is already awaiting a queued reply"));
+    return;
+  }
+  waiter.release();
+  channel->Hold(env);
+  WakeSweeper();
+
+  // Whoever empties the slot owns the waiter. If that's the reply or the
+  //  sweep, it outlives this callback's chance to run (the promise is settled
+  //  first), so `raw` can't have been reused for another send.
+  pending->OnAbort([returnID, raw](Napi::Env env) {
+    if (GetState().table.Remove(returnID, raw)) {
+      std::unique_ptr<Waiter> owned(raw);
+      owned->channel->Unhold(env);
+    }
+  });
+
+  AppleEvent reply;
+  AEInitializeDesc(&reply);
+  err = AESendMessage(reinterpret_cast<const AppleEvent *>(event.get()),
+                      &reply, kAEQueueReply | options.modeFlags,
+                      options.timeoutTicks);
+  AEDisposeDesc(&reply);
+  if (err != noErr && table.Remove(returnID, raw)) {
+    std::unique_ptr<Waiter> owned(raw);
+    owned->channel->Unhold(env);
+    pending->Reject(OSError::New(env, err, "AESendMessage failed"));
   }
+}
+} // namespace QueuedReplies
 
-  auto *wrapper = Descriptors::UnwrapDescriptor(info[0]);
+// Checks that `value` wraps an Apple event, and shares its descriptor.
+bool UnwrapEventOrThrow(Napi::Env env, const Napi::Value &value,
+                        const char *caller, SharedAEDesc *outEvent) {
+  auto *wrapper = value.IsObject() ? Descriptors::UnwrapDescriptor(value)
+                                   : nullptr;
   if (!wrapper) {
     Napi::Error::New(env, "Invalid event descriptor")
         .ThrowAsJavaScriptException();
-    return env.Null();
+    return false;
   }
   const AEDesc *rawDesc = wrapper->GetRawDescriptor();
   if (!rawDesc) {
     Napi::Error::New(env, "Uninitialized descriptor")
         .ThrowAsJavaScriptException();
-    return env.Null();
+    return false;
   }
   if (rawDesc->descriptorType != typeAppleEvent) {
-    Napi::TypeError::New(env, "sendAppleEvent requires AEEventDescriptor")
+    Napi::TypeError::New(env,
+                         std::string(caller) + " requires AEEventDescriptor")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  *outEvent = wrapper->GetSharedDescriptor();
+  return true;
+}
+
+// Ties `pending` to `options.signal`, if any. Returns false, having rejected
+//  `pending`, if the signal has already fired.
+bool ListenForAbort(Napi::Env env, const SendOptions &options,
+                    PendingSend &pending) {
+  if (options.signal.IsEmpty()) {
+    return true;
+  }
+  Napi::Object signal = options.signal.As<Napi::Object>();
+  if (signal.Get("aborted").As<Napi::Boolean>().Value()) {
+    pending.Reject(AbortReason(env, signal));
+    return false;
+  }
+  pending.ListenForAbort(env, signal);
+  return true;
+}
+
+Napi::Value SendAppleEvent(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  // Either (event, expectReply, options?) or (event, options?), where the
+  //  latter expects a reply unless `options.expectReply` is false.
+  const bool positional = info.Length() >= 2 && info[1].IsBoolean();
+  const size_t optionsIndex = positional ? 2 : 1;
+  if (info.Length() < 1 || info.Length() > optionsIndex + 1 ||
+      !info[0].IsObject()) {
+    Napi::TypeError::New(env, "sendAppleEvent takes (event, expectReply, "
+                              "options?) or (event, options?)")
         .ThrowAsJavaScriptException();
     return env.Null();
   }
+  bool expectReply = true;
+  SendOptions options;
+  if (!ReadSendOptionsOrThrow(env,
+                              info.Length() > optionsIndex ? info[optionsIndex]
+                                                           : env.Undefined(),
+                              &options, &expectReply)) {
+    return env.Null();
+  }
+  if (positional) {
+    expectReply = info[1].As<Napi::Boolean>().Value();
+  }
 
-  AEDesc *requestCopy = new AEDesc{};
-  OSErr dupErr = AEDuplicateDesc(rawDesc, requestCopy);
-  if (dupErr != noErr) {
-    delete requestCopy;
-    OSError::Throw(env, dupErr, "AEDuplicateDesc failed");
+  SharedAEDesc event;
+  if (!UnwrapEventOrThrow(env, info[0], "sendAppleEvent", &event)) {
+    return env.Null();
+  }
+  std::shared_ptr<CompletionChannel> channel = GetChannelOrThrow(env);
+  if (!channel) {
     return env.Null();
   }
 
-  bool expectReply = info[1].As<Napi::Boolean>().Value();
-  auto *worker = new SendAppleEventWorker(env, requestCopy, expectReply);
-  Napi::Promise promise = worker->GetPromise();
-  worker->Queue();
+  auto pending = std::make_shared<PendingSend>(env);
+  Napi::Promise promise = pending->GetPromise();
+  if (!ListenForAbort(env, options, *pending)) {
+    return promise;
+  }
+  if (options.queueReply && expectReply) {
+    QueuedReplies::Send(env, std::move(channel), std::move(pending), event,
+                        options);
+    return promise;
+  }
+  const uint64_t target = Executor::TargetKeyOf(event.get());
+  auto task =
+      std::make_shared<SendTask>(pending, std::move(event), expectReply,
+                                 options);
+  DispatchSend(env, std::move(channel), std::move(task), std::move(pending),
+               target);
   return promise;
 }
+
+// Takes (events, options?), with the same options as `sendAppleEvent`
+//  applying to every event. Resolves to `{ results, errors }`, each in the
+//  order of `events`: a send's reply (or decoded parameters, or null) in
+//  `results`, and what it failed with (or null) in `errors`.
+Napi::Value SendAppleEvents(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() < 1 || info.Length() > 2 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "sendAppleEvents takes (events, options?)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  bool expectReply = true;
+  SendOptions options;
+  if (!ReadSendOptionsOrThrow(
+          env, info.Length() == 2 ? info[1] : env.Undefined(), &options,
+          &expectReply)) {
+    return env.Null();
+  }
+  if (options.queueReply) {
+    Napi::TypeError::New(env, "sendAppleEvents doesn't support queueReply")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  std::shared_ptr<CompletionChannel> channel = GetChannelOrThrow(env);
+  if (!channel) {
+    return env.Null();
+  }
+
+  auto pending = std::make_shared<PendingSend>(env);
+  Napi::Array events = info[0].As<Napi::Array>();
+  const uint32_t count = events.Length();
+  std::vector<std::unique_ptr<SendTask>> tasks;
+  std::vector<uint64_t> targets;
+  tasks.reserve(count);
+  targets.reserve(count);
+  for (uint32_t index = 0; index < count; ++index) {
+    SharedAEDesc event;
+    if (!UnwrapEventOrThrow(env, events.Get(index), "sendAppleEvents",
+                            &event)) {
+      return env.Null();
+    }
+    targets.push_back(Executor::TargetKeyOf(event.get()));
+    tasks.push_back(std::make_unique<SendTask>(pending, std::move(event),
+                                               expectReply, options));
+  }
+
+  Napi::Promise promise = pending->GetPromise();
+  if (!ListenForAbort(env, options, *pending)) {
+    return promise;
+  }
+  auto batch = std::make_shared<BatchSend>(std::move(channel), pending,
+                                           std::move(tasks),
+                                           std::move(targets));
+  batch->Start(env);
+  return promise;
+}
+
+bool ReadCountOrThrow(Napi::Env env, Napi::Object object, const char *name,
+                      double min, double max, double *outValue) {
+  Napi::Value value = object.Get(name);
+  if (value.IsUndefined()) {
+    return true;
+  }
+  const double number =
+      value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : min - 1;
+  if (!(number >= min && number <= max) || number != std::floor(number)) {
+    Napi::TypeError::New(env, std::string(name) + " must be an integer from " +
+                                  std::to_string(static_cast<long>(min)) +
+                                  " to " +
+                                  std::to_string(static_cast<long>(max)))
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  *outValue = number;
+  return true;
+}
+
+// Takes `{ threads?, queueCapacity?, maxPerTarget?, maxQueuedPerTarget? }`.
+//  Only possible before the first send, since the executor's threads are
+//  fixed once started.
+Napi::Value ConfigureSendExecutor(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "configureSendExecutor takes (options)")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Object object = info[0].As<Napi::Object>();
+
+  std::lock_guard<std::mutex> lock(Executor::mutex);
+  if (Executor::shared) {
+    Napi::Error::New(env, "The Apple event send executor has already started")
+        .ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  SendExecutor::Options options = Executor::options;
+  double threads = options.threads;
+  double queueCapacity = static_cast<double>(options.queueCapacity);
+  double maxPerTarget = options.maxPerTarget;
+  double maxQueuedPerTarget = static_cast<double>(options.maxQueuedPerTarget);
+  if (!ReadCountOrThrow(env, object, "threads", 1, 256, &threads) ||
+      !ReadCountOrThrow(env, object, "queueCapacity", 1, 1 << 24,
+                        &queueCapacity) ||
+      !ReadCountOrThrow(env, object, "maxPerTarget", 0, 256, &maxPerTarget) ||
+      !ReadCountOrThrow(env, object, "maxQueuedPerTarget", 0, 1 << 24,
+                        &maxQueuedPerTarget)) {
+    return env.Null();
+  }
+  options.threads = static_cast<unsigned>(threads);
+  options.queueCapacity = static_cast<size_t>(queueCapacity);
+  options.maxPerTarget = static_cast<unsigned>(maxPerTarget);
+  options.maxQueuedPerTarget = static_cast<size_t>(maxQueuedPerTarget);
+  Executor::options = options;
+  return env.Undefined();
+}
+
+Napi::Value GetSendExecutorStats(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  const SendExecutor::Stats stats = Executor::Get().GetStats();
+  const SendExecutor::Options &options = Executor::Get().GetOptions();
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("queueDepth",
+             Napi::Number::New(env, static_cast<double>(stats.queueDepth)));
+  result.Set("queueCapacity", Napi::Number::New(env, static_cast<double>(
+                                                 options.queueCapacity)));
+  result.Set("maxQueuedPerTarget",
+             Napi::Number::New(
+                 env, static_cast<double>(options.maxQueuedPerTarget)));
+  result.Set("inFlight",
+             Napi::Number::New(env, static_cast<double>(stats.inFlight)));
+  result.Set("submitted",
+             Napi::Number::New(env, static_cast<double>(stats.submitted)));
+  result.Set("completed",
+             Napi::Number::New(env, static_cast<double>(stats.completed)));
+  result.Set("rejected",
+             Napi::Number::New(env, static_cast<double>(stats.rejected)));
+  result.Set("rejectedForTarget",
+             Napi::Number::New(
+                 env, static_cast<double>(stats.rejectedForTarget)));
+  result.Set("stolen",
+             Napi::Number::New(env, static_cast<double>(stats.stolen)));
+  Napi::Array threads =
+      Napi::Array::New(env, static_cast<uint32_t>(stats.threads.size()));
+  for (size_t index = 0; index < stats.threads.size(); ++index) {
+    const SendExecutor::ThreadStats &thread = stats.threads[index];
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("busyMs",
+              Napi::Number::New(
+                  env, std::chrono::duration<double, std::milli>(thread.busy)
+                           .count()));
+    entry.Set("utilization", Napi::Number::New(env, thread.utilization));
+    entry.Set("completed", Napi::Number::New(
+                               env, static_cast<double>(thread.completed)));
+    threads.Set(static_cast<uint32_t>(index), entry);
+  }
+  result.Set("threads", threads);
+  return result;
+}
 } // namespace Sending
 namespace Handling {
 #define POISONED_ENV_ERROR_MESSAGE                                             \
@@ -184,26 +1157,32 @@ std::atomic<uint32_t> activeCallbackCount{0};
 
 bool ParseKeyOrThrow(const Napi::Env &env, const Napi::Value &classValue,
                      const Napi::Value &idValue, Key *outKey) {
-  if (!classValue.IsString() || !idValue.IsString()) {
-    Napi::TypeError::New(env,
-                         "eventClass and eventID must be FourCharCode strings")
+  if (!IsFourCharCodeValue(classValue) || !IsFourCharCodeValue(idValue)) {
+    Napi::TypeError::New(env, "eventClass and eventID must be FourCharCodes")
         .ThrowAsJavaScriptException();
     return false;
   }
 
   try {
-    outKey->eventClass =
-        StringToFourCharCode(classValue.As<Napi::String>().Utf8Value());
+    outKey->eventClass = JSValueToFourCharCode(classValue);
     if (outKey->eventClass == 0) {
       Napi::Error::New(env, "Invalid event class").ThrowAsJavaScriptException();
       return false;
     }
-    outKey->eventID =
-        StringToFourCharCode(idValue.As<Napi::String>().Utf8Value());
+    outKey->eventID = JSValueToFourCharCode(idValue);
     if (outKey->eventID == 0) {
       Napi::Error::New(env, "Invalid event ID").ThrowAsJavaScriptException();
       return false;
     }
+    // `aevt/ansr` belongs to the handler that matches queued replies to their
+    //  sends (see `QueuedReplies`). Installing over it, or removing it, would
+    //  leave those sends waiting until they time out.
+    if (outKey->eventClass == kCoreEventClass &&
+        outKey->eventID == kAEAnswer) {
+      Napi::Error::New(env, "aevt/ansr is reserved for replies to queued sends")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
   } catch (const Napi::Error &error) {
     error.ThrowAsJavaScriptException();
     return false;
@@ -531,7 +1510,7 @@ OSErr HandlePromiseResult(const Napi::Env &env, Napi::Promise &promise,
 
   auto suspendedEventCopy = std::make_unique<AppleEvent>();
   OSErr eventCopyErr =
-      AEDuplicateDesc(reinterpret_cast<const AEDesc *>(event),
+      DuplicateAEDesc(reinterpret_cast<const AEDesc *>(event),
                       reinterpret_cast<AEDesc *>(suspendedEventCopy.get()));
   if (eventCopyErr != noErr) {
     return eventCopyErr;
@@ -539,7 +1518,7 @@ OSErr HandlePromiseResult(const Napi::Env &env, Napi::Promise &promise,
 
   auto replyCopy = std::make_unique<AppleEvent>();
   OSErr replyCopyErr =
-      AEDuplicateDesc(reinterpret_cast<const AEDesc *>(reply),
+      DuplicateAEDesc(reinterpret_cast<const AEDesc *>(reply),
                       reinterpret_cast<AEDesc *>(replyCopy.get()));
   if (replyCopyErr != noErr) {
     return replyCopyErr;
@@ -637,8 +1616,7 @@ OSErr ApplyResultObjectToReply(const Napi::Env &env, Napi::Object &resultObject,
           reply, errAEWrongDataType,
           "JS handler returned a property keyword that wasn't a string");
     }
-    FourCharCode keyword =
-        StringToFourCharCode(key.As<Napi::String>().Utf8Value());
+    FourCharCode keyword = PropertyNameToFourCharCode(key);
     if (keyword == 0) {
       return Carbon::MakeErrorReply(reply, errAEWrongDataType,
                                     "JS handler returned a property keyword "
@@ -920,10 +1898,10 @@ OSErr AppleEventHandlerThunk(const AppleEvent *event, AppleEvent *reply,
 
 Napi::Value HandleAppleEvent(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
-  if (info.Length() != 3 || !info[0].IsString() || !info[1].IsString() ||
-      !info[2].IsFunction()) {
-    Napi::TypeError::New(env, "handleAppleEvent takes (eventClass: string, "
-                              "eventID: string, handler: function)")
+  if (info.Length() != 3 || !IsFourCharCodeValue(info[0]) ||
+      !IsFourCharCodeValue(info[1]) || !info[2].IsFunction()) {
+    Napi::TypeError::New(env, "handleAppleEvent takes (eventClass: FourCharCode, "
+                              "eventID: FourCharCode, handler: function)")
         .ThrowAsJavaScriptException();
     return env.Undefined();
   }
@@ -995,9 +1973,10 @@ Napi::Value HandleAppleEvent(const Napi::CallbackInfo &info) {
 
 Napi::Value UnhandleAppleEvent(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
-  if (info.Length() != 2 || !info[0].IsString() || !info[1].IsString()) {
-    Napi::TypeError::New(env, "unhandleAppleEvent takes (eventClass: string, "
-                              "eventID: string)")
+  if (info.Length() != 2 || !IsFourCharCodeValue(info[0]) ||
+      !IsFourCharCodeValue(info[1])) {
+    Napi::TypeError::New(env, "unhandleAppleEvent takes (eventClass: FourCharCode, "
+                              "eventID: FourCharCode)")
         .ThrowAsJavaScriptException();
     return env.Undefined();
   }
@@ -1051,6 +2030,15 @@ Napi::Value UnhandleAppleEvent(const Napi::CallbackInfo &info) {
 void Init(Napi::Env env, Napi::Object exports) {
   exports.Set("sendAppleEvent",
               Napi::Function::New(env, AppleEventAPI::Sending::SendAppleEvent));
+  exports.Set("sendAppleEvents",
+              Napi::Function::New(env,
+                                  AppleEventAPI::Sending::SendAppleEvents));
+  exports.Set("configureSendExecutor",
+              Napi::Function::New(
+                  env, AppleEventAPI::Sending::ConfigureSendExecutor));
+  exports.Set("getSendExecutorStats",
+              Napi::Function::New(
+                  env, AppleEventAPI::Sending::GetSendExecutorStats));
   exports.Set(
       "handleAppleEvent",
       Napi::Function::New(env, AppleEventAPI::Handling::HandleAppleEvent));
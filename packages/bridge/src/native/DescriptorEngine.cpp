@@ -0,0 +1,1561 @@
+#include "DescriptorEngine.h"
+
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ae_js_bridge {
+namespace DescriptorEngine {
+namespace {
+enum class Kind : uint8_t {
+  Data,
+  List,
+  Record,
+  Event,
+};
+
+struct Entry {
+  Code keyword;
+  Descriptor value;
+};
+} // namespace
+
+class Node {
+public:
+  explicit Node(Kind kind) : kind(kind) {}
+  Node(const Node &) = delete;
+  Node &operator=(const Node &) = delete;
+
+  ~Node() {
+    for (Entry &entry : entries) {
+      Dispose(&entry.value);
+    }
+    for (Entry &entry : attributes) {
+      Dispose(&entry.value);
+    }
+  }
+
+  Kind kind;
+  // Descriptors holding this node. Nodes are shared by `Duplicate` and copied
+  //  only when a holder mutates one that's shared.
+  std::atomic<uint32_t> references{1};
+  // The bytes of a data descriptor.
+  std::vector<uint8_t> bytes;
+  // List items (keyed with the wild card), record fields or event parameters.
+  std::vector<Entry> entries;
+  // Event attributes.
+  std::vector<Entry> attributes;
+};
+
+namespace {
+template <typename Fn> Status Guarded(Fn &&fn) {
+  try {
+    return fn();
+  } catch (const std::bad_alloc &) {
+    return Errors::MemFullErr;
+  }
+}
+
+const Node *NodeOf(const Descriptor &desc) { return desc.dataHandle; }
+
+bool HasKind(const Descriptor &desc, Kind kind) {
+  return desc.dataHandle && desc.dataHandle->kind == kind;
+}
+
+bool IsKeyed(const Descriptor &desc) {
+  return HasKind(desc, Kind::Record) || HasKind(desc, Kind::Event);
+}
+
+std::atomic<uint64_t> clonedNodes{0};
+std::atomic<uint64_t> clonedBytes{0};
+
+Node *Retain(Node *node) {
+  if (node) {
+    node->references.fetch_add(1, std::memory_order_relaxed);
+  }
+  return node;
+}
+
+void Release(Node *node) {
+  if (node && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete node;
+  }
+}
+
+// Copies one level: the clone gets its own bytes and entry table, but shares
+//  every child with `source`.
+std::unique_ptr<Node> CloneNode(const Node &source) {
+  auto clone = std::make_unique<Node>(source.kind);
+  clone->bytes = source.bytes;
+  clone->entries.reserve(source.entries.size());
+  for (const Entry &entry : source.entries) {
+    clone->entries.push_back(
+        {entry.keyword,
+         {entry.value.descriptorType, Retain(entry.value.dataHandle)}});
+  }
+  clone->attributes.reserve(source.attributes.size());
+  for (const Entry &entry : source.attributes) {
+    clone->attributes.push_back(
+        {entry.keyword,
+         {entry.value.descriptorType, Retain(entry.value.dataHandle)}});
+  }
+  clonedNodes.fetch_add(1, std::memory_order_relaxed);
+  clonedBytes.fetch_add(source.bytes.size(), std::memory_order_relaxed);
+  return clone;
+}
+
+// Returns `desc`'s node, first giving `desc` its own copy if it's shared.
+//  Throws `std::bad_alloc`.
+Node *MutableNode(Descriptor *desc) {
+  Node *node = desc->dataHandle;
+  if (node->references.load(std::memory_order_acquire) == 1) {
+    return node;
+  }
+  Node *clone = CloneNode(*node).release();
+  Release(node);
+  desc->dataHandle = clone;
+  return clone;
+}
+
+Descriptor Share(const Descriptor &source) {
+  return {source.descriptorType, Retain(source.dataHandle)};
+}
+
+Entry *FindEntry(std::vector<Entry> &entries, Code keyword) {
+  for (Entry &entry : entries) {
+    if (entry.keyword == keyword) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+// Shares `item` into `outItem`, and only then gives `container` its own node
+//  to put it in. The other way round, putting a list into itself would find
+//  its node unshared, mutate it in place and then hold it as its own item.
+//  Throws `std::bad_alloc`, leaving `outItem` null.
+Node *ShareIntoMutable(Descriptor *container, const Descriptor &item,
+                       Descriptor *outItem) {
+  *outItem = Share(item);
+  try {
+    return MutableNode(container);
+  } catch (...) {
+    Dispose(outItem);
+    throw;
+  }
+}
+
+// Puts `value` under `keyword`, replacing any entry already there. Takes over
+//  the caller's reference to `value`.
+Status PutEntry(std::vector<Entry> &entries, Code keyword, Descriptor value) {
+  if (Entry *existing = FindEntry(entries, keyword)) {
+    Dispose(&existing->value);
+    existing->value = value;
+    return Errors::NoErr;
+  }
+  try {
+    entries.push_back({keyword, value});
+  } catch (...) {
+    Dispose(&value);
+    throw;
+  }
+  return Errors::NoErr;
+}
+
+void PeekEntry(const Entry &entry, Code *outType, size_t *outSize) {
+  if (outType) {
+    *outType = entry.value.descriptorType;
+  }
+  if (outSize) {
+    *outSize = DataSize(entry.value);
+  }
+}
+
+Status GetEntryValue(const Entry &entry, Code desiredType, Descriptor *out) {
+  if (desiredType == Types::WildCard ||
+      desiredType == entry.value.descriptorType) {
+    return Duplicate(entry.value, out);
+  }
+  return Coerce(entry.value, desiredType, out);
+}
+
+Status MakeData(Code type, const void *data, size_t size, Descriptor *out) {
+  Initialize(out);
+  if (type == Types::Null) {
+    return Errors::NoErr;
+  }
+  auto node = std::make_unique<Node>(Kind::Data);
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  if (size > 0) {
+    node->bytes.assign(bytes, bytes + size);
+  }
+  out->descriptorType = type;
+  out->dataHandle = node.release();
+  return Errors::NoErr;
+}
+
+// --- Coercion between the standard scalar types -----------------------------
+
+struct Number {
+  enum class Kind { Signed, Unsigned, Float } kind = Kind::Signed;
+  int64_t s = 0;
+  uint64_t u = 0;
+  double f = 0;
+};
+
+bool IsNumericType(Code type) {
+  switch (type) {
+  case Types::SInt16:
+  case Types::SInt32:
+  case Types::SInt64:
+  case Types::UInt16:
+  case Types::UInt32:
+  case Types::UInt64:
+  case Types::Float32:
+  case Types::Float64:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsBooleanType(Code type) {
+  return type == Types::Boolean || type == Types::True ||
+         type == Types::False;
+}
+
+// 'TEXT' is treated as UTF-8; there is no system encoding to defer to here.
+bool IsTextType(Code type) {
+  return type == Types::UTF8Text || type == Types::UnicodeText ||
+         type == Types::Char;
+}
+
+bool IsCodeType(Code type) {
+  return type == Types::Type || type == Types::Enumerated ||
+         type == Types::Keyword || type == Types::Property;
+}
+
+template <typename T>
+bool ReadExactly(const std::vector<uint8_t> &bytes, T *out) {
+  if (bytes.size() != sizeof(T)) {
+    return false;
+  }
+  std::memcpy(out, bytes.data(), sizeof(T));
+  return true;
+}
+
+bool ReadNumber(Code type, const std::vector<uint8_t> &bytes, Number *out) {
+  auto readSigned = [&](auto value) {
+    if (!ReadExactly(bytes, &value)) {
+      return false;
+    }
+    out->kind = Number::Kind::Signed;
+    out->s = value;
+    return true;
+  };
+  auto readUnsigned = [&](auto value) {
+    if (!ReadExactly(bytes, &value)) {
+      return false;
+    }
+    out->kind = Number::Kind::Unsigned;
+    out->u = value;
+    return true;
+  };
+  auto readFloat = [&](auto value) {
+    if (!ReadExactly(bytes, &value)) {
+      return false;
+    }
+    out->kind = Number::Kind::Float;
+    out->f = value;
+    return true;
+  };
+
+  switch (type) {
+  case Types::SInt16:
+    return readSigned(int16_t{});
+  case Types::SInt32:
+    return readSigned(int32_t{});
+  case Types::SInt64:
+    return readSigned(int64_t{});
+  case Types::UInt16:
+    return readUnsigned(uint16_t{});
+  case Types::UInt32:
+    return readUnsigned(uint32_t{});
+  case Types::UInt64:
+    return readUnsigned(uint64_t{});
+  case Types::Float32:
+    return readFloat(float{});
+  case Types::Float64:
+    return readFloat(double{});
+  default:
+    return false;
+  }
+}
+
+template <typename T> bool ConvertNumber(const Number &number, T *out) {
+  if constexpr (std::is_floating_point_v<T>) {
+    switch (number.kind) {
+    case Number::Kind::Signed:
+      *out = static_cast<T>(number.s);
+      break;
+    case Number::Kind::Unsigned:
+      *out = static_cast<T>(number.u);
+      break;
+    case Number::Kind::Float:
+      *out = static_cast<T>(number.f);
+      break;
+    }
+    return true;
+  } else {
+    switch (number.kind) {
+    case Number::Kind::Signed:
+      if (!std::in_range<T>(number.s)) {
+        return false;
+      }
+      *out = static_cast<T>(number.s);
+      return true;
+    case Number::Kind::Unsigned:
+      if (!std::in_range<T>(number.u)) {
+        return false;
+      }
+      *out = static_cast<T>(number.u);
+      return true;
+    case Number::Kind::Float: {
+      if (!std::isfinite(number.f)) {
+        return false;
+      }
+      const double rounded = std::nearbyint(number.f);
+      // 2^digits is exactly representable, unlike the type's maximum.
+      if (rounded < static_cast<double>(std::numeric_limits<T>::min()) ||
+          rounded >= std::ldexp(1.0, std::numeric_limits<T>::digits)) {
+        return false;
+      }
+      *out = static_cast<T>(rounded);
+      return true;
+    }
+    }
+    return false;
+  }
+}
+
+Status WriteNumber(const Number &number, Code type, Descriptor *out) {
+  auto write = [&](auto value) {
+    if (!ConvertNumber(number, &value)) {
+      return Errors::CoercionFail;
+    }
+    return MakeData(type, &value, sizeof(value), out);
+  };
+
+  switch (type) {
+  case Types::SInt16:
+    return write(int16_t{});
+  case Types::SInt32:
+    return write(int32_t{});
+  case Types::SInt64:
+    return write(int64_t{});
+  case Types::UInt16:
+    return write(uint16_t{});
+  case Types::UInt32:
+    return write(uint32_t{});
+  case Types::UInt64:
+    return write(uint64_t{});
+  case Types::Float32:
+    return write(float{});
+  case Types::Float64:
+    return write(double{});
+  default:
+    return Errors::CoercionFail;
+  }
+}
+
+std::string FormatNumber(const Number &number) {
+  switch (number.kind) {
+  case Number::Kind::Signed:
+    return std::to_string(number.s);
+  case Number::Kind::Unsigned:
+    return std::to_string(number.u);
+  case Number::Kind::Float:
+    break;
+  }
+  char buffer[32];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), number.f);
+  return std::string(buffer, result.ptr);
+}
+
+std::string_view Trim(std::string_view text) {
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+bool ParseNumber(std::string_view text, Number *out) {
+  text = Trim(text);
+  if (text.empty()) {
+    return false;
+  }
+  const char *begin = text.data();
+  const char *end = text.data() + text.size();
+
+  int64_t s = 0;
+  auto signedResult = std::from_chars(begin, end, s);
+  if (signedResult.ec == std::errc() && signedResult.ptr == end) {
+    out->kind = Number::Kind::Signed;
+    out->s = s;
+    return true;
+  }
+  uint64_t u = 0;
+  auto unsignedResult = std::from_chars(begin, end, u);
+  if (unsignedResult.ec == std::errc() && unsignedResult.ptr == end) {
+    out->kind = Number::Kind::Unsigned;
+    out->u = u;
+    return true;
+  }
+
+  // `strtod` needs a terminated string.
+  const std::string terminated(text);
+  char *parsedEnd = nullptr;
+  const double f = std::strtod(terminated.c_str(), &parsedEnd);
+  if (parsedEnd != terminated.c_str() + terminated.size()) {
+    return false;
+  }
+  out->kind = Number::Kind::Float;
+  out->f = f;
+  return true;
+}
+
+void AppendUtf8(char32_t codePoint, std::string *out) {
+  if (codePoint < 0x80) {
+    out->push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    out->push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    out->push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+constexpr char32_t kReplacementCharacter = 0xFFFD;
+
+// 'utxt' data is host-endian UTF-16, optionally led by a byte order mark.
+std::string Utf16ToUtf8(const std::vector<uint8_t> &bytes) {
+  std::vector<char16_t> units(bytes.size() / sizeof(char16_t));
+  if (!units.empty()) {
+    std::memcpy(units.data(), bytes.data(), units.size() * sizeof(char16_t));
+  }
+
+  std::string result;
+  result.reserve(units.size());
+  size_t index = !units.empty() && units[0] == 0xFEFF ? 1 : 0;
+  while (index < units.size()) {
+    char32_t unit = units[index++];
+    if (unit >= 0xD800 && unit <= 0xDBFF && index < units.size() &&
+        units[index] >= 0xDC00 && units[index] <= 0xDFFF) {
+      unit = 0x10000 + ((unit - 0xD800) << 10) + (units[index++] - 0xDC00);
+    } else if (unit >= 0xD800 && unit <= 0xDFFF) {
+      unit = kReplacementCharacter;
+    }
+    AppendUtf8(unit, &result);
+  }
+  return result;
+}
+
+std::u16string Utf8ToUtf16(std::string_view text) {
+  std::u16string result;
+  result.reserve(text.size());
+  size_t index = 0;
+  while (index < text.size()) {
+    const auto lead = static_cast<uint8_t>(text[index]);
+    size_t length = lead < 0x80           ? 1
+                    : (lead >> 5) == 0x6  ? 2
+                    : (lead >> 4) == 0xE  ? 3
+                    : (lead >> 3) == 0x1E ? 4
+                                          : 0;
+    char32_t codePoint = kReplacementCharacter;
+    if (length == 1) {
+      codePoint = lead;
+    } else if (length > 1 && index + length <= text.size()) {
+      codePoint = lead & (0x7F >> length);
+      for (size_t i = 1; i < length; ++i) {
+        const auto continuation = static_cast<uint8_t>(text[index + i]);
+        if ((continuation & 0xC0) != 0x80) {
+          codePoint = kReplacementCharacter;
+          length = i;
+          break;
+        }
+        codePoint = (codePoint << 6) | (continuation & 0x3F);
+      }
+    } else {
+      length = 1;
+    }
+
+    if (codePoint > 0x10FFFF ||
+        (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+      codePoint = kReplacementCharacter;
+    }
+    if (codePoint >= 0x10000) {
+      codePoint -= 0x10000;
+      result.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+      result.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+    } else {
+      result.push_back(static_cast<char16_t>(codePoint));
+    }
+    index += length;
+  }
+  return result;
+}
+
+std::string ReadText(Code type, const std::vector<uint8_t> &bytes) {
+  if (type == Types::UnicodeText) {
+    return Utf16ToUtf8(bytes);
+  }
+  return std::string(bytes.begin(), bytes.end());
+}
+
+Status WriteText(std::string_view text, Code type, Descriptor *out) {
+  if (type == Types::UnicodeText) {
+    const std::u16string units = Utf8ToUtf16(text);
+    return MakeData(type, units.data(), units.size() * sizeof(char16_t), out);
+  }
+  return MakeData(type, text.data(), text.size(), out);
+}
+
+bool ReadBoolean(Code type, const std::vector<uint8_t> &bytes, bool *out) {
+  switch (type) {
+  case Types::True:
+    *out = true;
+    return true;
+  case Types::False:
+    *out = false;
+    return true;
+  case Types::Boolean: {
+    uint8_t value = 0;
+    if (!ReadExactly(bytes, &value)) {
+      return false;
+    }
+    *out = value != 0;
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+Status WriteBoolean(bool value, Code type, Descriptor *out) {
+  if (type == Types::Boolean) {
+    const uint8_t byte = value ? 1 : 0;
+    return MakeData(type, &byte, sizeof(byte), out);
+  }
+  if ((type == Types::True && value) || (type == Types::False && !value)) {
+    return MakeData(type, nullptr, 0, out);
+  }
+  return Errors::CoercionFail;
+}
+
+bool EqualsIgnoringCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (std::tolower(static_cast<unsigned char>(a[i])) !=
+        std::tolower(static_cast<unsigned char>(b[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status CoerceData(Code fromType, const std::vector<uint8_t> &bytes,
+                  Code toType, Descriptor *out) {
+  if (IsCodeType(fromType) && IsCodeType(toType)) {
+    if (bytes.size() != sizeof(Code)) {
+      return Errors::CorruptData;
+    }
+    return MakeData(toType, bytes.data(), bytes.size(), out);
+  }
+
+  if (IsTextType(fromType)) {
+    const std::string text = ReadText(fromType, bytes);
+    if (IsTextType(toType)) {
+      return WriteText(text, toType, out);
+    }
+    if (IsNumericType(toType)) {
+      Number number;
+      if (!ParseNumber(text, &number)) {
+        return Errors::CoercionFail;
+      }
+      return WriteNumber(number, toType, out);
+    }
+    if (IsBooleanType(toType)) {
+      const std::string_view trimmed = Trim(text);
+      if (EqualsIgnoringCase(trimmed, "true")) {
+        return WriteBoolean(true, toType, out);
+      }
+      if (EqualsIgnoringCase(trimmed, "false")) {
+        return WriteBoolean(false, toType, out);
+      }
+    }
+    return Errors::CoercionFail;
+  }
+
+  if (IsNumericType(fromType)) {
+    Number number;
+    if (!ReadNumber(fromType, bytes, &number)) {
+      return Errors::CorruptData;
+    }
+    if (IsNumericType(toType)) {
+      return WriteNumber(number, toType, out);
+    }
+    if (IsTextType(toType)) {
+      return WriteText(FormatNumber(number), toType, out);
+    }
+    if (IsBooleanType(toType)) {
+      int64_t value = 0;
+      if (!ConvertNumber(number, &value) || (value != 0 && value != 1)) {
+        return Errors::CoercionFail;
+      }
+      return WriteBoolean(value == 1, toType, out);
+    }
+    return Errors::CoercionFail;
+  }
+
+  if (IsBooleanType(fromType)) {
+    bool value = false;
+    if (!ReadBoolean(fromType, bytes, &value)) {
+      return Errors::CorruptData;
+    }
+    if (IsBooleanType(toType)) {
+      return WriteBoolean(value, toType, out);
+    }
+    if (IsNumericType(toType)) {
+      Number number;
+      number.s = value ? 1 : 0;
+      return WriteNumber(number, toType, out);
+    }
+    if (IsTextType(toType)) {
+      return WriteText(value ? "true" : "false", toType, out);
+    }
+  }
+
+  return Errors::CoercionFail;
+}
+
+Status WrapInList(const Descriptor &source, Descriptor *out) {
+  Status status = CreateList(false, out);
+  if (status == Errors::NoErr) {
+    status = PutDesc(out, 0, source);
+  }
+  if (status != Errors::NoErr) {
+    Dispose(out);
+  }
+  return status;
+}
+
+std::atomic<uint16_t> nextReturnID{1};
+
+int16_t GenerateReturnID() {
+  uint16_t id = 0;
+  do {
+    id = nextReturnID.fetch_add(1, std::memory_order_relaxed);
+    // Skip the values that mean "none" and "auto-generate".
+  } while (id == 0 || static_cast<int16_t>(id) == AutoGenerateReturnID);
+  return static_cast<int16_t>(id);
+}
+} // namespace
+
+void Initialize(Descriptor *desc) {
+  desc->descriptorType = Types::Null;
+  desc->dataHandle = nullptr;
+}
+
+Status Dispose(Descriptor *desc) {
+  if (!desc) {
+    return Errors::ParamErr;
+  }
+  Release(desc->dataHandle);
+  Initialize(desc);
+  return Errors::NoErr;
+}
+
+Status Duplicate(const Descriptor &source, Descriptor *out) {
+  if (!out) {
+    return Errors::ParamErr;
+  }
+  *out = Share(source);
+  return Errors::NoErr;
+}
+
+CopyCounts GetCopyCounts() {
+  return {clonedNodes.load(std::memory_order_relaxed),
+          clonedBytes.load(std::memory_order_relaxed)};
+}
+
+Status CreateData(Code type, const void *data, size_t size, Descriptor *out) {
+  if (!out || (size > 0 && !data)) {
+    return Errors::ParamErr;
+  }
+  return Guarded([&] { return MakeData(type, data, size, out); });
+}
+
+Status ReplaceData(Code type, const void *data, size_t size,
+                   Descriptor *desc) {
+  if (!desc || (size > 0 && !data)) {
+    return Errors::ParamErr;
+  }
+  return Guarded([&] {
+    Descriptor replacement;
+    Status status = MakeData(type, data, size, &replacement);
+    if (status == Errors::NoErr) {
+      Dispose(desc);
+      *desc = replacement;
+    }
+    return status;
+  });
+}
+
+size_t DataSize(const Descriptor &desc) {
+  return HasKind(desc, Kind::Data) ? desc.dataHandle->bytes.size() : 0;
+}
+
+Status GetData(const Descriptor &desc, void *out, size_t maxSize) {
+  if (!desc.dataHandle) {
+    return Errors::NoErr;
+  }
+  if (!HasKind(desc, Kind::Data)) {
+    return Errors::WrongDataType;
+  }
+  const std::vector<uint8_t> &bytes = desc.dataHandle->bytes;
+  const size_t size = bytes.size() < maxSize ? bytes.size() : maxSize;
+  if (size > 0) {
+    std::memcpy(out, bytes.data(), size);
+  }
+  return Errors::NoErr;
+}
+
+Status GetDataRange(const Descriptor &desc, void *out, size_t offset,
+                    size_t length) {
+  if (!HasKind(desc, Kind::Data)) {
+    return Errors::WrongDataType;
+  }
+  const std::vector<uint8_t> &bytes = desc.dataHandle->bytes;
+  if (offset > bytes.size() || length > bytes.size() - offset) {
+    return Errors::ParamErr;
+  }
+  if (length > 0) {
+    std::memcpy(out, bytes.data() + offset, length);
+  }
+  return Errors::NoErr;
+}
+
+Status CreateList(bool isRecord, Descriptor *out) {
+  if (!out) {
+    return Errors::ParamErr;
+  }
+  return Guarded([&] {
+    out->dataHandle = new Node(isRecord ? Kind::Record : Kind::List);
+    out->descriptorType = isRecord ? Types::Record : Types::List;
+    return Errors::NoErr;
+  });
+}
+
+bool IsRecord(const Descriptor &desc) { return HasKind(desc, Kind::Record); }
+
+Status CountItems(const Descriptor &desc, long *outCount) {
+  const Node *node = NodeOf(desc);
+  if (!node || node->kind == Kind::Data) {
+    return Errors::WrongDataType;
+  }
+  *outCount = static_cast<long>(node->entries.size());
+  return Errors::NoErr;
+}
+
+Status GetNthDesc(const Descriptor &desc, long index, Code desiredType,
+                  Code *outKeyword, Descriptor *out) {
+  const Node *node = NodeOf(desc);
+  if (!node || node->kind == Kind::Data) {
+    return Errors::WrongDataType;
+  }
+  if (index < 1 || static_cast<size_t>(index) > node->entries.size()) {
+    return Errors::IllegalIndex;
+  }
+  const Entry &entry = node->entries[static_cast<size_t>(index - 1)];
+  if (outKeyword) {
+    *outKeyword = entry.keyword;
+  }
+  return Guarded([&] { return GetEntryValue(entry, desiredType, out); });
+}
+
+Status PeekNth(const Descriptor &desc, long index, Code *outKeyword,
+               Code *outType, size_t *outSize) {
+  const Node *node = NodeOf(desc);
+  if (!node || node->kind == Kind::Data) {
+    return Errors::WrongDataType;
+  }
+  if (index < 1 || static_cast<size_t>(index) > node->entries.size()) {
+    return Errors::IllegalIndex;
+  }
+  const Entry &entry = node->entries[static_cast<size_t>(index - 1)];
+  if (outKeyword) {
+    *outKeyword = entry.keyword;
+  }
+  PeekEntry(entry, outType, outSize);
+  return Errors::NoErr;
+}
+
+Status PutDesc(Descriptor *list, long index, const Descriptor &item) {
+  if (!list || !HasKind(*list, Kind::List)) {
+    return Errors::WrongDataType;
+  }
+  size_t count = list->dataHandle->entries.size();
+  if (index < 0 || static_cast<size_t>(index) > count + 1) {
+    return Errors::IllegalIndex;
+  }
+  return Guarded([&] {
+    Descriptor copy;
+    std::vector<Entry> &entries = ShareIntoMutable(list, item, &copy)->entries;
+    if (index == 0 || static_cast<size_t>(index) == entries.size() + 1) {
+      try {
+        entries.push_back({Types::WildCard, copy});
+      } catch (...) {
+        Dispose(&copy);
+        throw;
+      }
+      return Errors::NoErr;
+    }
+    Entry &existing = entries[static_cast<size_t>(index - 1)];
+    Dispose(&existing.value);
+    existing.value = copy;
+    return Errors::NoErr;
+  });
+}
+
+Status DeleteItem(Descriptor *list, long index) {
+  if (!list || !list->dataHandle || list->dataHandle->kind == Kind::Data) {
+    return Errors::WrongDataType;
+  }
+  if (index < 1 ||
+      static_cast<size_t>(index) > list->dataHandle->entries.size()) {
+    return Errors::IllegalIndex;
+  }
+  return Guarded([&] {
+    std::vector<Entry> &entries = MutableNode(list)->entries;
+    auto it = entries.begin() + (index - 1);
+    Dispose(&it->value);
+    entries.erase(it);
+    return Errors::NoErr;
+  });
+}
+
+Status GetKeyDesc(const Descriptor &desc, Code keyword, Code desiredType,
+                  Descriptor *out) {
+  if (!IsKeyed(desc)) {
+    return Errors::WrongDataType;
+  }
+  const Entry *entry = FindEntry(desc.dataHandle->entries, keyword);
+  if (!entry) {
+    return Errors::DescNotFound;
+  }
+  return Guarded([&] { return GetEntryValue(*entry, desiredType, out); });
+}
+
+Status PeekKey(const Descriptor &desc, Code keyword, Code *outType,
+               size_t *outSize) {
+  if (!IsKeyed(desc)) {
+    return Errors::WrongDataType;
+  }
+  const Entry *entry = FindEntry(desc.dataHandle->entries, keyword);
+  if (!entry) {
+    return Errors::DescNotFound;
+  }
+  PeekEntry(*entry, outType, outSize);
+  return Errors::NoErr;
+}
+
+Status PutKeyDesc(Descriptor *desc, Code keyword, const Descriptor &item) {
+  if (!desc || !IsKeyed(*desc)) {
+    return Errors::WrongDataType;
+  }
+  return Guarded([&] {
+    Descriptor copy;
+    Node *node = ShareIntoMutable(desc, item, &copy);
+    return PutEntry(node->entries, keyword, copy);
+  });
+}
+
+Status DeleteKeyDesc(Descriptor *desc, Code keyword) {
+  if (!desc || !IsKeyed(*desc)) {
+    return Errors::WrongDataType;
+  }
+  if (!FindEntry(desc->dataHandle->entries, keyword)) {
+    return Errors::DescNotFound;
+  }
+  return Guarded([&] {
+    std::vector<Entry> &entries = MutableNode(desc)->entries;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->keyword == keyword) {
+        Dispose(&it->value);
+        entries.erase(it);
+        break;
+      }
+    }
+    return Errors::NoErr;
+  });
+}
+
+Status CreateAppleEvent(Code eventClass, Code eventID,
+                        const Descriptor *target, int16_t returnID,
+                        int32_t transactionID, Descriptor *out) {
+  if (!out) {
+    return Errors::ParamErr;
+  }
+  return Guarded([&] {
+    Descriptor event;
+    event.descriptorType = Types::AppleEvent;
+    event.dataHandle = new Node(Kind::Event);
+
+    if (returnID == AutoGenerateReturnID) {
+      returnID = GenerateReturnID();
+    }
+    Descriptor nullTarget;
+    Initialize(&nullTarget);
+
+    Descriptor attribute;
+    Status status = Errors::NoErr;
+    auto put = [&](Code keyword, Code type, const void *data, size_t size) {
+      if (status == Errors::NoErr) {
+        status = MakeData(type, data, size, &attribute);
+      }
+      if (status == Errors::NoErr) {
+        status = PutEntry(event.dataHandle->attributes, keyword, attribute);
+      }
+    };
+    put(Keywords::EventClassAttr, Types::Type, &eventClass,
+        sizeof(eventClass));
+    put(Keywords::EventIDAttr, Types::Type, &eventID, sizeof(eventID));
+    put(Keywords::ReturnIDAttr, Types::SInt16, &returnID, sizeof(returnID));
+    put(Keywords::TransactionIDAttr, Types::SInt32, &transactionID,
+        sizeof(transactionID));
+    if (status == Errors::NoErr) {
+      status = PutEntry(event.dataHandle->attributes, Keywords::AddressAttr,
+                        Share(target ? *target : nullTarget));
+    }
+
+    if (status != Errors::NoErr) {
+      Dispose(&event);
+      return status;
+    }
+    *out = event;
+    return Errors::NoErr;
+  });
+}
+
+Status GetAttributeDesc(const Descriptor &event, Code keyword,
+                        Code desiredType, Descriptor *out) {
+  if (!HasKind(event, Kind::Event)) {
+    return Errors::NotAppleEvent;
+  }
+  const Entry *entry = FindEntry(event.dataHandle->attributes, keyword);
+  if (!entry) {
+    return Errors::DescNotFound;
+  }
+  return Guarded([&] { return GetEntryValue(*entry, desiredType, out); });
+}
+
+Status PutAttributeDesc(Descriptor *event, Code keyword,
+                        const Descriptor &value) {
+  if (!event || !HasKind(*event, Kind::Event)) {
+    return Errors::NotAppleEvent;
+  }
+  return Guarded([&] {
+    Descriptor copy;
+    Node *node = ShareIntoMutable(event, value, &copy);
+    return PutEntry(node->attributes, keyword, copy);
+  });
+}
+
+Status Coerce(const Descriptor &source, Code toType, Descriptor *out) {
+  if (!out) {
+    return Errors::ParamErr;
+  }
+  return Guarded([&] {
+    Descriptor result;
+    Initialize(&result);
+    Status status = Errors::CoercionFail;
+
+    const Node *node = NodeOf(source);
+    if (toType == Types::WildCard || toType == source.descriptorType) {
+      status = Duplicate(source, &result);
+    } else if (!node) {
+      status = Errors::CoercionFail;
+    } else if (toType == Types::List && node->kind != Kind::List) {
+      status = WrapInList(source, &result);
+    } else {
+      switch (node->kind) {
+      case Kind::Data:
+        status = CoerceData(source.descriptorType, node->bytes, toType,
+                            &result);
+        break;
+      case Kind::List:
+        // A single-item list coerces like its only item.
+        if (node->entries.size() == 1) {
+          status = Coerce(node->entries[0].value, toType, &result);
+        }
+        break;
+      case Kind::Record:
+        // Records can take on any type while keeping their fields.
+        if (toType != Types::AppleEvent) {
+          status = Duplicate(source, &result);
+          result.descriptorType = toType;
+        }
+        break;
+      case Kind::Event:
+        break;
+      }
+    }
+
+    if (status != Errors::NoErr) {
+      Dispose(&result);
+      Initialize(out);
+      return status;
+    }
+    *out = result;
+    return Errors::NoErr;
+  });
+}
+
+class Stream {
+public:
+  Stream() { Initialize(&result); }
+  Stream(const Stream &) = delete;
+  Stream &operator=(const Stream &) = delete;
+
+  ~Stream() {
+    for (Frame &frame : frames) {
+      Dispose(&frame.container);
+    }
+    Dispose(&result);
+  }
+
+  struct Frame {
+    Descriptor container;
+    Code pendingKeyword = 0;
+    bool hasPendingKeyword = false;
+  };
+
+  // Every operation goes through here so that the first failure sticks.
+  template <typename Fn> Status Run(Fn &&fn) {
+    if (status == Errors::NoErr) {
+      status = Guarded(fn);
+    }
+    return status;
+  }
+
+  // Takes ownership of `value`, disposing it if it can't be placed.
+  Status Place(Descriptor value) {
+    if (frames.empty()) {
+      if (hasResult) {
+        Dispose(&value);
+        return Errors::StreamBadNesting;
+      }
+      result = value;
+      hasResult = true;
+      return Errors::NoErr;
+    }
+    Frame &frame = frames.back();
+    Node *node = frame.container.dataHandle;
+    Code keyword = Types::WildCard;
+    if (node->kind == Kind::Record) {
+      if (!frame.hasPendingKeyword) {
+        Dispose(&value);
+        return Errors::StreamBadNesting;
+      }
+      keyword = frame.pendingKeyword;
+      frame.hasPendingKeyword = false;
+    }
+    try {
+      node->entries.push_back({keyword, value});
+    } catch (...) {
+      Dispose(&value);
+      throw;
+    }
+    return Errors::NoErr;
+  }
+
+  Status Open(bool isRecord, Code type) {
+    Descriptor container;
+    Status openStatus = CreateList(isRecord, &container);
+    if (openStatus != Errors::NoErr) {
+      return openStatus;
+    }
+    container.descriptorType = type;
+    try {
+      frames.push_back({container});
+    } catch (...) {
+      Dispose(&container);
+      throw;
+    }
+    return Errors::NoErr;
+  }
+
+  Status Close(Kind kind) {
+    if (frames.empty() || frames.back().container.dataHandle->kind != kind ||
+        frames.back().hasPendingKeyword) {
+      return Errors::StreamBadNesting;
+    }
+    Descriptor container = frames.back().container;
+    frames.pop_back();
+    return Place(container);
+  }
+
+  std::vector<Frame> frames;
+  Descriptor result;
+  bool hasResult = false;
+  Status status = Errors::NoErr;
+};
+
+Stream *OpenStream() { return new (std::nothrow) Stream(); }
+
+Status CloseStream(Stream *stream, Descriptor *out) {
+  if (!stream) {
+    return Errors::ParamErr;
+  }
+  Status status = stream->status;
+  if (status == Errors::NoErr && !stream->frames.empty()) {
+    status = Errors::StreamBadNesting;
+  }
+  if (out) {
+    Initialize(out);
+    if (status == Errors::NoErr) {
+      std::swap(*out, stream->result);
+    }
+  }
+  delete stream;
+  return status;
+}
+
+Status StreamOpenList(Stream *stream) {
+  return stream->Run([&] { return stream->Open(false, Types::List); });
+}
+
+Status StreamCloseList(Stream *stream) {
+  return stream->Run([&] { return stream->Close(Kind::List); });
+}
+
+Status StreamOpenRecord(Stream *stream, Code type) {
+  return stream->Run([&] { return stream->Open(true, type); });
+}
+
+Status StreamCloseRecord(Stream *stream) {
+  return stream->Run([&] { return stream->Close(Kind::Record); });
+}
+
+Status StreamWriteKey(Stream *stream, Code keyword) {
+  return stream->Run([&] {
+    if (stream->frames.empty() ||
+        stream->frames.back().container.dataHandle->kind != Kind::Record ||
+        stream->frames.back().hasPendingKeyword) {
+      return Errors::StreamBadNesting;
+    }
+    stream->frames.back().pendingKeyword = keyword;
+    stream->frames.back().hasPendingKeyword = true;
+    return Errors::NoErr;
+  });
+}
+
+Status StreamWriteData(Stream *stream, Code type, const void *data,
+                       size_t size) {
+  if (size > 0 && !data) {
+    return Errors::ParamErr;
+  }
+  return stream->Run([&] {
+    Descriptor value;
+    Status status = MakeData(type, data, size, &value);
+    return status == Errors::NoErr ? stream->Place(value) : status;
+  });
+}
+
+Status StreamWriteDesc(Stream *stream, const Descriptor &desc) {
+  return stream->Run([&] { return stream->Place(Share(desc)); });
+}
+
+namespace {
+constexpr Code FlattenedMagic = MakeCode("dle2");
+// Lists and records say which of the two they are, so that a record that has
+//  been given another type can be told apart from data of that type.
+constexpr size_t ListHeaderSize = 16;
+constexpr uint32_t EventVersion = 0x00010001;
+constexpr size_t EventHeaderSize = 12;
+// Separates an event's attributes from its parameters.
+constexpr Code EventParamsMarker = MakeCode(";;;;");
+// Matches the nesting limit of the bridge's own builders.
+constexpr uint32_t MaxFlattenedDepth = 1024;
+
+size_t Padded(size_t size) { return size + (size & 1); }
+
+size_t ItemSize(const Descriptor &desc);
+
+size_t EntriesSize(const std::vector<Entry> &entries, bool keyed) {
+  size_t size = 0;
+  for (const Entry &entry : entries) {
+    size += (keyed ? 4 : 0) + ItemSize(entry.value);
+  }
+  return size;
+}
+
+// What follows a descriptor's type and size, before padding.
+size_t BodySize(const Descriptor &desc) {
+  const Node *node = NodeOf(desc);
+  if (!node) {
+    return 0;
+  }
+  switch (node->kind) {
+  case Kind::Data:
+    return node->bytes.size();
+  case Kind::List:
+    return ListHeaderSize + EntriesSize(node->entries, false);
+  case Kind::Record:
+    return ListHeaderSize + EntriesSize(node->entries, true);
+  case Kind::Event:
+    return EventHeaderSize + EntriesSize(node->attributes, true) + 4 +
+           EntriesSize(node->entries, true);
+  }
+  return 0;
+}
+
+// type, size, then the body padded to an even length.
+size_t ItemSize(const Descriptor &desc) { return 8 + Padded(BodySize(desc)); }
+
+class Writer {
+public:
+  explicit Writer(uint8_t *out) : cursor(out) {}
+
+  void U32(uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      *cursor++ = static_cast<uint8_t>(value >> shift);
+    }
+  }
+
+  void Entries(const std::vector<Entry> &entries, bool keyed) {
+    for (const Entry &entry : entries) {
+      if (keyed) {
+        U32(entry.keyword);
+      }
+      Item(entry.value);
+    }
+  }
+
+  // The size goes in once the body has been written, so that nothing is
+  //  measured twice however deep the tree.
+  void Item(const Descriptor &desc) {
+    U32(desc.descriptorType);
+    uint8_t *const sizeField = cursor;
+    cursor += 4;
+    uint8_t *const body = cursor;
+    Body(desc);
+    const size_t size = static_cast<size_t>(cursor - body);
+    Writer(sizeField).U32(static_cast<uint32_t>(size));
+    if (size & 1) {
+      *cursor++ = 0;
+    }
+  }
+
+private:
+  void Body(const Descriptor &desc) {
+    const Node *node = NodeOf(desc);
+    if (!node) {
+      return;
+    }
+    switch (node->kind) {
+    case Kind::Data:
+      if (!node->bytes.empty()) {
+        std::memcpy(cursor, node->bytes.data(), node->bytes.size());
+        cursor += node->bytes.size();
+      }
+      break;
+    case Kind::List:
+    case Kind::Record: {
+      const bool isRecord = node->kind == Kind::Record;
+      // No factored prefix, and a reserved word.
+      U32(0);
+      U32(0);
+      U32(isRecord ? Types::Record : Types::List);
+      U32(static_cast<uint32_t>(node->entries.size()));
+      Entries(node->entries, isRecord);
+      break;
+    }
+    case Kind::Event:
+      U32(EventVersion);
+      U32(static_cast<uint32_t>(node->attributes.size()));
+      U32(static_cast<uint32_t>(node->entries.size()));
+      Entries(node->attributes, true);
+      U32(EventParamsMarker);
+      Entries(node->entries, true);
+      break;
+    }
+  }
+
+  uint8_t *cursor;
+};
+
+// Reads flattened descriptors, checking every size against what is left of
+//  the input. Given a null descriptor to read into, it only checks.
+class Reader {
+public:
+  Reader(const uint8_t *data, size_t size) : cursor(data), end(data + size) {}
+
+  bool AtEnd() const { return cursor == end; }
+
+  bool U32(uint32_t *out) {
+    if (Remaining() < 4) {
+      return false;
+    }
+    *out = 0;
+    for (int i = 0; i < 4; ++i) {
+      *out = (*out << 8) | *cursor++;
+    }
+    return true;
+  }
+
+  // Throws `std::bad_alloc`; on failure `out` may hold a partial tree for the
+  //  caller to dispose.
+  bool Item(Descriptor *out, uint32_t depth) {
+    if (out) {
+      Initialize(out);
+    }
+    uint32_t type = 0;
+    uint32_t size = 0;
+    if (depth > MaxFlattenedDepth || !U32(&type) || !U32(&size) ||
+        Padded(size) > Remaining()) {
+      return false;
+    }
+    Reader body(cursor, size);
+    cursor += Padded(size);
+    if (out) {
+      out->descriptorType = type;
+    }
+
+    if (type == Types::List || type == Types::Record ||
+        type == Types::AppleEvent) {
+      return body.Structured(type, out, depth) && body.AtEnd();
+    }
+    // Any other type holds data, unless it is a retyped record (or list)
+    //  whose header says so.
+    if (body.HasListHeader()) {
+      Reader attempt = body;
+      Descriptor structured;
+      Initialize(&structured);
+      bool ok = false;
+      try {
+        ok = attempt.Structured(type, out ? &structured : nullptr, depth) &&
+             attempt.AtEnd();
+      } catch (...) {
+        Dispose(&structured);
+        throw;
+      }
+      if (ok) {
+        if (out) {
+          out->dataHandle = structured.dataHandle;
+        }
+        return true;
+      }
+      Dispose(&structured);
+    }
+    if (out && (size > 0 || type != Types::Null)) {
+      auto node = std::make_unique<Node>(Kind::Data);
+      node->bytes.assign(body.cursor, body.end);
+      out->dataHandle = node.release();
+    }
+    return true;
+  }
+
+private:
+  size_t Remaining() const { return static_cast<size_t>(end - cursor); }
+
+  bool HasListHeader() const {
+    if (Remaining() < ListHeaderSize) {
+      return false;
+    }
+    Reader header = *this;
+    uint32_t prefix = 0;
+    uint32_t reserved = 0;
+    uint32_t listClass = 0;
+    return header.U32(&prefix) && header.U32(&reserved) &&
+           header.U32(&listClass) && prefix == 0 && reserved == 0 &&
+           (listClass == Types::List || listClass == Types::Record);
+  }
+
+  bool Entries(std::vector<Entry> *entries, uint32_t count, bool keyed,
+               uint32_t depth) {
+    // Every entry takes at least 8 bytes, or 12 with a keyword, which bounds
+    //  `count` by the input before anything is reserved for it.
+    if (count > Remaining() / (keyed ? 12 : 8)) {
+      return false;
+    }
+    if (entries) {
+      entries->reserve(count);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      Entry entry{0, {Types::Null, nullptr}};
+      if (keyed && !U32(&entry.keyword)) {
+        return false;
+      }
+      const bool ok = Item(entries ? &entry.value : nullptr, depth + 1);
+      if (entries) {
+        // `reserve` above means this can't throw.
+        entries->push_back(entry);
+      }
+      if (!ok) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The body of a list, record or event of `type`.
+  bool Structured(Code type, Descriptor *out, uint32_t depth) {
+    if (type == Types::AppleEvent) {
+      uint32_t version = 0;
+      uint32_t attributeCount = 0;
+      uint32_t paramCount = 0;
+      if (!U32(&version) || version != EventVersion ||
+          !U32(&attributeCount) || !U32(&paramCount)) {
+        return false;
+      }
+      Node *node = nullptr;
+      if (out) {
+        node = new Node(Kind::Event);
+        out->dataHandle = node;
+      }
+      uint32_t marker = 0;
+      return Entries(node ? &node->attributes : nullptr, attributeCount, true,
+                     depth) &&
+             U32(&marker) && marker == EventParamsMarker &&
+             Entries(node ? &node->entries : nullptr, paramCount, true, depth);
+    }
+
+    uint32_t prefix = 0;
+    uint32_t reserved = 0;
+    uint32_t listClass = 0;
+    uint32_t count = 0;
+    if (!U32(&prefix) || !U32(&reserved) || !U32(&listClass) ||
+        !U32(&count) || prefix != 0 || reserved != 0 ||
+        (listClass != Types::List && listClass != Types::Record)) {
+      return false;
+    }
+    const bool isRecord = listClass == Types::Record;
+    Node *node = nullptr;
+    if (out) {
+      node = new Node(isRecord ? Kind::Record : Kind::List);
+      out->dataHandle = node;
+    }
+    return Entries(node ? &node->entries : nullptr, count, isRecord, depth);
+  }
+
+  const uint8_t *cursor;
+  const uint8_t *end;
+};
+
+// Reads `size` bytes of flattened descriptor into `out`, or only checks them
+//  if `out` is null.
+Status Read(const void *data, size_t size, Descriptor *out) {
+  size_t expectedSize = 0;
+  if (!data || size < FlattenedHeaderSize ||
+      FlattenedSizeFromHeader(data, &expectedSize) != Errors::NoErr ||
+      expectedSize != size) {
+    return Errors::CorruptData;
+  }
+  // Skips the magic and the reserved word, leaving the root item.
+  Reader reader(static_cast<const uint8_t *>(data) + 8, size - 8);
+  if (!out) {
+    return reader.Item(nullptr, 0) && reader.AtEnd() ? Errors::NoErr
+                                                     : Errors::CorruptData;
+  }
+  return Guarded([&] {
+    Descriptor result;
+    Initialize(&result);
+    bool ok = false;
+    try {
+      ok = reader.Item(&result, 0) && reader.AtEnd();
+    } catch (...) {
+      Dispose(&result);
+      throw;
+    }
+    if (!ok) {
+      Dispose(&result);
+      return Errors::CorruptData;
+    }
+    *out = result;
+    return Errors::NoErr;
+  });
+}
+} // namespace
+
+size_t FlattenedSize(const Descriptor &desc) { return 8 + ItemSize(desc); }
+
+Status Flatten(const Descriptor &desc, void *out, size_t size,
+               size_t *outWritten) {
+  const size_t flattenedSize = FlattenedSize(desc);
+  if (flattenedSize > std::numeric_limits<uint32_t>::max()) {
+    return Errors::ParamErr;
+  }
+  if (!out || size < flattenedSize) {
+    return Errors::BufferTooSmall;
+  }
+  Writer writer(static_cast<uint8_t *>(out));
+  writer.U32(FlattenedMagic);
+  writer.U32(0);
+  writer.Item(desc);
+  if (outWritten) {
+    *outWritten = flattenedSize;
+  }
+  return Errors::NoErr;
+}
+
+Status FlattenedSizeFromHeader(const void *header, size_t *outSize) {
+  Reader reader(static_cast<const uint8_t *>(header), FlattenedHeaderSize);
+  uint32_t magic = 0;
+  uint32_t reserved = 0;
+  uint32_t type = 0;
+  uint32_t size = 0;
+  if (!reader.U32(&magic) || magic != FlattenedMagic ||
+      !reader.U32(&reserved) || !reader.U32(&type) || !reader.U32(&size)) {
+    return Errors::CorruptData;
+  }
+  *outSize = FlattenedHeaderSize + Padded(size);
+  return Errors::NoErr;
+}
+
+Status Unflatten(const void *data, size_t size, Descriptor *out) {
+  if (!out) {
+    return Errors::ParamErr;
+  }
+  Initialize(out);
+  return Read(data, size, out);
+}
+
+Status CheckFlattened(const void *data, size_t size) {
+  return Read(data, size, nullptr);
+}
+} // namespace DescriptorEngine
+} // namespace ae_js_bridge
@@ -0,0 +1,198 @@
+#pragma once
+
+// A self-contained descriptor engine, with no dependency on CoreServices. It
+//  models the same null, data, list, record and event descriptors the Apple
+//  Event Manager does, and its functions mirror the AE Manager's so that
+//  `AEPortable.h` can expose it under the usual names. This lets the bridge be
+//  built, profiled and load-tested on platforms without CoreServices.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ae_js_bridge {
+namespace DescriptorEngine {
+using Code = uint32_t;
+using Status = int16_t;
+
+consteval Code MakeCode(const char (&text)[5]) {
+  return (static_cast<Code>(static_cast<uint8_t>(text[0])) << 24) |
+         (static_cast<Code>(static_cast<uint8_t>(text[1])) << 16) |
+         (static_cast<Code>(static_cast<uint8_t>(text[2])) << 8) |
+         static_cast<Code>(static_cast<uint8_t>(text[3]));
+}
+
+// The values match their CoreServices counterparts.
+namespace Types {
+inline constexpr Code Null = MakeCode("null");
+inline constexpr Code WildCard = MakeCode("****");
+inline constexpr Code List = MakeCode("list");
+inline constexpr Code Record = MakeCode("reco");
+inline constexpr Code AppleEvent = MakeCode("aevt");
+inline constexpr Code SInt16 = MakeCode("shor");
+inline constexpr Code SInt32 = MakeCode("long");
+inline constexpr Code SInt64 = MakeCode("comp");
+inline constexpr Code UInt16 = MakeCode("ushr");
+inline constexpr Code UInt32 = MakeCode("magn");
+inline constexpr Code UInt64 = MakeCode("ucom");
+inline constexpr Code Float32 = MakeCode("sing");
+inline constexpr Code Float64 = MakeCode("doub");
+inline constexpr Code Boolean = MakeCode("bool");
+inline constexpr Code True = MakeCode("true");
+inline constexpr Code False = MakeCode("fals");
+inline constexpr Code Char = MakeCode("TEXT");
+inline constexpr Code UTF8Text = MakeCode("utf8");
+inline constexpr Code UnicodeText = MakeCode("utxt");
+inline constexpr Code Type = MakeCode("type");
+inline constexpr Code Enumerated = MakeCode("enum");
+inline constexpr Code Keyword = MakeCode("keyw");
+inline constexpr Code Property = MakeCode("prop");
+} // namespace Types
+
+namespace Keywords {
+inline constexpr Code EventClassAttr = MakeCode("evcl");
+inline constexpr Code EventIDAttr = MakeCode("evid");
+inline constexpr Code AddressAttr = MakeCode("addr");
+inline constexpr Code ReturnIDAttr = MakeCode("rtid");
+inline constexpr Code TransactionIDAttr = MakeCode("tran");
+} // namespace Keywords
+
+namespace Errors {
+inline constexpr Status NoErr = 0;
+inline constexpr Status ParamErr = -50;
+inline constexpr Status MemFullErr = -108;
+inline constexpr Status CoercionFail = -1700;
+inline constexpr Status DescNotFound = -1701;
+inline constexpr Status CorruptData = -1702;
+inline constexpr Status WrongDataType = -1703;
+inline constexpr Status NotAEDesc = -1704;
+inline constexpr Status BadListItem = -1705;
+inline constexpr Status NotAppleEvent = -1707;
+inline constexpr Status IllegalIndex = -1719;
+inline constexpr Status StreamBadNesting = -1726;
+inline constexpr Status BufferTooSmall = -1741;
+inline constexpr Status StreamAlreadyConverted = -1727;
+} // namespace Errors
+
+// Passing this as a return ID asks `CreateAppleEvent` to pick a unique one.
+inline constexpr int16_t AutoGenerateReturnID = -1;
+
+class Node;
+
+// Laid out like CoreServices' `AEDesc`, so the portable AE API can hand it out
+//  as-is. A descriptor holds a reference to its node; null descriptors have
+//  none. Nodes are shared copy-on-write, so duplicating a descriptor (or
+//  putting it into a list) is O(1), and only a mutation through a descriptor
+//  whose node is shared pays for a copy of that one node.
+struct Descriptor {
+  Code descriptorType;
+  Node *dataHandle;
+};
+
+void Initialize(Descriptor *desc);
+Status Dispose(Descriptor *desc);
+// Shares `source`'s node with `out` rather than copying it.
+Status Duplicate(const Descriptor &source, Descriptor *out);
+
+// How much copying copy-on-write has had to do so far, across all threads.
+struct CopyCounts {
+  uint64_t clonedNodes;
+  uint64_t clonedBytes;
+};
+CopyCounts GetCopyCounts();
+
+Status CreateData(Code type, const void *data, size_t size, Descriptor *out);
+Status ReplaceData(Code type, const void *data, size_t size, Descriptor *desc);
+// Returns 0 for descriptors that aren't data descriptors.
+size_t DataSize(const Descriptor &desc);
+Status GetData(const Descriptor &desc, void *out, size_t maxSize);
+Status GetDataRange(const Descriptor &desc, void *out, size_t offset,
+                    size_t length);
+
+Status CreateList(bool isRecord, Descriptor *out);
+bool IsRecord(const Descriptor &desc);
+// Counts list items, record fields or event parameters.
+Status CountItems(const Descriptor &desc, long *outCount);
+// `index` is one-based. Items are coerced to `desiredType` unless it is the
+//  wild card.
+Status GetNthDesc(const Descriptor &desc, long index, Code desiredType,
+                  Code *outKeyword, Descriptor *out);
+// `index` 0 (or one past the end) appends, like `AEPutDesc`.
+Status PutDesc(Descriptor *list, long index, const Descriptor &item);
+Status DeleteItem(Descriptor *list, long index);
+// Reads an item's keyword, type and data size without copying it. Any of the
+//  out-parameters may be null.
+Status PeekNth(const Descriptor &desc, long index, Code *outKeyword,
+               Code *outType, size_t *outSize);
+
+// Keyed access to record fields and event parameters.
+Status GetKeyDesc(const Descriptor &desc, Code keyword, Code desiredType,
+                  Descriptor *out);
+Status PutKeyDesc(Descriptor *desc, Code keyword, const Descriptor &item);
+Status DeleteKeyDesc(Descriptor *desc, Code keyword);
+// Like `PeekNth`, for the first field with `keyword`.
+Status PeekKey(const Descriptor &desc, Code keyword, Code *outType,
+               size_t *outSize);
+
+Status CreateAppleEvent(Code eventClass, Code eventID,
+                        const Descriptor *target, int16_t returnID,
+                        int32_t transactionID, Descriptor *out);
+Status GetAttributeDesc(const Descriptor &event, Code keyword,
+                        Code desiredType, Descriptor *out);
+Status PutAttributeDesc(Descriptor *event, Code keyword,
+                        const Descriptor &value);
+
+// Supports identity coercions, conversions between the numeric, boolean and
+//  text types, retyping records, and wrapping a descriptor in a list.
+Status Coerce(const Descriptor &source, Code toType, Descriptor *out);
+
+// CoreServices' flattened form, behind the portable `AEFlattenDesc` and
+//  `AEUnflattenDesc`, so that `serialize()` output moves between platforms.
+//  Everything is big-endian: 'dle2' and a reserved word, then the root
+//  descriptor. Each descriptor is its type, the size of its body, then the
+//  body padded to an even length. List and record bodies start with a
+//  16-byte header ending in 'list' or 'reco' and the item count, and record
+//  items are led by their keywords; event bodies hold their attributes, ';;;;'
+//  and their parameters.
+//
+// The header covers the root descriptor's type and size, which is enough to
+//  tell how long the whole thing is.
+inline constexpr size_t FlattenedHeaderSize = 16;
+size_t FlattenedSize(const Descriptor &desc);
+// Fails with `BufferTooSmall` if `size` is less than `FlattenedSize(desc)`.
+Status Flatten(const Descriptor &desc, void *out, size_t size,
+               size_t *outWritten);
+// Reads the total size of a flattened descriptor from its header, which must
+//  be `FlattenedHeaderSize` readable bytes.
+Status FlattenedSizeFromHeader(const void *header, size_t *outSize);
+// Checks everything it reads against `size`, so truncated or malformed input
+//  fails with `CorruptData` instead of reading out of bounds.
+Status Unflatten(const void *data, size_t size, Descriptor *out);
+// Reads `size` bytes as `Unflatten` would, without building anything. This
+//  lets input meant for CoreServices' `AEUnflattenDesc`, which takes no
+//  length, be bounds-checked first.
+Status CheckFlattened(const void *data, size_t size);
+
+// Builds a descriptor front to back, like the AE Manager's `AEStream`
+//  functions. Each item is written straight into its enclosing list or record,
+//  so building a collection of n items is linear rather than copying the
+//  collection as it grows. Once an operation fails, the rest fail the same way.
+class Stream;
+
+// Returns null when out of memory.
+Stream *OpenStream();
+// Frees the stream. Unless `out` is null, it receives the single descriptor
+//  that was written, or a null descriptor if nothing was.
+Status CloseStream(Stream *stream, Descriptor *out);
+Status StreamOpenList(Stream *stream);
+Status StreamCloseList(Stream *stream);
+Status StreamOpenRecord(Stream *stream, Code type);
+Status StreamCloseRecord(Stream *stream);
+// Sets the keyword of the next field written to the innermost record. Like
+//  `AEStream`, keywords aren't checked for duplicates.
+Status StreamWriteKey(Stream *stream, Code keyword);
+Status StreamWriteData(Stream *stream, Code type, const void *data,
+                       size_t size);
+// Writes a copy of `desc`.
+Status StreamWriteDesc(Stream *stream, const Descriptor &desc);
+} // namespace DescriptorEngine
+} // namespace ae_js_bridge
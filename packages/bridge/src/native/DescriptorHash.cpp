@@ -0,0 +1,155 @@
+#include "DescriptorHash.h"
+
+#include <cstring>
+#include <memory>
+
+namespace ae_js_bridge {
+namespace DescriptorHash {
+namespace {
+constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// Every platform the bridge targets is little-endian, which is the byte order
+//  XXH64 is defined in.
+inline uint64_t Read64(const uint8_t *p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Read32(const uint8_t *p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint64_t Round(uint64_t accumulator, uint64_t input) {
+  accumulator += input * kPrime2;
+  accumulator = RotateLeft(accumulator, 31);
+  return accumulator * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t hash, uint64_t lane) {
+  hash ^= Round(0, lane);
+  return hash * kPrime1 + kPrime4;
+}
+
+// Flattens `desc` into a fresh, uninitialized buffer.
+OSStatus Flatten(const AEDesc *desc, std::unique_ptr<char[]> *outBytes,
+                 Size *outSize) {
+  const Size size = AESizeOfFlattenedDesc(desc);
+  std::unique_ptr<char[]> bytes(new char[static_cast<size_t>(size)]);
+  OSStatus err = AEFlattenDesc(desc, bytes.get(), size, nullptr);
+  if (err != noErr) {
+    return err;
+  }
+  *outBytes = std::move(bytes);
+  *outSize = size;
+  return noErr;
+}
+} // namespace
+
+uint64_t HashBytes(const void *data, size_t size, uint64_t seed) {
+  const auto *p = static_cast<const uint8_t *>(data);
+  const uint8_t *const end = p + size;
+  uint64_t hash;
+
+  if (size >= 32) {
+    uint64_t lane1 = seed + kPrime1 + kPrime2;
+    uint64_t lane2 = seed + kPrime2;
+    uint64_t lane3 = seed;
+    uint64_t lane4 = seed - kPrime1;
+    const uint8_t *const limit = end - 32;
+    do {
+      lane1 = Round(lane1, Read64(p));
+      lane2 = Round(lane2, Read64(p + 8));
+      lane3 = Round(lane3, Read64(p + 16));
+      lane4 = Round(lane4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    hash = RotateLeft(lane1, 1) + RotateLeft(lane2, 7) +
+           RotateLeft(lane3, 12) + RotateLeft(lane4, 18);
+    hash = MergeRound(hash, lane1);
+    hash = MergeRound(hash, lane2);
+    hash = MergeRound(hash, lane3);
+    hash = MergeRound(hash, lane4);
+  } else {
+    hash = seed + kPrime5;
+  }
+
+  hash += static_cast<uint64_t>(size);
+  for (; end - p >= 8; p += 8) {
+    hash ^= Round(0, Read64(p));
+    hash = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+  }
+  if (end - p >= 4) {
+    hash ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+    hash = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    hash ^= static_cast<uint64_t>(*p) * kPrime5;
+    hash = RotateLeft(hash, 11) * kPrime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+OSStatus HashDescriptor(const AEDesc *desc, uint64_t *outHash) {
+  std::unique_ptr<char[]> bytes;
+  Size size = 0;
+  OSStatus err = Flatten(desc, &bytes, &size);
+  if (err != noErr) {
+    return err;
+  }
+  *outHash = HashBytes(bytes.get(), static_cast<size_t>(size));
+  return noErr;
+}
+
+OSStatus DescriptorsEqual(const AEDesc *a, const AEDesc *b, bool *outEqual) {
+  *outEqual = false;
+  if (a->descriptorType != b->descriptorType) {
+    return noErr;
+  }
+  if (a == b || a->dataHandle == b->dataHandle) {
+    *outEqual = true;
+    return noErr;
+  }
+
+  // The flattened size covers the whole tree, so comparing it first rules out
+  //  most unequal pairs without flattening either side.
+  const Size size = AESizeOfFlattenedDesc(a);
+  if (size != AESizeOfFlattenedDesc(b)) {
+    return noErr;
+  }
+
+  std::unique_ptr<char[]> aBytes;
+  std::unique_ptr<char[]> bBytes;
+  Size aSize = 0;
+  Size bSize = 0;
+  OSStatus err = Flatten(a, &aBytes, &aSize);
+  if (err == noErr) {
+    err = Flatten(b, &bBytes, &bSize);
+  }
+  if (err != noErr) {
+    return err;
+  }
+  *outEqual = aSize == bSize &&
+              std::memcmp(aBytes.get(), bBytes.get(),
+                          static_cast<size_t>(aSize)) == 0;
+  return noErr;
+}
+} // namespace DescriptorHash
+} // namespace ae_js_bridge
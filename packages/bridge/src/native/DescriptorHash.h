@@ -0,0 +1,24 @@
+#pragma once
+
+#include "AEPlatform.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Nothing here knows about JS, so on the portable engine it builds (and can be
+//  benchmarked) anywhere.
+namespace ae_js_bridge {
+namespace DescriptorHash {
+// XXH64 of `size` bytes. Its four independent lanes keep the main loop free
+//  of cross-iteration dependencies, so it runs at memory speed.
+uint64_t HashBytes(const void *data, size_t size, uint64_t seed = 0);
+
+// Hashes the flattened form of `desc`, which covers its type, its data and
+//  everything nested in it, in order.
+OSStatus HashDescriptor(const AEDesc *desc, uint64_t *outHash);
+
+// Structural equality: same types, same data, same children in the same
+//  order. Bails out as soon as a type or a size differs.
+OSStatus DescriptorsEqual(const AEDesc *a, const AEDesc *b, bool *outEqual);
+} // namespace DescriptorHash
+} // namespace ae_js_bridge
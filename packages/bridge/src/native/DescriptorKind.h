@@ -0,0 +1,27 @@
+#pragma once
+
+#include "AEPlatform.h"
+
+namespace ae_js_bridge {
+namespace Descriptors {
+enum class DescriptorKind {
+  Null,
+  Data,
+  List,
+  Record,
+  Event,
+  Unknown,
+};
+
+// Classifies `desc` by its type code where that is enough: the structural
+//  types, a fixed table of well-known data and record types, and any other
+//  type code already seen. Only the first descriptor of an unfamiliar type
+//  costs `AECountItems`/`AECheckIsRecord` probes.
+DescriptorKind GetDescriptorKind(const AEDesc *desc);
+
+// Records that the bridge just built a descriptor of `type` with the given
+//  kind. Descriptors can be given any type code, so a type that turns out to
+//  be used for more than one kind is probed every time from then on.
+void NoteDescriptorKind(DescType type, DescriptorKind kind);
+} // namespace Descriptors
+} // namespace ae_js_bridge
@@ -0,0 +1,176 @@
+#include "DescriptorKind.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace ae_js_bridge {
+namespace Descriptors {
+namespace {
+template <size_t N>
+constexpr std::array<DescType, N> Sorted(std::array<DescType, N> types) {
+  std::sort(types.begin(), types.end());
+  return types;
+}
+
+// Types that are plain data whenever the AE Manager produces them.
+constexpr auto kDataTypes = Sorted(std::to_array<DescType>({
+    typeSInt16,
+    typeSInt32,
+    typeSInt64,
+    typeUInt16,
+    typeUInt32,
+    typeUInt64,
+    typeIEEE32BitFloatingPoint,
+    typeIEEE64BitFloatingPoint,
+    type128BitFloatingPoint,
+    typeDecimalStruct,
+    typeBoolean,
+    typeTrue,
+    typeFalse,
+    typeChar,
+    typeUTF8Text,
+    typeUnicodeText,
+    typeUTF16ExternalRepresentation,
+    typeType,
+    typeEnumerated,
+    typeKeyword,
+    typeProperty,
+    typeAbsoluteOrdinal,
+    typeLongDateTime,
+    typeData,
+    typeFileURL,
+    typeFSRef,
+    typeAlias,
+    typeBookmarkData,
+    typeApplicationBundleID,
+    typeApplicationURL,
+    typeKernelProcessID,
+    typeProcessSerialNumber,
+}));
+
+// Types that are (coerced) records whenever the AE Manager produces them.
+constexpr auto kRecordTypes = Sorted(std::to_array<DescType>({
+    typeAERecord,
+    typeObjectSpecifier,
+    typeInsertionLoc,
+    typeRangeDescriptor,
+    typeCompDescriptor,
+    typeLogicalDescriptor,
+    typeWhoseDescriptor,
+}));
+
+struct KindMemo {
+  DescriptorKind kind;
+  // Set once the type has been seen with more than one kind.
+  bool ambiguous;
+};
+
+std::mutex memoMutex;
+std::unordered_map<DescType, KindMemo> memo;
+// Lets the table lookups skip the memo until the bridge has built a
+//  descriptor that contradicts them.
+std::atomic<bool> hasAmbiguousTypes{false};
+
+// The kind `type` is known to have without probing, or `Unknown`.
+DescriptorKind StaticKind(DescType type) {
+  switch (type) {
+  case typeNull:
+    return DescriptorKind::Null;
+  case typeAppleEvent:
+    return DescriptorKind::Event;
+  case typeAEList:
+    return DescriptorKind::List;
+  default:
+    break;
+  }
+  if (std::binary_search(kDataTypes.begin(), kDataTypes.end(), type)) {
+    return DescriptorKind::Data;
+  }
+  if (std::binary_search(kRecordTypes.begin(), kRecordTypes.end(), type)) {
+    return DescriptorKind::Record;
+  }
+  return DescriptorKind::Unknown;
+}
+
+DescriptorKind ProbeDescriptorKind(const AEDesc *desc) {
+  long itemCount = 0;
+  OSErr err = AECountItems(desc, &itemCount);
+  if (err == errAEWrongDataType) {
+    return DescriptorKind::Data;
+  } else if (err != noErr) {
+    return DescriptorKind::Unknown;
+  }
+  return AECheckIsRecord(desc) ? DescriptorKind::Record : DescriptorKind::List;
+}
+} // namespace
+
+DescriptorKind GetDescriptorKind(const AEDesc *desc) {
+  if (!desc) {
+    return DescriptorKind::Unknown;
+  }
+  const DescType type = desc->descriptorType;
+  // Null descriptors and events can't be anything else.
+  if (type == typeNull) {
+    return DescriptorKind::Null;
+  }
+  if (type == typeAppleEvent) {
+    return DescriptorKind::Event;
+  }
+
+  DescriptorKind staticKind = StaticKind(type);
+  if (staticKind != DescriptorKind::Unknown &&
+      !hasAmbiguousTypes.load(std::memory_order_acquire)) {
+    return staticKind;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(memoMutex);
+    auto it = memo.find(type);
+    if (it != memo.end()) {
+      if (!it->second.ambiguous) {
+        return it->second.kind;
+      }
+      staticKind = DescriptorKind::Unknown;
+    }
+  }
+  if (staticKind != DescriptorKind::Unknown) {
+    return staticKind;
+  }
+
+  const DescriptorKind probedKind = ProbeDescriptorKind(desc);
+  if (probedKind != DescriptorKind::Unknown) {
+    std::lock_guard<std::mutex> lock(memoMutex);
+    // Never overwrite an ambiguous entry.
+    memo.try_emplace(type, KindMemo{probedKind, false});
+  }
+  return probedKind;
+}
+
+void NoteDescriptorKind(DescType type, DescriptorKind kind) {
+  if (type == typeNull || type == typeAppleEvent ||
+      kind == DescriptorKind::Unknown) {
+    return;
+  }
+  const DescriptorKind staticKind = StaticKind(type);
+  if (staticKind == kind && !hasAmbiguousTypes.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(memoMutex);
+  auto [it, inserted] = memo.try_emplace(type, KindMemo{kind, false});
+  if (inserted) {
+    if (staticKind == DescriptorKind::Unknown || staticKind == kind) {
+      return;
+    }
+    it->second.ambiguous = true;
+  } else if (it->second.kind == kind || it->second.ambiguous) {
+    return;
+  }
+  it->second.ambiguous = true;
+  hasAmbiguousTypes.store(true, std::memory_order_release);
+}
+} // namespace Descriptors
+} // namespace ae_js_bridge
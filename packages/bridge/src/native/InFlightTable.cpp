@@ -0,0 +1,131 @@
+#include "InFlightTable.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace ae_js_bridge {
+InFlightTable::InFlightTable() : epoch(Clock::now()) {}
+
+bool InFlightTable::Insert(int16_t returnID, void *cookie,
+                           Clock::time_point deadline) {
+  if (!cookie) {
+    return false;
+  }
+  Slot &slot = slots[IndexOf(returnID)];
+  uint64_t expected = kEmpty;
+  if (!slot.state.compare_exchange_strong(expected, kClaimed,
+                                          std::memory_order_acquire)) {
+    return false;
+  }
+  size.fetch_add(1, std::memory_order_relaxed);
+  slot.cookie = cookie;
+  slot.state.store(Encode(deadline), std::memory_order_release);
+  return true;
+}
+
+void *InFlightTable::Take(int16_t returnID) {
+  Slot &slot = slots[IndexOf(returnID)];
+  uint64_t state;
+  if (!Claim(slot, &state)) {
+    return nullptr;
+  }
+  return Release(slot);
+}
+
+bool InFlightTable::Remove(int16_t returnID, void *cookie) {
+  Slot &slot = slots[IndexOf(returnID)];
+  uint64_t state;
+  if (!Claim(slot, &state)) {
+    return false;
+  }
+  if (slot.cookie != cookie) {
+    slot.state.store(state, std::memory_order_release);
+    return false;
+  }
+  Release(slot);
+  return true;
+}
+
+size_t InFlightTable::Sweep(
+    Clock::time_point now,
+    const std::function<void(int16_t, void *)> &onExpired) {
+  if (Size() == 0) {
+    return 0;
+  }
+  const uint64_t cutoff = Cutoff(now);
+  size_t expired = 0;
+  for (size_t index = 0; index < kSlots; ++index) {
+    Slot &slot = slots[index];
+    uint64_t state = slot.state.load(std::memory_order_relaxed);
+    if (state == kEmpty || state == kClaimed || state == kNoDeadline ||
+        state > cutoff) {
+      continue;
+    }
+    if (!slot.state.compare_exchange_strong(state, kClaimed,
+                                            std::memory_order_acquire)) {
+      // Taken, removed or replaced in the meantime; a replacement is at
+      //  least as new as this sweep, so it can wait for the next one.
+      continue;
+    }
+    void *cookie = Release(slot);
+    ++expired;
+    onExpired(static_cast<int16_t>(static_cast<uint16_t>(index)), cookie);
+  }
+  return expired;
+}
+
+// Deadlines are kept as milliseconds since the table was created, offset past
+//  the two reserved states, and rounded up so nothing expires early.
+uint64_t InFlightTable::Encode(Clock::time_point deadline) const {
+  if (deadline == Clock::time_point::max()) {
+    return kNoDeadline;
+  }
+  const auto sinceEpoch = std::chrono::ceil<std::chrono::milliseconds>(
+      std::max(deadline, epoch) - epoch);
+  return std::min<uint64_t>(kNoDeadline - 1,
+                            static_cast<uint64_t>(sinceEpoch.count()) + 2);
+}
+
+// `Encode` for the time a sweep runs at, rounded down instead: rounding both
+//  up would expire a deadline later in the same millisecond as `now` early.
+uint64_t InFlightTable::Cutoff(Clock::time_point now) const {
+  if (now == Clock::time_point::max()) {
+    return kNoDeadline;
+  }
+  const auto sinceEpoch = std::chrono::floor<std::chrono::milliseconds>(
+      std::max(now, epoch) - epoch);
+  return std::min<uint64_t>(kNoDeadline - 1,
+                            static_cast<uint64_t>(sinceEpoch.count()) + 2);
+}
+
+// Takes a waiting slot over, so that nobody else can empty it. A slot that
+//  is claimed already is only held for a few instructions, so this waits for
+//  it rather than miss a request that is still being filled in.
+bool InFlightTable::Claim(Slot &slot, uint64_t *outState) {
+  uint64_t state = slot.state.load(std::memory_order_relaxed);
+  for (;;) {
+    if (state == kEmpty) {
+      return false;
+    }
+    if (state == kClaimed) {
+      std::this_thread::yield();
+      state = slot.state.load(std::memory_order_relaxed);
+      continue;
+    }
+    if (slot.state.compare_exchange_weak(state, kClaimed,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+      *outState = state;
+      return true;
+    }
+  }
+}
+
+void *InFlightTable::Release(Slot &slot) {
+  void *cookie = slot.cookie;
+  slot.cookie = nullptr;
+  slot.state.store(kEmpty, std::memory_order_release);
+  size.fetch_sub(1, std::memory_order_relaxed);
+  return cookie;
+}
+} // namespace ae_js_bridge
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace ae_js_bridge {
+// Requests waiting for a queued reply, in one slot per return ID. A reply
+//  finds its request by the return ID it carries, with no locks taken on any
+//  path (slots are claimed with a compare-and-swap), so thousands of requests
+//  can wait without holding a thread each.
+//
+// Each slot holds an opaque cookie and a deadline. Whoever empties a slot
+//  (`Take` when the reply arrives, `Remove` when the request gives up, or
+//  `Sweep` once the deadline has passed) gets the cookie, and exactly one of
+//  them ever does.
+//
+// Nothing here knows about Apple events or JS, so it builds (and can be
+//  exercised) anywhere.
+class InFlightTable {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // One per value of a 16-bit return ID.
+  static constexpr size_t kSlots = 1 << 16;
+
+  InFlightTable();
+
+  InFlightTable(const InFlightTable &) = delete;
+  InFlightTable &operator=(const InFlightTable &) = delete;
+
+  // Parks `cookie` (not null) on `returnID` until `deadline`;
+  //  `Clock::time_point::max()` never expires. Returns false if a request is
+  //  already waiting on that return ID.
+  bool Insert(int16_t returnID, void *cookie, Clock::time_point deadline);
+
+  // Empties `returnID`'s slot and returns its cookie, or null if nothing is
+  //  waiting on it.
+  void *Take(int16_t returnID);
+
+  // Empties `returnID`'s slot only if `cookie` is what's waiting on it.
+  bool Remove(int16_t returnID, void *cookie);
+
+  // Empties every slot whose deadline is at or before `now`, passing each
+  //  return ID and cookie to `onExpired`. Returns how many expired.
+  size_t Sweep(Clock::time_point now,
+               const std::function<void(int16_t, void *)> &onExpired);
+
+  // Requests waiting, including any being inserted or taken right now.
+  size_t Size() const { return size.load(std::memory_order_relaxed); }
+
+private:
+  // A slot's state: empty, claimed by someone in the middle of filling or
+  //  emptying it, or waiting with a deadline.
+  static constexpr uint64_t kEmpty = 0;
+  static constexpr uint64_t kClaimed = 1;
+  static constexpr uint64_t kNoDeadline = UINT64_MAX;
+
+  struct Slot {
+    std::atomic<uint64_t> state{kEmpty};
+    // Only read or written by whoever holds the slot `kClaimed`.
+    void *cookie = nullptr;
+  };
+
+  static size_t IndexOf(int16_t returnID) {
+    return static_cast<uint16_t>(returnID);
+  }
+  uint64_t Encode(Clock::time_point deadline) const;
+  uint64_t Cutoff(Clock::time_point now) const;
+  bool Claim(Slot &slot, uint64_t *outState);
+  void *Release(Slot &slot);
+
+  const Clock::time_point epoch;
+  std::array<Slot, kSlots> slots;
+  std::atomic<size_t> size{0};
+};
+} // namespace ae_js_bridge
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "AEPlatform.h"
+#include "ValueConversion.h"
+#include "helpers.h"
+
+#include <napi.h>
+
+namespace ae_js_bridge {
+namespace Descriptors {
+struct ListBatchOptions {
+  // Items per batch. Bounds both the items held natively at once and how long
+  //  the JS thread spends turning one batch into JS values.
+  long batchSize = 1024;
+  // Whether the next batch is read while the current one is being consumed.
+  //  Without it, nothing is read until `next()` asks for it.
+  bool readAhead = true;
+  // Whether batches hold `toJSValue()` results instead of wrappers.
+  bool values = false;
+  ValueConversion::ToJSValueOptions valueOptions;
+};
+
+// Reads `{ batchSize?, readAhead?, values? }`, where `values` is a boolean or
+//  `toJSValue` options.
+bool ReadListBatchOptionsOrThrow(Napi::Env env, const Napi::Value &value,
+                                 ListBatchOptions *outOptions);
+
+// Builds an async iterator over the first `count` items of `list`, yielding
+//  arrays of up to `batchSize` items. Items are copied out of the list and
+//  classified (or, in values mode, decoded) on a worker thread; only wrapping
+//  them (or materializing their values) happens on the JS thread. At most one
+//  batch is held natively at a time.
+Napi::Object MakeListBatchIterator(Napi::Env env, SharedAEDesc list,
+                                   long count,
+                                   const ListBatchOptions &options);
+} // namespace Descriptors
+} // namespace ae_js_bridge
@@ -0,0 +1,321 @@
+#include "ListBatchIterator.h"
+
+#include "AEDescriptor.h"
+#include "DescriptorKind.h"
+#include "OSError.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ae_js_bridge {
+namespace Descriptors {
+namespace {
+// Large enough for any sensible batch, small enough that one batch can't
+//  pin an unbounded amount of memory.
+constexpr long kMaxBatchSize = 1 << 20;
+
+// Items copied out of the list on a worker thread, waiting to be wrapped, or
+//  in values mode already decoded there and waiting to be materialized.
+struct Batch {
+  Batch() = default;
+  Batch(const Batch &) = delete;
+  Batch &operator=(const Batch &) = delete;
+  ~Batch() {
+    for (AEDesc &item : items) {
+      AEDisposeDesc(&item);
+    }
+  }
+
+  std::vector<AEDesc> items;
+  std::vector<DescriptorKind> kinds;
+  std::vector<std::unique_ptr<ValueConversion::DecodedTree>> trees;
+};
+
+// Everything below runs on the JS thread, except `ReadBatchWorker::Execute`,
+//  which only touches its own batch, its copy of the options and the
+//  (immutable) list.
+class ListBatchIterator
+    : public std::enable_shared_from_this<ListBatchIterator> {
+public:
+  ListBatchIterator(SharedAEDesc list, long count,
+                    const ListBatchOptions &options)
+      : list(std::move(list)), count(count), options(options) {}
+
+  Napi::Value Next(Napi::Env env) {
+    Napi::Promise::Deferred waiter = Napi::Promise::Deferred::New(env);
+    waiters.push_back(waiter);
+    Pump(env);
+    return waiter.Promise();
+  }
+
+  Napi::Value Return(Napi::Env env) {
+    closed = true;
+    ready.reset();
+    failure.Reset();
+    Pump(env);
+    Napi::Promise::Deferred done = Napi::Promise::Deferred::New(env);
+    done.Resolve(Done(env));
+    return done.Promise();
+  }
+
+  void OnBatchRead(Napi::Env env, std::unique_ptr<Batch> batch) {
+    reading = false;
+    if (!closed) {
+      ready = std::move(batch);
+    }
+    Pump(env);
+  }
+
+  void OnBatchFailed(Napi::Env env, Napi::Value error) {
+    reading = false;
+    if (!closed) {
+      failure = Napi::Persistent(error);
+    }
+    Pump(env);
+  }
+
+private:
+  // Settles as many waiting `next()` calls as possible, then starts the next
+  //  read if anyone is (or, with read-ahead, soon will be) waiting for it.
+  void Pump(Napi::Env env) {
+    while (!waiters.empty()) {
+      Napi::Promise::Deferred waiter = waiters.front();
+      if (!failure.IsEmpty()) {
+        waiters.pop_front();
+        waiter.Reject(failure.Value());
+        failure.Reset();
+        closed = true;
+      } else if (ready) {
+        waiters.pop_front();
+        std::unique_ptr<Batch> batch = std::move(ready);
+        Napi::Value value = Materialize(env, *batch);
+        if (env.IsExceptionPending()) {
+          Napi::Error error = env.GetAndClearPendingException();
+          waiter.Reject(error.Value());
+          closed = true;
+        } else {
+          waiter.Resolve(Result(env, value));
+        }
+      } else if (closed || (nextIndex >= count && !reading)) {
+        waiters.pop_front();
+        waiter.Resolve(Done(env));
+      } else {
+        break;
+      }
+    }
+
+    const bool wanted = !waiters.empty() || options.readAhead;
+    if (wanted && !closed && !reading && !ready && nextIndex < count) {
+      StartRead(env);
+    }
+  }
+
+  void StartRead(Napi::Env env);
+
+  Napi::Value Materialize(Napi::Env env, Batch &batch) {
+    const size_t size =
+        options.values ? batch.trees.size() : batch.items.size();
+    Napi::Array result = Napi::Array::New(env, static_cast<uint32_t>(size));
+    for (size_t index = 0; index < size; ++index) {
+      Napi::Value value;
+      if (options.values) {
+        value = ValueConversion::MaterializeDecodedTreeOrThrow(
+            env, batch.trees[index].get());
+      } else {
+        AEDesc &item = batch.items[index];
+        // The wrapper takes the item over; what's left is disposed of
+        //  harmlessly along with the batch.
+        value = WrapSharedAEDescOrThrow(env, AdoptAEDesc(new AEDesc(item)),
+                                        batch.kinds[index]);
+        AEInitializeDesc(&item);
+      }
+      if (env.IsExceptionPending()) {
+        return env.Undefined();
+      }
+      result.Set(static_cast<uint32_t>(index), value);
+    }
+    return result;
+  }
+
+  static Napi::Object Result(Napi::Env env, Napi::Value value) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("done", Napi::Boolean::New(env, false));
+    result.Set("value", value);
+    return result;
+  }
+
+  static Napi::Object Done(Napi::Env env) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("done", Napi::Boolean::New(env, true));
+    result.Set("value", env.Undefined());
+    return result;
+  }
+
+  SharedAEDesc list;
+  long count;
+  ListBatchOptions options;
+  // The first item not yet handed to a worker.
+  long nextIndex = 0;
+  bool reading = false;
+  bool closed = false;
+  std::unique_ptr<Batch> ready;
+  Napi::Reference<Napi::Value> failure;
+  std::deque<Napi::Promise::Deferred> waiters;
+};
+
+class ReadBatchWorker : public Napi::AsyncWorker {
+public:
+  ReadBatchWorker(Napi::Env env, std::shared_ptr<ListBatchIterator> iterator,
+                  SharedAEDesc list, long start, long end,
+                  const ListBatchOptions &options)
+      : Napi::AsyncWorker(env), iterator(std::move(iterator)),
+        list(std::move(list)), start(start), end(end), options(options) {}
+
+  void Execute() override {
+    batch = std::make_unique<Batch>();
+    const size_t size = static_cast<size_t>(end - start);
+    if (options.values) {
+      batch->trees.reserve(size);
+    } else {
+      batch->items.reserve(size);
+      batch->kinds.reserve(size);
+    }
+    for (long index = start; index < end; ++index) {
+      AEDesc item;
+      OSErr err =
+          AEGetNthDesc(list.get(), index + 1, typeWildCard, nullptr, &item);
+      if (err != noErr) {
+        errorCode = err;
+        SetError("AEGetNthDesc failed");
+        return;
+      }
+      const DescriptorKind kind = GetDescriptorKind(&item);
+      if (options.values) {
+        // Decoded here, so the JS thread only builds the values. A decoding
+        //  error stays in the tree, and is thrown when it is materialized.
+        auto tree = std::make_unique<ValueConversion::DecodedTree>();
+        ValueConversion::DecodeDescTree(&item, kind, options.valueOptions,
+                                        tree.get());
+        AEDisposeDesc(&item);
+        batch->trees.push_back(std::move(tree));
+      } else {
+        batch->items.push_back(item);
+        batch->kinds.push_back(kind);
+      }
+    }
+  }
+
+  void OnOK() override { iterator->OnBatchRead(Env(), std::move(batch)); }
+
+  void OnError(const Napi::Error &error) override {
+    iterator->OnBatchFailed(Env(),
+                            OSError::New(Env(), errorCode, error.Message()));
+  }
+
+private:
+  std::shared_ptr<ListBatchIterator> iterator;
+  SharedAEDesc list;
+  long start;
+  long end;
+  ListBatchOptions options;
+  std::unique_ptr<Batch> batch;
+  OSErr errorCode = noErr;
+};
+
+void ListBatchIterator::StartRead(Napi::Env env) {
+  const long end = std::min(count, nextIndex + options.batchSize);
+  auto *worker = new ReadBatchWorker(env, shared_from_this(), list,
+                                     nextIndex, end, options);
+  reading = true;
+  nextIndex = end;
+  worker->Queue();
+}
+} // namespace
+
+bool ReadListBatchOptionsOrThrow(Napi::Env env, const Napi::Value &value,
+                                 ListBatchOptions *outOptions) {
+  if (value.IsUndefined()) {
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "iterate options must be an object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Object object = value.As<Napi::Object>();
+
+  Napi::Value batchSize = object.Get("batchSize");
+  if (!batchSize.IsUndefined()) {
+    const double size =
+        batchSize.IsNumber() ? batchSize.As<Napi::Number>().DoubleValue() : 0;
+    if (!(size >= 1 && size <= kMaxBatchSize) || size != std::floor(size)) {
+      Napi::TypeError::New(env,
+                           "batchSize must be an integer from 1 to " +
+                               std::to_string(kMaxBatchSize))
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    outOptions->batchSize = static_cast<long>(size);
+  }
+
+  Napi::Value readAhead = object.Get("readAhead");
+  if (!readAhead.IsUndefined()) {
+    if (!readAhead.IsBoolean()) {
+      Napi::TypeError::New(env, "readAhead must be a boolean")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    outOptions->readAhead = readAhead.As<Napi::Boolean>().Value();
+  }
+
+  Napi::Value values = object.Get("values");
+  if (values.IsBoolean()) {
+    outOptions->values = values.As<Napi::Boolean>().Value();
+  } else if (values.IsObject()) {
+    outOptions->values = true;
+    return ValueConversion::ReadToJSValueOptionsOrThrow(
+        env, values, &outOptions->valueOptions);
+  } else if (!values.IsUndefined()) {
+    Napi::TypeError::New(env,
+                         "values must be a boolean or toJSValue options")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+Napi::Object MakeListBatchIterator(Napi::Env env, SharedAEDesc list,
+                                   long count,
+                                   const ListBatchOptions &options) {
+  auto state =
+      std::make_shared<ListBatchIterator>(std::move(list), count, options);
+
+  Napi::Object iterator = Napi::Object::New(env);
+  iterator.Set("next",
+               Napi::Function::New(
+                   env,
+                   [state](const Napi::CallbackInfo &info) -> Napi::Value {
+                     return state->Next(info.Env());
+                   },
+                   "next"));
+  iterator.Set("return",
+               Napi::Function::New(
+                   env,
+                   [state](const Napi::CallbackInfo &info) -> Napi::Value {
+                     return state->Return(info.Env());
+                   },
+                   "return"));
+  iterator.Set(Napi::Symbol::WellKnown(env, "asyncIterator"),
+               Napi::Function::New(
+                   env, [](const Napi::CallbackInfo &info) -> Napi::Value {
+                     return info.This();
+                   }));
+  return iterator;
+}
+} // namespace Descriptors
+} // namespace ae_js_bridge
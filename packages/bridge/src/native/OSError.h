@@ -1,11 +1,11 @@
 #pragma once
 
+#include "AEPlatform.h"
+
 #include <napi.h>
 
 #include <string>
 
-#include <MacTypes.h>
-
 namespace ae_js_bridge {
 
 class OSError {
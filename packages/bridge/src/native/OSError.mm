@@ -1,7 +1,5 @@
 #include "OSError.h"
 
-#include <CoreServices/CoreServices.h>
-
 #include <string>
 namespace ae_js_bridge {
 namespace {
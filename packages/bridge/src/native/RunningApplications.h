@@ -0,0 +1,21 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <string>
+
+namespace ae_js_bridge {
+// Running applications, as AppKit sees them. Kept apart from everything that
+//  includes `AEPlatform.h`, since AppKit brings CoreServices in with it and
+//  that would clash with the portable engine's declarations.
+namespace RunningApplications {
+// The process ID of a running application with `bundleID`, or 0 if none is
+//  running.
+pid_t FindProcessForBundleID(const std::string &bundleID);
+
+// Whether `pid` is still running and, unless `bundleID` is empty, is still an
+//  application with that bundle ID rather than something that has since been
+//  given the same process ID.
+bool IsProcessRunning(pid_t pid, const std::string &bundleID);
+} // namespace RunningApplications
+} // namespace ae_js_bridge
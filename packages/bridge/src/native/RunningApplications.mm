@@ -0,0 +1,43 @@
+#include "RunningApplications.h"
+
+#import <AppKit/AppKit.h>
+
+#include <cerrno>
+#include <signal.h>
+
+namespace ae_js_bridge {
+namespace RunningApplications {
+pid_t FindProcessForBundleID(const std::string &bundleID) {
+  @autoreleasepool {
+    NSString *identifier = [NSString stringWithUTF8String:bundleID.c_str()];
+    if (!identifier) {
+      return 0;
+    }
+    for (NSRunningApplication *application in [NSRunningApplication
+             runningApplicationsWithBundleIdentifier:identifier]) {
+      if (!application.terminated) {
+        return application.processIdentifier;
+      }
+    }
+    return 0;
+  }
+}
+
+bool IsProcessRunning(pid_t pid, const std::string &bundleID) {
+  if (pid <= 0) {
+    return false;
+  }
+  if (bundleID.empty()) {
+    // EPERM still means there is such a process, just not one of ours.
+    return kill(pid, 0) == 0 || errno == EPERM;
+  }
+  @autoreleasepool {
+    NSRunningApplication *application =
+        [NSRunningApplication runningApplicationWithProcessIdentifier:pid];
+    NSString *identifier = [NSString stringWithUTF8String:bundleID.c_str()];
+    return application && !application.terminated && identifier &&
+           [application.bundleIdentifier isEqualToString:identifier];
+  }
+}
+} // namespace RunningApplications
+} // namespace ae_js_bridge
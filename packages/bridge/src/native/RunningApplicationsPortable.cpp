@@ -0,0 +1,22 @@
+// Stands in for `RunningApplications.mm` where there is no AppKit. Nothing
+//  outside macOS has bundle IDs, so no application is ever found by one, and
+//  only the bare process ID check is left.
+
+#include "RunningApplications.h"
+
+#include <cerrno>
+#include <signal.h>
+
+namespace ae_js_bridge {
+namespace RunningApplications {
+pid_t FindProcessForBundleID(const std::string &) { return 0; }
+
+bool IsProcessRunning(pid_t pid, const std::string &bundleID) {
+  if (pid <= 0 || !bundleID.empty()) {
+    return false;
+  }
+  // EPERM still means there is such a process, just not one of ours.
+  return kill(pid, 0) == 0 || errno == EPERM;
+}
+} // namespace RunningApplications
+} // namespace ae_js_bridge
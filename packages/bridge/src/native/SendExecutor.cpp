@@ -0,0 +1,221 @@
+#include "SendExecutor.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ae_js_bridge {
+SendExecutor::SendExecutor(const Options &options)
+    : options(options), started(std::chrono::steady_clock::now()) {
+  this->options.threads = std::max(1u, this->options.threads);
+  this->options.queueCapacity =
+      std::max<size_t>(1, this->options.queueCapacity);
+  if (this->options.maxPerTarget == 0) {
+    this->options.maxPerTarget = std::max(1u, this->options.threads / 2);
+  }
+  if (this->options.maxQueuedPerTarget == 0) {
+    this->options.maxQueuedPerTarget =
+        std::max<size_t>(1, this->options.queueCapacity / 4);
+  }
+
+  workers.reserve(this->options.threads);
+  for (unsigned index = 0; index < this->options.threads; ++index) {
+    workers.push_back(std::make_unique<Worker>());
+  }
+  // Only started once every worker exists, since any of them may steal from
+  //  any other.
+  for (size_t index = 0; index < workers.size(); ++index) {
+    workers[index]->thread = std::thread([this, index] { Run(index); });
+  }
+}
+
+SendExecutor::~SendExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (const std::unique_ptr<Worker> &worker : workers) {
+    worker->thread.join();
+  }
+}
+
+bool SendExecutor::Submit(uint64_t target, Job job) {
+  // Spread targets over the threads, even when their keys only differ in the
+  //  high bits.
+  const uint64_t spread = target * 0x9E3779B97F4A7C15ull;
+  Worker &home = *workers[(spread >> 32) % workers.size()];
+  {
+    std::lock_guard<std::mutex> lock(home.mutex);
+    auto it = home.targets.find(target);
+    if (it != home.targets.end() &&
+        it->second.jobs.size() >= options.maxQueuedPerTarget) {
+      rejected.fetch_add(1, std::memory_order_relaxed);
+      rejectedForTarget.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    size_t depth = queued.load(std::memory_order_relaxed);
+    do {
+      if (depth >= options.queueCapacity) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!queued.compare_exchange_weak(depth, depth + 1,
+                                           std::memory_order_relaxed));
+
+    TargetQueue &queue =
+        it != home.targets.end() ? it->second : home.targets[target];
+    queue.jobs.push_back(std::move(job));
+    if (!queue.runnable && queue.running < options.maxPerTarget) {
+      home.runnable.push_back(target);
+      queue.runnable = true;
+    }
+  }
+  submitted.fetch_add(1, std::memory_order_relaxed);
+  Wake(false);
+  return true;
+}
+
+SendExecutor::Stats SendExecutor::GetStats() const {
+  Stats stats;
+  stats.queueDepth = queued.load(std::memory_order_relaxed);
+  stats.inFlight = inFlight.load(std::memory_order_relaxed);
+  stats.submitted = submitted.load(std::memory_order_relaxed);
+  stats.completed = completed.load(std::memory_order_relaxed);
+  stats.rejected = rejected.load(std::memory_order_relaxed);
+  stats.rejectedForTarget = rejectedForTarget.load(std::memory_order_relaxed);
+  stats.stolen = stolen.load(std::memory_order_relaxed);
+
+  const int64_t now = Elapsed();
+  stats.threads.reserve(workers.size());
+  for (const std::unique_ptr<Worker> &worker : workers) {
+    int64_t busy = worker->busyNanoseconds.load(std::memory_order_relaxed);
+    const int64_t since = worker->busySince.load(std::memory_order_relaxed);
+    if (since >= 0) {
+      busy += std::max<int64_t>(0, now - since);
+    }
+    ThreadStats thread;
+    thread.busy = std::chrono::nanoseconds(busy);
+    thread.utilization =
+        now > 0 ? std::min(1.0, static_cast<double>(busy) / now) : 0;
+    thread.completed = worker->completed.load(std::memory_order_relaxed);
+    stats.threads.push_back(thread);
+  }
+  return stats;
+}
+
+void SendExecutor::Run(size_t self) {
+  Worker &worker = *workers[self];
+  for (;;) {
+    uint64_t seen;
+    {
+      std::lock_guard<std::mutex> lock(wakeMutex);
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+    }
+
+    Entry entry;
+    if (!Take(self, &entry)) {
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      continue;
+    }
+
+    inFlight.fetch_add(1, std::memory_order_relaxed);
+    const int64_t start = Elapsed();
+    worker.busySince.store(start, std::memory_order_relaxed);
+    entry.job();
+    entry.job = nullptr;
+    worker.busyNanoseconds.fetch_add(Elapsed() - start,
+                                     std::memory_order_relaxed);
+    worker.busySince.store(-1, std::memory_order_relaxed);
+    worker.completed.fetch_add(1, std::memory_order_relaxed);
+    completed.fetch_add(1, std::memory_order_relaxed);
+    inFlight.fetch_sub(1, std::memory_order_relaxed);
+
+    FinishTarget(entry);
+  }
+}
+
+// Takes the next job of the first runnable target on this thread's own list,
+//  or else of the last one on another thread's. A target that can still run
+//  more goes to the back of its list, so the targets sharing a thread take
+//  turns.
+bool SendExecutor::Take(size_t self, Entry *outEntry) {
+  for (size_t offset = 0; offset < workers.size(); ++offset) {
+    const size_t index = (self + offset) % workers.size();
+    Worker &victim = *workers[index];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.runnable.empty()) {
+      continue;
+    }
+
+    uint64_t target;
+    if (offset == 0) {
+      target = victim.runnable.front();
+      victim.runnable.pop_front();
+    } else {
+      target = victim.runnable.back();
+      victim.runnable.pop_back();
+    }
+    TargetQueue &queue = victim.targets.find(target)->second;
+    *outEntry = {target, index, std::move(queue.jobs.front())};
+    queue.jobs.pop_front();
+    ++queue.running;
+    if (!queue.jobs.empty() && queue.running < options.maxPerTarget) {
+      victim.runnable.push_back(target);
+    } else {
+      queue.runnable = false;
+    }
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    if (offset != 0) {
+      stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+  return false;
+}
+
+void SendExecutor::FinishTarget(const Entry &entry) {
+  bool unblocked = false;
+  {
+    Worker &home = *workers[entry.home];
+    std::lock_guard<std::mutex> lock(home.mutex);
+    auto it = home.targets.find(entry.target);
+    TargetQueue &queue = it->second;
+    --queue.running;
+    if (!queue.jobs.empty()) {
+      if (!queue.runnable) {
+        home.runnable.push_back(entry.target);
+        queue.runnable = true;
+        unblocked = true;
+      }
+    } else if (queue.running == 0) {
+      home.targets.erase(it);
+    }
+  }
+  if (unblocked) {
+    Wake(false);
+  }
+}
+
+void SendExecutor::Wake(bool all) {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    ++generation;
+  }
+  if (all) {
+    wake.notify_all();
+  } else {
+    wake.notify_one();
+  }
+}
+
+int64_t SendExecutor::Elapsed() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - started)
+      .count();
+}
+} // namespace ae_js_bridge
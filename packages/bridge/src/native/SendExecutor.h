@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ae_js_bridge {
+// A fixed set of threads for blocking sends, kept apart from libuv's thread
+//  pool so that slow targets can't starve `fs`, `crypto` or `zlib`.
+//
+// Every job carries a target key. Jobs for one target queue up together on
+//  one thread, and idle threads steal from the others, but no more than
+//  `maxPerTarget` jobs for the same target ever run at once, and no more than
+//  `maxQueuedPerTarget` wait, so one unresponsive target can neither tie up
+//  every thread nor fill the queue for everyone else.
+//
+// Nothing here knows about Apple events or JS, so it builds (and can be
+//  exercised) anywhere.
+class SendExecutor {
+public:
+  struct Options {
+    unsigned threads = 4;
+    // Jobs waiting for a thread, across all targets.
+    size_t queueCapacity = 4096;
+    // Jobs for one target running at once; 0 means half the threads (but at
+    //  least one).
+    unsigned maxPerTarget = 0;
+    // Jobs for one target waiting for a thread; 0 means a quarter of
+    //  `queueCapacity` (but at least one).
+    size_t maxQueuedPerTarget = 0;
+  };
+
+  struct ThreadStats {
+    // Time spent running jobs since the executor started, including the job
+    //  running now, if any.
+    std::chrono::nanoseconds busy{0};
+    // `busy` as a fraction of the time since the executor started.
+    double utilization = 0;
+    uint64_t completed = 0;
+  };
+
+  struct Stats {
+    size_t queueDepth = 0;
+    size_t inFlight = 0;
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    // Jobs turned away because the queue, or their target's share of it, was
+    //  full.
+    uint64_t rejected = 0;
+    // Of `rejected`, those turned away by `maxQueuedPerTarget`.
+    uint64_t rejectedForTarget = 0;
+    // Jobs run by a thread other than the one they were queued on.
+    uint64_t stolen = 0;
+    std::vector<ThreadStats> threads;
+  };
+
+  using Job = std::function<void()>;
+
+  explicit SendExecutor(const Options &options);
+  // Waits for running jobs to finish; queued ones are dropped unrun.
+  ~SendExecutor();
+
+  SendExecutor(const SendExecutor &) = delete;
+  SendExecutor &operator=(const SendExecutor &) = delete;
+
+  // Queues `job` to run on one of the threads. Returns false, without taking
+  //  the job, when the queue or `target`'s share of it is full. Safe to call
+  //  from any thread.
+  bool Submit(uint64_t target, Job job);
+
+  Stats GetStats() const;
+  const Options &GetOptions() const { return options; }
+
+private:
+  struct Entry {
+    uint64_t target;
+    // The worker `target` queues on.
+    size_t home;
+    Job job;
+  };
+
+  struct TargetQueue {
+    std::deque<Job> jobs;
+    unsigned running = 0;
+    // Whether the target is in its worker's `runnable` list.
+    bool runnable = false;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    // The targets queueing on this worker that have jobs waiting or running,
+    //  guarded by `mutex`.
+    std::unordered_map<uint64_t, TargetQueue> targets;
+    // The targets that have jobs waiting and fewer than `maxPerTarget`
+    //  running, in the order they are taken in. Targets at their cap are left
+    //  out until a job of theirs finishes, so taking a job never has to look
+    //  past them. Guarded by `mutex`.
+    std::deque<uint64_t> runnable;
+    std::atomic<int64_t> busyNanoseconds{0};
+    // When the running job started (nanoseconds since `started`), or -1.
+    std::atomic<int64_t> busySince{-1};
+    std::atomic<uint64_t> completed{0};
+    std::thread thread;
+  };
+
+  void Run(size_t self);
+  bool Take(size_t self, Entry *outEntry);
+  void FinishTarget(const Entry &entry);
+  void Wake(bool all);
+  int64_t Elapsed() const;
+
+  Options options;
+  const std::chrono::steady_clock::time_point started;
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  // A thread that finds nothing it can run sleeps until `generation` moves:
+  //  on every submission, and on every completion that lets a target at its
+  //  cap run again.
+  std::mutex wakeMutex;
+  std::condition_variable wake;
+  uint64_t generation = 0;
+  bool stopping = false;
+
+  std::atomic<size_t> queued{0};
+  std::atomic<size_t> inFlight{0};
+  std::atomic<uint64_t> submitted{0};
+  std::atomic<uint64_t> completed{0};
+  std::atomic<uint64_t> rejected{0};
+  std::atomic<uint64_t> rejectedForTarget{0};
+  std::atomic<uint64_t> stolen{0};
+};
+} // namespace ae_js_bridge
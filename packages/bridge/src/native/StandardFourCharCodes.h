@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AEPlatform.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace ae_js_bridge {
+namespace StandardFourCharCodes {
+consteval FourCharCode FromLiteral(const char (&text)[5]) {
+  return (static_cast<FourCharCode>(static_cast<uint8_t>(text[0])) << 24) |
+         (static_cast<FourCharCode>(static_cast<uint8_t>(text[1])) << 16) |
+         (static_cast<FourCharCode>(static_cast<uint8_t>(text[2])) << 8) |
+         static_cast<FourCharCode>(static_cast<uint8_t>(text[3]));
+}
+
+#define AEJS_FOUR_CHAR_CODE(name, text)                                        \
+  static_assert(static_cast<FourCharCode>(name) == FromLiteral(text),          \
+                #name " doesn't match StandardFourCharCodes.def");
+#include "StandardFourCharCodes.def"
+#undef AEJS_FOUR_CHAR_CODE
+
+struct Entry {
+  std::string_view name;
+  FourCharCode code;
+};
+
+// Every code in `StandardFourCharCodes.def`, in file order.
+inline constexpr Entry kAll[] = {
+#define AEJS_FOUR_CHAR_CODE(name, text) {#name, name},
+#include "StandardFourCharCodes.def"
+#undef AEJS_FOUR_CHAR_CODE
+};
+} // namespace StandardFourCharCodes
+} // namespace ae_js_bridge
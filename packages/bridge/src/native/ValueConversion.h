@@ -0,0 +1,149 @@
+#pragma once
+
+#include "AEPlatform.h"
+#include "DescriptorKind.h"
+
+#include <napi.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ae_js_bridge {
+namespace ValueConversion {
+struct ToJSValueOptions {
+  enum class DataEncoding {
+    Base64,
+    Buffer,
+  };
+
+  // How the bytes of data descriptors are emitted.
+  DataEncoding dataEncoding = DataEncoding::Base64;
+  // Descriptors nested deeper than this are emitted as descriptor wrappers
+  //  instead of being converted. The root is at depth 0.
+  uint32_t maxDepth = std::numeric_limits<uint32_t>::max();
+  // Whether text, numeric and boolean data descriptors are emitted as JS
+  //  primitives instead of `{ type, data }` objects.
+  bool decodeScalars = false;
+};
+
+bool ReadToJSValueOptionsOrThrow(Napi::Env env, const Napi::Value &value,
+                                 ToJSValueOptions *outOptions);
+
+// Converts a whole descriptor tree to plain JS values, by decoding it and
+//  materializing the result (see `DecodedTree`). The result has the same
+//  shape as `AEJSDescriptor.valueOf()`. `kind` is that of `desc` itself, which
+//  callers holding a wrapper already know.
+Napi::Value DescToJSValueOrThrow(Napi::Env env, const AEDesc *desc,
+                                 Descriptors::DescriptorKind kind,
+                                 const ToJSValueOptions &options);
+
+// One node of a `DecodedTree`. Nodes are stored in preorder: a list, record
+//  or event node is followed by its children.
+struct DecodedNode {
+  enum class Tag : uint8_t {
+    Null,
+    Boolean,
+    Number,
+    Utf8,
+    Utf16,
+    Data,
+    List,
+    Record,
+    // Followed by the event's target and then a record of its parameters.
+    Event,
+    Unknown,
+    // A descriptor past `maxDepth`, to be handed to a wrapper.
+    Descriptor,
+  };
+
+  Tag tag;
+  // The keyword of the record field or event parameter this node is.
+  AEKeyword keyword = 0;
+  // The descriptor type of `Data` and `Unknown` nodes.
+  DescType type = 0;
+  // The value of `Boolean` (0 or 1) and `Number` nodes.
+  double number = 0;
+  // Where the contents of `Utf8`, `Utf16` and `Data` nodes are in their
+  //  arena, the index of `Event` and `Descriptor` nodes in `events` or
+  //  `descriptors`, and the child count of `List` and `Record` nodes.
+  size_t offset = 0;
+  size_t length = 0;
+};
+
+struct DecodedEvent {
+  DescType type = 0;
+  AEEventClass eventClass = 0;
+  AEEventID eventID = 0;
+  int16_t returnID = 0;
+  int32_t transactionID = 0;
+};
+
+// A descriptor tree decoded into plain data: numbers in the nodes, and
+//  strings and bytes in two flat arenas. Decoding touches no JS, so it can run
+//  on a worker thread, leaving only the JS values to be built on the JS
+//  thread, in one pass.
+struct DecodedTree {
+  DecodedTree() = default;
+  DecodedTree(const DecodedTree &) = delete;
+  DecodedTree &operator=(const DecodedTree &) = delete;
+  ~DecodedTree();
+
+  ToJSValueOptions options;
+  std::vector<DecodedNode> nodes;
+  // UTF-8 text, base64 text and raw data bytes.
+  std::string text;
+  std::u16string utf16;
+  std::vector<DecodedEvent> events;
+  // Owned until materialized.
+  std::vector<AEDesc> descriptors;
+  // Set when decoding failed. `errorCode` is `noErr` for errors that aren't
+  //  OS errors.
+  OSErr errorCode = noErr;
+  std::string errorMessage;
+};
+
+// Decodes `desc` into the shape `DescToJSValueOrThrow` produces. Safe to call
+//  off the JS thread. On failure the error is kept in `outTree`, to be thrown
+//  by `MaterializeDecodedTreeOrThrow`.
+bool DecodeDescTree(const AEDesc *desc, Descriptors::DescriptorKind kind,
+                    const ToJSValueOptions &options, DecodedTree *outTree);
+
+// Builds the JS value for a decoded tree, or throws the error decoding it ran
+//  into. Descriptors past `maxDepth` are moved into wrappers.
+Napi::Value MaterializeDecodedTreeOrThrow(Napi::Env env, DecodedTree *tree);
+
+struct FromJSValueHints {
+  // Overrides the type of the root descriptor when it is a list or a record.
+  //  Zero means the type is inferred from the value.
+  DescType descriptorType = 0;
+};
+
+// Reads the data of `desc` as a fixed-size scalar of `type`. The data is read
+//  directly when `desc` already has that type, and through a temporary
+//  coercion otherwise.
+bool ReadScalarOrThrow(Napi::Env env, const AEDesc *desc, DescType type,
+                       void *out, Size size);
+
+template <typename T>
+bool ReadScalarOrThrow(Napi::Env env, const AEDesc *desc, DescType type,
+                       T *out) {
+  return ReadScalarOrThrow(env, desc, type, static_cast<void *>(out),
+                           sizeof(T));
+}
+
+// Reads `desc` as UTF-8 text, coercing it first unless it is already 'utf8'.
+bool ReadUtf8StringOrThrow(Napi::Env env, const AEDesc *desc,
+                           std::string *out);
+
+bool ReadFromJSValueHintsOrThrow(Napi::Env env, const Napi::Value &value,
+                                 FromJSValueHints *outHints);
+
+// Builds a descriptor tree from the same values `AEJSDescriptor.fromValue()`
+//  accepts in a single walk, putting each child into its parent as soon as it
+//  is built. On success the caller owns `outDesc`.
+bool JSValueToDescOrThrow(Napi::Env env, const Napi::Value &value,
+                          const FromJSValueHints &hints, AEDesc *outDesc);
+} // namespace ValueConversion
+} // namespace ae_js_bridge
@@ -0,0 +1,916 @@
+#include "ValueConversion.h"
+
+#include "AEDescriptor.h"
+#include "OSError.h"
+#include "helpers.h"
+
+#include <napi.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ae_js_bridge {
+namespace ValueConversion {
+namespace {
+
+constexpr char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void AppendBase64(const uint8_t *data, size_t size, std::string *out) {
+  out->reserve(out->size() + ((size + 2) / 3) * 4);
+
+  size_t index = 0;
+  for (; index + 3 <= size; index += 3) {
+    const uint32_t chunk = (static_cast<uint32_t>(data[index]) << 16) |
+                           (static_cast<uint32_t>(data[index + 1]) << 8) |
+                           static_cast<uint32_t>(data[index + 2]);
+    out->push_back(kBase64Alphabet[(chunk >> 18) & 0x3F]);
+    out->push_back(kBase64Alphabet[(chunk >> 12) & 0x3F]);
+    out->push_back(kBase64Alphabet[(chunk >> 6) & 0x3F]);
+    out->push_back(kBase64Alphabet[chunk & 0x3F]);
+  }
+
+  const size_t remaining = size - index;
+  if (remaining == 0) {
+    return;
+  }
+  uint32_t chunk = static_cast<uint32_t>(data[index]) << 16;
+  if (remaining == 2) {
+    chunk |= static_cast<uint32_t>(data[index + 1]) << 8;
+  }
+  out->push_back(kBase64Alphabet[(chunk >> 18) & 0x3F]);
+  out->push_back(kBase64Alphabet[(chunk >> 12) & 0x3F]);
+  out->push_back(remaining == 2 ? kBase64Alphabet[(chunk >> 6) & 0x3F] : '=');
+  out->push_back('=');
+}
+
+// Decodes a descriptor tree into a `DecodedTree` without touching JS, so it
+//  can run on any thread. Mirrors the shape `DescToJSValueOrThrow` produces.
+class Decoder {
+public:
+  Decoder(const ToJSValueOptions &options, DecodedTree *tree)
+      : options(options), tree(tree) {}
+
+  bool Decode(const AEDesc *desc, Descriptors::DescriptorKind kind,
+              uint32_t depth) {
+    switch (kind) {
+    case Descriptors::DescriptorKind::Null:
+      Push(DecodedNode::Tag::Null);
+      return true;
+    case Descriptors::DescriptorKind::Data:
+      return DecodeData(desc);
+    case Descriptors::DescriptorKind::List:
+      return DecodeList(desc, depth);
+    case Descriptors::DescriptorKind::Record:
+      return DecodeKeyedItems(desc, depth + 1);
+    case Descriptors::DescriptorKind::Event:
+      return DecodeEvent(desc, depth);
+    case Descriptors::DescriptorKind::Unknown:
+      break;
+    }
+
+    Push(DecodedNode::Tag::Unknown).type = desc->descriptorType;
+    return true;
+  }
+
+private:
+  DecodedNode &Push(DecodedNode::Tag tag) {
+    tree->nodes.push_back(DecodedNode{tag});
+    return tree->nodes.back();
+  }
+
+  bool Fail(OSErr code, const char *message) {
+    tree->errorCode = code;
+    tree->errorMessage = message;
+    return false;
+  }
+
+  // Decodes a child that was copied out of its parent, disposing of it
+  //  afterwards. Children past the depth limit are kept for a wrapper instead.
+  bool DecodeChild(AEDesc *child, uint32_t depth) {
+    if (depth > options.maxDepth) {
+      Push(DecodedNode::Tag::Descriptor).offset = tree->descriptors.size();
+      tree->descriptors.push_back(*child);
+      return true;
+    }
+    bool decoded =
+        Decode(child, Descriptors::GetDescriptorKind(child), depth);
+    AEDisposeDesc(child);
+    return decoded;
+  }
+
+  // Appends the data of `desc` to `out`.
+  template <typename Bytes> bool AppendData(const AEDesc *desc, Bytes *out) {
+    const Size size = AEGetDescDataSize(desc);
+    if (size < 0) {
+      return Fail(noErr, "AEGetDescDataSize failed");
+    }
+    const size_t start = out->size();
+    out->resize(start + static_cast<size_t>(size));
+    if (size == 0) {
+      return true;
+    }
+    OSErr err = AEGetDescData(desc, out->data() + start, size);
+    if (err != noErr) {
+      return Fail(err, "AEGetDescData failed");
+    }
+    return true;
+  }
+
+  template <typename T> bool ReadExactly(const AEDesc *desc, T *out) {
+    if (AEGetDescDataSize(desc) != static_cast<Size>(sizeof(T))) {
+      return false;
+    }
+    return AEGetDescData(desc, out, sizeof(T)) == noErr;
+  }
+
+  template <typename T> bool DecodeNumber(const AEDesc *desc) {
+    T value{};
+    if (!ReadExactly(desc, &value)) {
+      return false;
+    }
+    Push(DecodedNode::Tag::Number).number = static_cast<double>(value);
+    return true;
+  }
+
+  bool DecodeBoolean(bool value) {
+    Push(DecodedNode::Tag::Boolean).number = value ? 1 : 0;
+    return true;
+  }
+
+  // Returns false without pushing a node if `desc` isn't a scalar we know how
+  //  to decode, or if reading it failed (which sets the tree's error).
+  bool DecodeScalar(const AEDesc *desc) {
+    switch (desc->descriptorType) {
+    case typeUTF8Text: {
+      const size_t start = tree->text.size();
+      if (!AppendData(desc, &tree->text)) {
+        return false;
+      }
+      DecodedNode &node = Push(DecodedNode::Tag::Utf8);
+      node.offset = start;
+      node.length = tree->text.size() - start;
+      return true;
+    }
+    case typeUnicodeText: {
+      const Size size = AEGetDescDataSize(desc);
+      if (size < 0) {
+        return false;
+      }
+      const size_t start = tree->utf16.size();
+      tree->utf16.resize(start + static_cast<size_t>(size) / sizeof(char16_t));
+      const size_t length = tree->utf16.size() - start;
+      if (length != 0 &&
+          AEGetDescData(desc, tree->utf16.data() + start,
+                        length * sizeof(char16_t)) != noErr) {
+        tree->utf16.resize(start);
+        return false;
+      }
+      const size_t skip = length != 0 && tree->utf16[start] == 0xFEFF ? 1 : 0;
+      DecodedNode &node = Push(DecodedNode::Tag::Utf16);
+      node.offset = start + skip;
+      node.length = length - skip;
+      return true;
+    }
+    case typeChar: {
+      AEDesc utf8Desc;
+      if (AECoerceDesc(desc, typeUTF8Text, &utf8Desc) != noErr) {
+        return false;
+      }
+      bool decoded = DecodeScalar(&utf8Desc);
+      AEDisposeDesc(&utf8Desc);
+      return decoded;
+    }
+    case typeTrue:
+      return DecodeBoolean(true);
+    case typeFalse:
+      return DecodeBoolean(false);
+    case typeBoolean: {
+      uint8_t value = 0;
+      if (!ReadExactly(desc, &value)) {
+        return false;
+      }
+      return DecodeBoolean(value != 0);
+    }
+    case typeSInt16:
+      return DecodeNumber<int16_t>(desc);
+    case typeUInt16:
+      return DecodeNumber<uint16_t>(desc);
+    case typeSInt32:
+      return DecodeNumber<int32_t>(desc);
+    case typeUInt32:
+      return DecodeNumber<uint32_t>(desc);
+    case typeSInt64:
+      return DecodeNumber<int64_t>(desc);
+    case typeIEEE32BitFloatingPoint:
+      return DecodeNumber<float>(desc);
+    case typeIEEE64BitFloatingPoint:
+      return DecodeNumber<double>(desc);
+    default:
+      return false;
+    }
+  }
+
+  bool DecodeData(const AEDesc *desc) {
+    if (options.decodeScalars &&
+        (DecodeScalar(desc) || !tree->errorMessage.empty())) {
+      return tree->errorMessage.empty();
+    }
+
+    const size_t start = tree->text.size();
+    if (options.dataEncoding == ToJSValueOptions::DataEncoding::Buffer) {
+      if (!AppendData(desc, &tree->text)) {
+        return false;
+      }
+    } else {
+      scratch.clear();
+      if (!AppendData(desc, &scratch)) {
+        return false;
+      }
+      AppendBase64(scratch.data(), scratch.size(), &tree->text);
+    }
+    DecodedNode &node = Push(DecodedNode::Tag::Data);
+    node.type = desc->descriptorType;
+    node.offset = start;
+    node.length = tree->text.size() - start;
+    return true;
+  }
+
+  bool DecodeList(const AEDesc *desc, uint32_t depth) {
+    long count = 0;
+    OSErr countErr = AECountItems(desc, &count);
+    if (countErr != noErr) {
+      return Fail(countErr, "AECountItems failed");
+    }
+
+    Push(DecodedNode::Tag::List).length = static_cast<size_t>(count);
+    for (long index = 1; index <= count; ++index) {
+      AEDesc item;
+      OSErr getErr = AEGetNthDesc(desc, index, typeWildCard, nullptr, &item);
+      if (getErr != noErr) {
+        return Fail(getErr, "AEGetNthDesc failed");
+      }
+      if (!DecodeChild(&item, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Decodes the keyed items of a record, or the parameters of an event.
+  bool DecodeKeyedItems(const AEDesc *desc, uint32_t childDepth) {
+    long count = 0;
+    OSErr countErr = AECountItems(desc, &count);
+    if (countErr != noErr) {
+      return Fail(countErr, "AECountItems failed");
+    }
+
+    Push(DecodedNode::Tag::Record).length = static_cast<size_t>(count);
+    for (long index = 1; index <= count; ++index) {
+      AEKeyword keyword = 0;
+      AEDesc item;
+      OSErr getErr = AEGetNthDesc(desc, index, typeWildCard, &keyword, &item);
+      if (getErr != noErr) {
+        return Fail(getErr, "AEGetNthDesc failed");
+      }
+      const size_t child = tree->nodes.size();
+      if (!DecodeChild(&item, childDepth)) {
+        return false;
+      }
+      tree->nodes[child].keyword = keyword;
+    }
+    return true;
+  }
+
+  bool DecodeEvent(const AEDesc *desc, uint32_t depth) {
+    DecodedEvent event;
+    event.type = desc->descriptorType;
+    OSErr err = noErr;
+    if ((err = AEGetAttributePtr(desc, keyEventClassAttr, typeType, nullptr,
+                                 &event.eventClass, sizeof(event.eventClass),
+                                 nullptr)) != noErr) {
+      return Fail(err, "AEGetAttributePtr(keyEventClassAttr) failed");
+    }
+    if ((err = AEGetAttributePtr(desc, keyEventIDAttr, typeType, nullptr,
+                                 &event.eventID, sizeof(event.eventID),
+                                 nullptr)) != noErr) {
+      return Fail(err, "AEGetAttributePtr(keyEventIDAttr) failed");
+    }
+    if ((err = AEGetAttributePtr(desc, keyReturnIDAttr, typeSInt16, nullptr,
+                                 &event.returnID, sizeof(event.returnID),
+                                 nullptr)) != noErr) {
+      return Fail(err, "AEGetAttributePtr(keyReturnIDAttr) failed");
+    }
+    if ((err = AEGetAttributePtr(desc, keyTransactionIDAttr, typeSInt32,
+                                 nullptr, &event.transactionID,
+                                 sizeof(event.transactionID), nullptr)) !=
+        noErr) {
+      return Fail(err, "AEGetAttributePtr(keyTransactionIDAttr) failed");
+    }
+
+    // The target and the parameters follow the event's node.
+    Push(DecodedNode::Tag::Event).offset = tree->events.size();
+    tree->events.push_back(event);
+
+    AEDesc target;
+    err = AEGetAttributeDesc(desc, keyAddressAttr, typeWildCard, &target);
+    if (err != noErr) {
+      return Fail(err, "AEGetAttributeDesc(keyAddressAttr) failed");
+    }
+    if (!DecodeChild(&target, depth + 1)) {
+      return false;
+    }
+    return DecodeKeyedItems(desc, depth + 1);
+  }
+
+  const ToJSValueOptions &options;
+  DecodedTree *tree;
+  // Reused across the whole walk so base64 encoding doesn't allocate per node.
+  std::vector<uint8_t> scratch;
+};
+
+// Builds JS values out of a `DecodedTree` in one pass over its nodes.
+class Materializer {
+public:
+  Materializer(Napi::Env env, DecodedTree *tree) : env(env), tree(tree) {}
+
+  Napi::Value Next() {
+    const DecodedNode &node = tree->nodes[cursor++];
+    switch (node.tag) {
+    case DecodedNode::Tag::Null:
+      return env.Null();
+    case DecodedNode::Tag::Boolean:
+      return Napi::Boolean::New(env, node.number != 0);
+    case DecodedNode::Tag::Number:
+      return Napi::Number::New(env, node.number);
+    case DecodedNode::Tag::Utf8:
+      return Napi::String::New(env, tree->text.data() + node.offset,
+                               node.length);
+    case DecodedNode::Tag::Utf16:
+      return Napi::String::New(env, tree->utf16.data() + node.offset,
+                               node.length);
+    case DecodedNode::Tag::Data:
+      return MaterializeData(node);
+    case DecodedNode::Tag::List:
+      return MaterializeList(node);
+    case DecodedNode::Tag::Record:
+      return MaterializeRecord(node);
+    case DecodedNode::Tag::Event:
+      return MaterializeEvent(node);
+    case DecodedNode::Tag::Descriptor: {
+      AEDesc &child = tree->descriptors[node.offset];
+      AEDesc *owned = new AEDesc(child);
+      AEInitializeDesc(&child);
+      return Descriptors::WrapOwnedAEDescOrThrow(env, owned);
+    }
+    case DecodedNode::Tag::Unknown:
+      break;
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("type", FourCharCodeToJS(env, node.type));
+    return result;
+  }
+
+private:
+  Napi::Value MaterializeData(const DecodedNode &node) {
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("type", FourCharCodeToJS(env, node.type));
+    const char *data = tree->text.data() + node.offset;
+    if (tree->options.dataEncoding ==
+        ToJSValueOptions::DataEncoding::Buffer) {
+      result.Set("data", Napi::Buffer<uint8_t>::Copy(
+                             env, reinterpret_cast<const uint8_t *>(data),
+                             node.length));
+    } else {
+      result.Set("data", Napi::String::New(env, data, node.length));
+    }
+    return result;
+  }
+
+  Napi::Value MaterializeList(const DecodedNode &node) {
+    Napi::Array result = Napi::Array::New(env, node.length);
+    for (size_t index = 0; index < node.length; ++index) {
+      Napi::Value value = Next();
+      if (env.IsExceptionPending()) {
+        return env.Null();
+      }
+      result.Set(static_cast<uint32_t>(index), value);
+    }
+    return result;
+  }
+
+  Napi::Value MaterializeRecord(const DecodedNode &node) {
+    Napi::Object result = Napi::Object::New(env);
+    for (size_t index = 0; index < node.length; ++index) {
+      const AEKeyword keyword = tree->nodes[cursor].keyword;
+      Napi::Value value = Next();
+      if (env.IsExceptionPending()) {
+        return env.Null();
+      }
+      result.Set(FourCharCodeToJS(env, keyword), value);
+    }
+    return result;
+  }
+
+  Napi::Value MaterializeEvent(const DecodedNode &node) {
+    const DecodedEvent &event = tree->events[node.offset];
+    Napi::Value targetValue = Next();
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
+    Napi::Value parameters = Next();
+    if (env.IsExceptionPending()) {
+      return env.Null();
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("type", FourCharCodeToJS(env, event.type));
+    result.Set("eventClass", FourCharCodeToJS(env, event.eventClass));
+    result.Set("eventID", FourCharCodeToJS(env, event.eventID));
+    result.Set("target", targetValue);
+    result.Set("returnID", Napi::Number::New(env, event.returnID));
+    result.Set("transactionID", Napi::Number::New(env, event.transactionID));
+    result.Set("parameters", parameters);
+    // Attributes are not iterable, and are thus not serializable.
+    return result;
+  }
+
+  Napi::Env env;
+  DecodedTree *tree;
+  size_t cursor = 0;
+};
+
+// The JS wrappers in `index.ts` expose their native descriptor under this
+//  registered symbol, so they can be embedded in values without unwrapping.
+constexpr const char *kNativeDescriptorSymbol = "ae_js_bridge.nativeDescriptor";
+
+// Guards against cyclic values, which would otherwise recurse until the
+//  native stack runs out.
+constexpr uint32_t kMaxBuildDepth = 1024;
+
+class Builder {
+public:
+  explicit Builder(Napi::Env env)
+      : env(env), nativeDescriptorKey(Napi::Symbol::For(
+                      env, kNativeDescriptorSymbol)) {}
+
+  // On failure `outDesc` is left as a null descriptor.
+  bool Build(const Napi::Value &value, DescType containerType, uint32_t depth,
+             AEDesc *outDesc) {
+    AEInitializeDesc(outDesc);
+    if (!CheckDepth(depth)) {
+      return false;
+    }
+
+    if (const AEDesc *existing = ExistingDescriptor(value)) {
+      return Check(DuplicateAEDesc(existing, outDesc), "AEDuplicateDesc failed");
+    }
+    if (ReadPrimitive(value)) {
+      return Check(AECreateDesc(primitive.type, primitive.data, primitive.size,
+                                outDesc),
+                   "AECreateDesc failed");
+    }
+    if (value.IsObject() && !value.IsArray()) {
+      Napi::Object object = value.As<Napi::Object>();
+      if (IsValueCoercionSpec(object)) {
+        return BuildCoercion(object, depth, outDesc);
+      }
+      if (IsDataValueSpec(object)) {
+        return ReadDataSpecOrThrow(object) &&
+               Check(AECreateDesc(primitive.type, primitive.data,
+                                  primitive.size, outDesc),
+                     "AECreateDesc failed");
+      }
+    }
+    if (!value.IsObject()) {
+      Napi::TypeError::New(env, "Invalid value").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    // Lists and records are written front to back through a stream, so the
+    //  whole tree ends up in one buffer instead of being copied into its
+    //  parent level by level.
+    ScopedAEStream stream;
+    if (!stream.Get()) {
+      return Check(memFullErr, "AEStreamOpen failed");
+    }
+    const bool isList = value.IsArray();
+    if (!Write(stream.Get(), value,
+               isList || containerType == 0 ? typeAERecord : containerType,
+               depth)) {
+      return false;
+    }
+    if (!Check(stream.Close(outDesc), "AEStreamClose failed")) {
+      AEInitializeDesc(outDesc);
+      return false;
+    }
+    if (containerType != 0) {
+      outDesc->descriptorType = containerType;
+      Descriptors::NoteDescriptorKind(containerType,
+                                      isList ? Descriptors::DescriptorKind::List
+                                             : Descriptors::DescriptorKind::Record);
+    }
+    return true;
+  }
+
+private:
+  bool Check(OSStatus err, const char *errorContext) {
+    if (err != noErr) {
+      OSError::Throw(env, err, errorContext);
+      return false;
+    }
+    return true;
+  }
+
+  bool CheckDepth(uint32_t depth) {
+    if (depth > kMaxBuildDepth) {
+      Napi::RangeError::New(env, "Value is nested too deeply")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    return true;
+  }
+
+  const AEDesc *ExistingDescriptor(const Napi::Value &value) {
+    if (!value.IsObject()) {
+      return nullptr;
+    }
+    if (auto *wrapper = Descriptors::UnwrapDescriptor(value)) {
+      return wrapper->GetRawDescriptor();
+    }
+    Napi::Object object = value.As<Napi::Object>();
+    if (!object.Has(nativeDescriptorKey)) {
+      return nullptr;
+    }
+    auto *wrapper = Descriptors::UnwrapDescriptor(object.Get(nativeDescriptorKey));
+    return wrapper ? wrapper->GetRawDescriptor() : nullptr;
+  }
+
+  static bool IsValueCoercionSpec(const Napi::Object &object) {
+    return object.Has("value") && object.Has("as") &&
+           IsFourCharCodeValue(object.Get("as"));
+  }
+
+  static bool IsDataValueSpec(const Napi::Object &object) {
+    if (!object.Has("type") || !object.Has("data") ||
+        !IsFourCharCodeValue(object.Get("type"))) {
+      return false;
+    }
+    Napi::Value data = object.Get("data");
+    return data.IsTypedArray() && data.As<Napi::TypedArray>().TypedArrayType() ==
+                                      napi_uint8_array;
+  }
+
+  bool ReadTypeOrThrow(const Napi::Value &value, DescType *outType) {
+    *outType = JSValueToFourCharCode(value);
+    if (*outType == 0) {
+      Napi::Error::New(env, "Invalid descriptor type")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    return true;
+  }
+
+  // Fills in `primitive` for null, strings, numbers and booleans. The bytes
+  //  stay valid until the next call.
+  bool ReadPrimitive(const Napi::Value &value) {
+    if (value.IsNull()) {
+      primitive = {typeNull, nullptr, 0};
+      return true;
+    }
+    if (value.IsString()) {
+      // Napi::String::Utf8Value() would return a new std::string; filling
+      //  `text` in place reuses its capacity.
+      size_t length = 0;
+      napi_status status =
+          napi_get_value_string_utf8(env, value, nullptr, 0, &length);
+      if (status == napi_ok) {
+        text.resize(length);
+        status = napi_get_value_string_utf8(env, value, text.data(),
+                                            length + 1, &length);
+      }
+      NAPI_THROW_IF_FAILED(env, status, false);
+      primitive = {typeUTF8Text, text.data(), text.size()};
+      return true;
+    }
+    if (value.IsNumber()) {
+      // 'doub' is the same as JavaScript's Number type.
+      number = value.As<Napi::Number>().DoubleValue();
+      primitive = {typeIEEE64BitFloatingPoint, &number, sizeof(number)};
+      return true;
+    }
+    if (value.IsBoolean()) {
+      boolean = value.As<Napi::Boolean>().Value() ? 1 : 0;
+      primitive = {typeBoolean, &boolean, sizeof(boolean)};
+      return true;
+    }
+    return false;
+  }
+
+  // Fills in `primitive` from a `{type, data}` spec.
+  bool ReadDataSpecOrThrow(const Napi::Object &spec) {
+    DescType type = 0;
+    if (!ReadTypeOrThrow(spec.Get("type"), &type)) {
+      return false;
+    }
+    Descriptors::NoteDescriptorKind(type, Descriptors::DescriptorKind::Data);
+    Napi::Uint8Array data = spec.Get("data").As<Napi::Uint8Array>();
+    primitive = {type, data.Data(), data.ByteLength()};
+    return true;
+  }
+
+  bool BuildCoercion(const Napi::Object &spec, uint32_t depth,
+                     AEDesc *outDesc) {
+    DescType type = 0;
+    if (!ReadTypeOrThrow(spec.Get("as"), &type)) {
+      return false;
+    }
+    AEDesc source;
+    if (!Build(spec.Get("value"), 0, depth + 1, &source)) {
+      AEDisposeDesc(&source);
+      return false;
+    }
+    OSErr err = AECoerceDesc(&source, type, outDesc);
+    AEDisposeDesc(&source);
+    return Check(err, "AECoerceDesc failed");
+  }
+
+  // Writes `value` as the next item in `stream`. Plain objects become records
+  //  of `recordType`.
+  bool Write(AEStreamRef stream, const Napi::Value &value, DescType recordType,
+             uint32_t depth) {
+    if (!CheckDepth(depth)) {
+      return false;
+    }
+
+    if (const AEDesc *existing = ExistingDescriptor(value)) {
+      return Check(AEStreamWriteAEDesc(stream, existing),
+                   "AEStreamWriteAEDesc failed");
+    }
+    if (ReadPrimitive(value)) {
+      return Check(AEStreamWriteDesc(stream, primitive.type, primitive.data,
+                                     primitive.size),
+                   "AEStreamWriteDesc failed");
+    }
+    if (value.IsArray()) {
+      Napi::Array items = value.As<Napi::Array>();
+      if (!Check(AEStreamOpenList(stream), "AEStreamOpenList failed")) {
+        return false;
+      }
+      const uint32_t length = items.Length();
+      for (uint32_t i = 0; i < length; ++i) {
+        if (!Write(stream, items.Get(i), typeAERecord, depth + 1)) {
+          return false;
+        }
+      }
+      return Check(AEStreamCloseList(stream), "AEStreamCloseList failed");
+    }
+    if (!value.IsObject()) {
+      Napi::TypeError::New(env, "Invalid value").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    Napi::Object object = value.As<Napi::Object>();
+    if (IsValueCoercionSpec(object)) {
+      AEDesc coerced;
+      bool ok = BuildCoercion(object, depth, &coerced) &&
+                Check(AEStreamWriteAEDesc(stream, &coerced),
+                      "AEStreamWriteAEDesc failed");
+      AEDisposeDesc(&coerced);
+      return ok;
+    }
+    if (IsDataValueSpec(object)) {
+      return ReadDataSpecOrThrow(object) &&
+             Check(AEStreamWriteDesc(stream, primitive.type, primitive.data,
+                                     primitive.size),
+                   "AEStreamWriteDesc failed");
+    }
+
+    if (!Check(AEStreamOpenRecord(stream, recordType),
+               "AEStreamOpenRecord failed")) {
+      return false;
+    }
+    Napi::Array keys = object.GetPropertyNames();
+    const uint32_t length = keys.Length();
+    for (uint32_t i = 0; i < length; ++i) {
+      Napi::Value key = keys.Get(i);
+      if (!key.IsString()) {
+        continue;
+      }
+      AEKeyword keyword = PropertyNameToFourCharCode(key);
+      if (keyword == 0) {
+        Napi::Error::New(env, "Invalid keyword").ThrowAsJavaScriptException();
+        return false;
+      }
+      if (!Check(AEStreamWriteKey(stream, keyword), "AEStreamWriteKey failed") ||
+          !Write(stream, object.Get(key), typeAERecord, depth + 1)) {
+        return false;
+      }
+    }
+    return Check(AEStreamCloseRecord(stream), "AEStreamCloseRecord failed");
+  }
+
+  Napi::Env env;
+  Napi::Symbol nativeDescriptorKey;
+  // Reused for every string, so UTF-8 conversion only allocates when a string
+  //  is longer than any before it.
+  std::string text;
+  double number = 0;
+  uint8_t boolean = 0;
+  struct {
+    DescType type;
+    const void *data;
+    size_t size;
+  } primitive = {typeNull, nullptr, 0};
+};
+
+} // namespace
+
+bool ReadToJSValueOptionsOrThrow(Napi::Env env, const Napi::Value &value,
+                                 ToJSValueOptions *outOptions) {
+  if (value.IsUndefined()) {
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "toJSValue options must be an object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Object object = value.As<Napi::Object>();
+
+  Napi::Value dataEncoding = object.Get("dataEncoding");
+  if (!dataEncoding.IsUndefined()) {
+    const std::string encoding = dataEncoding.IsString()
+                                     ? dataEncoding.As<Napi::String>().Utf8Value()
+                                     : std::string();
+    if (encoding == "base64") {
+      outOptions->dataEncoding = ToJSValueOptions::DataEncoding::Base64;
+    } else if (encoding == "buffer") {
+      outOptions->dataEncoding = ToJSValueOptions::DataEncoding::Buffer;
+    } else {
+      Napi::TypeError::New(env, "dataEncoding must be 'base64' or 'buffer'")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+
+  Napi::Value maxDepth = object.Get("maxDepth");
+  if (!maxDepth.IsUndefined()) {
+    const double depth =
+        maxDepth.IsNumber() ? maxDepth.As<Napi::Number>().DoubleValue() : -1;
+    if (!(depth >= 0)) {
+      Napi::TypeError::New(env, "maxDepth must be a non-negative number")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    outOptions->maxDepth =
+        depth >= static_cast<double>(std::numeric_limits<uint32_t>::max())
+            ? std::numeric_limits<uint32_t>::max()
+            : static_cast<uint32_t>(std::floor(depth));
+  }
+
+  Napi::Value decodeScalars = object.Get("decodeScalars");
+  if (!decodeScalars.IsUndefined()) {
+    if (!decodeScalars.IsBoolean()) {
+      Napi::TypeError::New(env, "decodeScalars must be a boolean")
+          .ThrowAsJavaScriptException();
+      return false;
+    }
+    outOptions->decodeScalars = decodeScalars.As<Napi::Boolean>().Value();
+  }
+  return true;
+}
+
+Napi::Value DescToJSValueOrThrow(Napi::Env env, const AEDesc *desc,
+                                 Descriptors::DescriptorKind kind,
+                                 const ToJSValueOptions &options) {
+  DecodedTree tree;
+  DecodeDescTree(desc, kind, options, &tree);
+  return MaterializeDecodedTreeOrThrow(env, &tree);
+}
+
+DecodedTree::~DecodedTree() {
+  for (AEDesc &desc : descriptors) {
+    AEDisposeDesc(&desc);
+  }
+}
+
+bool DecodeDescTree(const AEDesc *desc, Descriptors::DescriptorKind kind,
+                    const ToJSValueOptions &options, DecodedTree *outTree) {
+  outTree->options = options;
+  Decoder decoder(outTree->options, outTree);
+  if (!decoder.Decode(desc, kind, 0)) {
+    if (outTree->errorMessage.empty()) {
+      outTree->errorMessage = "Descriptor decoding failed";
+    }
+    return false;
+  }
+  return true;
+}
+
+Napi::Value MaterializeDecodedTreeOrThrow(Napi::Env env, DecodedTree *tree) {
+  if (!tree->errorMessage.empty()) {
+    if (tree->errorCode != noErr) {
+      OSError::Throw(env, tree->errorCode, tree->errorMessage);
+    } else {
+      Napi::Error::New(env, tree->errorMessage).ThrowAsJavaScriptException();
+    }
+    return env.Null();
+  }
+  Materializer materializer(env, tree);
+  return materializer.Next();
+}
+
+bool ReadScalarOrThrow(Napi::Env env, const AEDesc *desc, DescType type,
+                       void *out, Size size) {
+  AEDesc coerced;
+  AEInitializeDesc(&coerced);
+  const AEDesc *source = desc;
+  if (desc->descriptorType != type) {
+    OSErr coerceErr = AECoerceDesc(desc, type, &coerced);
+    if (coerceErr != noErr) {
+      OSError::Throw(env, coerceErr, "AECoerceDesc failed");
+      return false;
+    }
+    source = &coerced;
+  }
+
+  OSErr err = AEGetDescDataSize(source) == size
+                  ? AEGetDescData(source, out, size)
+                  : static_cast<OSErr>(errAECorruptData);
+  AEDisposeDesc(&coerced);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEGetDescData failed");
+    return false;
+  }
+  return true;
+}
+
+bool ReadUtf8StringOrThrow(Napi::Env env, const AEDesc *desc,
+                           std::string *out) {
+  AEDesc coerced;
+  AEInitializeDesc(&coerced);
+  const AEDesc *source = desc;
+  if (desc->descriptorType != typeUTF8Text) {
+    OSErr coerceErr = AECoerceDesc(desc, typeUTF8Text, &coerced);
+    if (coerceErr != noErr) {
+      OSError::Throw(env, coerceErr, "AECoerceDesc failed");
+      return false;
+    }
+    source = &coerced;
+  }
+
+  const Size size = AEGetDescDataSize(source);
+  out->resize(size > 0 ? static_cast<size_t>(size) : 0);
+  OSErr err = noErr;
+  if (!out->empty()) {
+    err = AEGetDescData(source, out->data(), size);
+  }
+  AEDisposeDesc(&coerced);
+  if (err != noErr) {
+    OSError::Throw(env, err, "AEGetDescData failed");
+    return false;
+  }
+  return true;
+}
+
+bool ReadFromJSValueHintsOrThrow(Napi::Env env, const Napi::Value &value,
+                                 FromJSValueHints *outHints) {
+  if (value.IsUndefined()) {
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "fromJSValue hints must be an object")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Value descriptorType = value.As<Napi::Object>().Get("descriptorType");
+  if (descriptorType.IsUndefined()) {
+    return true;
+  }
+  if (!IsFourCharCodeValue(descriptorType)) {
+    Napi::TypeError::New(env, "descriptorType must be a FourCharCode")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  outHints->descriptorType = JSValueToFourCharCode(descriptorType);
+  if (outHints->descriptorType == 0) {
+    Napi::Error::New(env, "Invalid descriptor type")
+        .ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+bool JSValueToDescOrThrow(Napi::Env env, const Napi::Value &value,
+                          const FromJSValueHints &hints, AEDesc *outDesc) {
+  Builder builder(env);
+  return builder.Build(value, hints.descriptorType, 0, outDesc);
+}
+
+} // namespace ValueConversion
+} // namespace ae_js_bridge
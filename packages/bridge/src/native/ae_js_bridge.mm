@@ -1,9 +1,13 @@
 #include "AEDescriptor.h"
+#include "AETarget.h"
 #include "AppleEventAPI.h"
 #include "OSError.h"
+#include "helpers.h"
 #include <napi.h>
 
 static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  ae_js_bridge::InitFourCharCodes(env);
+
   ae_js_bridge::Descriptors::AEDescriptor::Init(env, exports);
   ae_js_bridge::Descriptors::AENullDescriptor::Init(env, exports);
   ae_js_bridge::Descriptors::AEDataDescriptor::Init(env, exports);
@@ -12,8 +16,16 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   ae_js_bridge::Descriptors::AEEventDescriptor::Init(env, exports);
   ae_js_bridge::Descriptors::AEUnknownDescriptor::Init(env, exports);
 
+  ae_js_bridge::AETarget::Init(env, exports);
+
   ae_js_bridge::AppleEventAPI::Init(env, exports);
   exports.Set("OSError", ae_js_bridge::InitOSError(env));
+  exports.Set(
+      "setFourCharCodeMode",
+      Napi::Function::New(env, ae_js_bridge::SetFourCharCodeModeOrThrow));
+  exports.Set(
+      "getDescriptorCopyCounts",
+      Napi::Function::New(env, ae_js_bridge::GetDescriptorCopyCountsOrThrow));
   return exports;
 }
 NODE_API_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -1,10 +1,85 @@
 #pragma once
 
+#include "AEPlatform.h"
+
 #include <napi.h>
 
-#include <MacTypes.h>
+#include <memory>
 
 namespace ae_js_bridge {
-FourCharCode StringToFourCharCode(const std::string &s);
-std::string FourCharCodeToString(FourCharCode fourCharCode);
+// Sets up the environment's code table, with the standard AE codes interned
+//  up front. Called once from the module's `Init`.
+void InitFourCharCodes(Napi::Env env);
+
+// Returns the JS string for `code`, one latin1 character per byte. Codes that
+//  have been seen before come back as the same string, so decoding a record
+//  doesn't allocate a new string per key.
+Napi::String FourCharCodeToJSString(Napi::Env env, FourCharCode code);
+
+// Returns `code` the way the environment's code mode asks for: as an interned
+//  string by default, or as a plain uint32 after
+//  `setFourCharCodeMode('number')`.
+Napi::Value FourCharCodeToJS(Napi::Env env, FourCharCode code);
+
+// Whether `value` could be a code: a string or a number.
+bool IsFourCharCodeValue(const Napi::Value &value);
+
+// Accepts a uint32, or a string of exactly four latin1 characters read into a
+//  stack buffer without going through `Utf8Value()`. Returns 0 for anything
+//  else, including strings with characters past U+00FF.
+FourCharCode JSValueToFourCharCode(const Napi::Value &value);
+
+// `JSValueToFourCharCode` for the property names of a keyword-keyed object.
+//  In numeric mode, decimal names are read as codes too, since JS turns the
+//  numeric keys of records read in that mode into strings.
+FourCharCode PropertyNameToFourCharCode(const Napi::Value &name);
+
+// `setFourCharCodeMode(mode: 'string' | 'number')`.
+Napi::Value SetFourCharCodeModeOrThrow(const Napi::CallbackInfo &info);
+
+// A descriptor with any number of owners, disposed along with the last one.
+//  Descriptors are never changed once wrapped, so wrappers, send requests and
+//  conversions hold on to the same one instead of each taking a copy.
+using SharedAEDesc = std::shared_ptr<AEDesc>;
+
+// Takes over `desc`, which must have been allocated with `new`.
+SharedAEDesc AdoptAEDesc(AEDesc *desc);
+
+// `AEDuplicateDesc`, counted for `getDescriptorCopyCounts()`. The bridge
+//  duplicates through this only where it really needs a descriptor of its
+//  own, such as one the Apple Event Manager is about to take back.
+OSErr DuplicateAEDesc(const AEDesc *source, AEDesc *result);
+
+// `getDescriptorCopyCounts()`: how many descriptors the bridge has duplicated
+//  so far, and, on the portable engine, how many nodes (and bytes) it has had
+//  to clone to let a shared descriptor be changed. Meant for tests that pin
+//  down how much an operation copies; the counts are process-wide.
+Napi::Value GetDescriptorCopyCountsOrThrow(const Napi::CallbackInfo &info);
+
+// Owns an `AEStreamRef`. Streams write a list or record front to back into a
+//  single buffer, instead of reallocating it for every `AEPutDesc`. A stream
+//  that isn't closed explicitly is discarded along with what was written.
+class ScopedAEStream {
+public:
+  ScopedAEStream() : stream(AEStreamOpen()) {}
+  ScopedAEStream(const ScopedAEStream &) = delete;
+  ScopedAEStream &operator=(const ScopedAEStream &) = delete;
+  ~ScopedAEStream() {
+    if (stream) {
+      AEStreamClose(stream, nullptr);
+    }
+  }
+
+  AEStreamRef Get() const { return stream; }
+
+  // Hands the finished descriptor to `outDesc`. The stream is gone either way.
+  OSStatus Close(AEDesc *outDesc) {
+    AEStreamRef closing = stream;
+    stream = nullptr;
+    return AEStreamClose(closing, outDesc);
+  }
+
+private:
+  AEStreamRef stream;
+};
 } // namespace ae_js_bridge
\ No newline at end of file
@@ -1,29 +1,216 @@
 #include "helpers.h"
+#include "StandardFourCharCodes.h"
 
+#if defined(AEJS_USE_PORTABLE_ENGINE)
+#include "DescriptorEngine.h"
+#endif
+
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <napi.h>
-
-#include <MacTypes.h>
+#include <unordered_map>
 
 namespace ae_js_bridge {
+namespace {
+// Past this many codes, new ones are handed out without being interned, so a
+//  stream of arbitrary keywords can't grow the table without bound.
+constexpr size_t kMaxInternedCodes = 4096;
+
+Napi::String NewCodeString(Napi::Env env, FourCharCode code) {
+  const char bytes[4] = {
+      static_cast<char>((code >> 24) & 0xFF),
+      static_cast<char>((code >> 16) & 0xFF),
+      static_cast<char>((code >> 8) & 0xFF),
+      static_cast<char>(code & 0xFF),
+  };
+  napi_value result;
+  napi_status status = napi_create_string_latin1(env, bytes, 4, &result);
+  NAPI_THROW_IF_FAILED(env, status, Napi::String());
+  return Napi::String(env, result);
+}
+
+// Per-environment state for turning codes into JS values. Strings can't be
+//  referenced directly on every Node-API version, so the interned strings live
+//  in a JS array and the map holds their indices.
+class FourCharCodeTable {
+public:
+  explicit FourCharCodeTable(Napi::Env env)
+      : strings(Napi::Persistent(Napi::Array::New(env))) {
+    indices.reserve(std::size(StandardFourCharCodes::kAll));
+    for (const auto &entry : StandardFourCharCodes::kAll) {
+      GetString(env, entry.code);
+    }
+  }
+
+  Napi::String GetString(Napi::Env env, FourCharCode code) {
+    auto found = indices.find(code);
+    if (found != indices.end()) {
+      return strings.Value().Get(found->second).As<Napi::String>();
+    }
+    Napi::String string = NewCodeString(env, code);
+    if (indices.size() < kMaxInternedCodes) {
+      const uint32_t index = static_cast<uint32_t>(indices.size());
+      strings.Value().Set(index, string);
+      indices.emplace(code, index);
+    }
+    return string;
+  }
+
+  bool numeric = false;
+
+private:
+  Napi::Reference<Napi::Array> strings;
+  std::unordered_map<FourCharCode, uint32_t> indices;
+};
+
+FourCharCodeTable *GetTable(Napi::Env env) {
+  return env.GetInstanceData<FourCharCodeTable>();
+}
 
-FourCharCode StringToFourCharCode(const std::string &s) {
-  if (s.length() != 4) {
+FourCharCode NumberToFourCharCode(double number) {
+  if (!(number >= 1 && number <= UINT32_MAX) || std::trunc(number) != number) {
     return 0;
   }
-  return (static_cast<uint8_t>(s[0]) << 24) |
-         (static_cast<uint8_t>(s[1]) << 16) |
-         (static_cast<uint8_t>(s[2]) << 8) | (static_cast<uint8_t>(s[3]));
+  return static_cast<FourCharCode>(number);
 }
 
-std::string FourCharCodeToString(FourCharCode fourCharCode) {
-  std::string s;
-  s.reserve(4);
-  s.push_back(static_cast<char>((fourCharCode >> 24) & 0xFF));
-  s.push_back(static_cast<char>((fourCharCode >> 16) & 0xFF));
-  s.push_back(static_cast<char>((fourCharCode >> 8) & 0xFF));
-  s.push_back(static_cast<char>(fourCharCode & 0xFF));
-  return std::string(s);
+// Reads the decimal form of a uint32, with no sign or leading zeros.
+FourCharCode DecimalToFourCharCode(const char *digits, size_t length) {
+  if (length == 0 || length > 10 || digits[0] == '0') {
+    return 0;
+  }
+  uint64_t value = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (digits[i] < '0' || digits[i] > '9') {
+      return 0;
+    }
+    value = value * 10 + static_cast<uint64_t>(digits[i] - '0');
+  }
+  return value <= UINT32_MAX ? static_cast<FourCharCode>(value) : 0;
 }
+} // namespace
 
+void InitFourCharCodes(Napi::Env env) {
+  env.SetInstanceData(new FourCharCodeTable(env));
+}
+
+Napi::String FourCharCodeToJSString(Napi::Env env, FourCharCode code) {
+  return GetTable(env)->GetString(env, code);
+}
+
+Napi::Value FourCharCodeToJS(Napi::Env env, FourCharCode code) {
+  FourCharCodeTable *table = GetTable(env);
+  if (table->numeric) {
+    return Napi::Number::New(env, code);
+  }
+  return table->GetString(env, code);
+}
+
+bool IsFourCharCodeValue(const Napi::Value &value) {
+  return value.IsString() || value.IsNumber();
+}
+
+FourCharCode JSValueToFourCharCode(const Napi::Value &value) {
+  if (value.IsNumber()) {
+    return NumberToFourCharCode(value.As<Napi::Number>().DoubleValue());
+  }
+  // Read as UTF-16 rather than latin1, which would silently keep only the low
+  //  byte of characters past U+00FF. One unit more than a code needs tells a
+  //  longer string from it.
+  char16_t units[6];
+  size_t length = 0;
+  napi_status status = napi_get_value_string_utf16(value.Env(), value, units,
+                                                   sizeof(units) / 2, &length);
+  NAPI_THROW_IF_FAILED(value.Env(), status, 0);
+  if (length != 4) {
+    return 0;
+  }
+  FourCharCode code = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    if (units[i] > 0xFF) {
+      return 0;
+    }
+    code = (code << 8) | static_cast<FourCharCode>(units[i]);
+  }
+  return code;
+}
+
+FourCharCode PropertyNameToFourCharCode(const Napi::Value &name) {
+  if (!GetTable(name.Env())->numeric || !name.IsString()) {
+    return JSValueToFourCharCode(name);
+  }
+  // Room for the ten digits of the largest uint32, one more to tell an
+  //  eleven-character string from it, and the terminator.
+  char bytes[12];
+  size_t length = 0;
+  napi_status status = napi_get_value_string_latin1(
+      name.Env(), name, bytes, sizeof(bytes), &length);
+  NAPI_THROW_IF_FAILED(name.Env(), status, 0);
+  if (length == 4) {
+    return JSValueToFourCharCode(name);
+  }
+  return DecimalToFourCharCode(bytes, length);
+}
+
+Napi::Value SetFourCharCodeModeOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "setFourCharCodeMode takes (mode: string)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  const std::string mode = info[0].As<Napi::String>().Utf8Value();
+  if (mode != "string" && mode != "number") {
+    Napi::Error::New(env, "FourCharCode mode must be 'string' or 'number'")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  GetTable(env)->numeric = mode == "number";
+  return env.Undefined();
+}
+
+namespace {
+// Bumped from worker and handler threads as well as the JS thread.
+std::atomic<uint64_t> duplicateCount{0};
+} // namespace
+
+SharedAEDesc AdoptAEDesc(AEDesc *desc) {
+  return SharedAEDesc(desc, [](AEDesc *owned) {
+    AEDisposeDesc(owned);
+    delete owned;
+  });
+}
+
+OSErr DuplicateAEDesc(const AEDesc *source, AEDesc *result) {
+  duplicateCount.fetch_add(1, std::memory_order_relaxed);
+  return AEDuplicateDesc(source, result);
+}
+
+Napi::Value GetDescriptorCopyCountsOrThrow(const Napi::CallbackInfo &info) {
+  Napi::Env env = info.Env();
+  if (info.Length() != 0) {
+    Napi::TypeError::New(env, "getDescriptorCopyCounts takes no arguments")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  uint64_t clonedNodes = 0;
+  uint64_t clonedBytes = 0;
+#if defined(AEJS_USE_PORTABLE_ENGINE)
+  DescriptorEngine::CopyCounts engineCounts = DescriptorEngine::GetCopyCounts();
+  clonedNodes = engineCounts.clonedNodes;
+  clonedBytes = engineCounts.clonedBytes;
+#endif
+  Napi::Object counts = Napi::Object::New(env);
+  counts.Set("duplicates",
+             Napi::Number::New(env, static_cast<double>(duplicateCount.load(
+                                        std::memory_order_relaxed))));
+  counts.Set("clonedNodes",
+             Napi::Number::New(env, static_cast<double>(clonedNodes)));
+  counts.Set("clonedBytes",
+             Napi::Number::New(env, static_cast<double>(clonedBytes)));
+  return counts;
+}
 } // namespace ae_js_bridge
@@ -0,0 +1,109 @@
+// Generated by scripts/generate-codes.ts from
+//  src/native/StandardFourCharCodes.def. Do not edit by hand.
+
+/** `'null'` */
+export const typeNull = 0x6e756c6c;
+/** `'****'` */
+export const typeWildCard = 0x2a2a2a2a;
+/** `'list'` */
+export const typeAEList = 0x6c697374;
+/** `'reco'` */
+export const typeAERecord = 0x7265636f;
+/** `'aevt'` */
+export const typeAppleEvent = 0x61657674;
+/** `'shor'` */
+export const typeSInt16 = 0x73686f72;
+/** `'long'` */
+export const typeSInt32 = 0x6c6f6e67;
+/** `'comp'` */
+export const typeSInt64 = 0x636f6d70;
+/** `'ushr'` */
+export const typeUInt16 = 0x75736872;
+/** `'magn'` */
+export const typeUInt32 = 0x6d61676e;
+/** `'ucom'` */
+export const typeUInt64 = 0x75636f6d;
+/** `'sing'` */
+export const typeIEEE32BitFloatingPoint = 0x73696e67;
+/** `'doub'` */
+export const typeIEEE64BitFloatingPoint = 0x646f7562;
+/** `'ldbl'` */
+export const type128BitFloatingPoint = 0x6c64626c;
+/** `'decm'` */
+export const typeDecimalStruct = 0x6465636d;
+/** `'bool'` */
+export const typeBoolean = 0x626f6f6c;
+/** `'true'` */
+export const typeTrue = 0x74727565;
+/** `'fals'` */
+export const typeFalse = 0x66616c73;
+/** `'TEXT'` */
+export const typeChar = 0x54455854;
+/** `'utf8'` */
+export const typeUTF8Text = 0x75746638;
+/** `'utxt'` */
+export const typeUnicodeText = 0x75747874;
+/** `'ut16'` */
+export const typeUTF16ExternalRepresentation = 0x75743136;
+/** `'type'` */
+export const typeType = 0x74797065;
+/** `'enum'` */
+export const typeEnumerated = 0x656e756d;
+/** `'keyw'` */
+export const typeKeyword = 0x6b657977;
+/** `'prop'` */
+export const typeProperty = 0x70726f70;
+/** `'abso'` */
+export const typeAbsoluteOrdinal = 0x6162736f;
+/** `'ldt '` */
+export const typeLongDateTime = 0x6c647420;
+/** `'tdta'` */
+export const typeData = 0x74647461;
+/** `'furl'` */
+export const typeFileURL = 0x6675726c;
+/** `'fsrf'` */
+export const typeFSRef = 0x66737266;
+/** `'alis'` */
+export const typeAlias = 0x616c6973;
+/** `'bmrk'` */
+export const typeBookmarkData = 0x626d726b;
+/** `'bund'` */
+export const typeApplicationBundleID = 0x62756e64;
+/** `'aprl'` */
+export const typeApplicationURL = 0x6170726c;
+/** `'kpid'` */
+export const typeKernelProcessID = 0x6b706964;
+/** `'psn '` */
+export const typeProcessSerialNumber = 0x70736e20;
+/** `'obj '` */
+export const typeObjectSpecifier = 0x6f626a20;
+/** `'insl'` */
+export const typeInsertionLoc = 0x696e736c;
+/** `'rang'` */
+export const typeRangeDescriptor = 0x72616e67;
+/** `'cmpd'` */
+export const typeCompDescriptor = 0x636d7064;
+/** `'logi'` */
+export const typeLogicalDescriptor = 0x6c6f6769;
+/** `'whos'` */
+export const typeWhoseDescriptor = 0x77686f73;
+/** `'evcl'` */
+export const keyEventClassAttr = 0x6576636c;
+/** `'evid'` */
+export const keyEventIDAttr = 0x65766964;
+/** `'addr'` */
+export const keyAddressAttr = 0x61646472;
+/** `'rtid'` */
+export const keyReturnIDAttr = 0x72746964;
+/** `'tran'` */
+export const keyTransactionIDAttr = 0x7472616e;
+/** `'timo'` */
+export const keyTimeoutAttr = 0x74696d6f;
+/** `'spid'` */
+export const keySenderPIDAttr = 0x73706964;
+/** `'----'` */
+export const keyDirectObject = 0x2d2d2d2d;
+/** `'errn'` */
+export const keyErrorNumber = 0x6572726e;
+/** `'errs'` */
+export const keyErrorString = 0x65727273;
@@ -1,17 +1,25 @@
 
 import {
     type AEJSBridgeNative,
+    AEDescriptor,
     AENullDescriptor,
     AEDataDescriptor,
     AEListDescriptor,
     AERecordDescriptor,
     AEEventDescriptor,
     AEUnknownDescriptor,
+    AETarget,
     OSError,
     sendAppleEvent,
+    sendAppleEvents,
+    configureSendExecutor,
+    getSendExecutorStats,
     handleAppleEvent,
     unhandleAppleEvent,
+    setFourCharCodeMode,
+    getDescriptorCopyCounts,
 } from './native.js';
+import * as FourCharCodes from './codes.js';
 import { makeErrorParameters } from './util.js';
 
 import { endianness } from 'node:os';
@@ -42,17 +50,6 @@ type DataValueSpec = {
     data: Uint8Array,
 }
 
-function isDataValueSpec(value: unknown): value is DataValueSpec {
-    return (
-        typeof value === 'object'
-        && value !== null
-        && 'type' in value
-        && 'data' in value
-        && typeof value.type === 'string'
-        && value.data instanceof Uint8Array
-    );
-}
-
 /**
  * A specification for a descriptor coercion from a coercible value.
  */
@@ -67,15 +64,12 @@ type ValueCoercionSpec = {
     as: AEJSBridgeNative.DescType,
 }
 
-function isValueCoercionSpec(value: unknown): value is ValueCoercionSpec {
-    return (
-        typeof value === 'object'
-        && value !== null
-        && 'value' in value
-        && 'as' in value
-        && typeof value.as === 'string'
-    );
-}
+/**
+ * The key under which wrappers expose their native descriptor, so the native
+ *  value builder can embed them without going through `toNative()`.
+ */
+const nativeDescriptorKey: unique symbol =
+    Symbol.for('ae_js_bridge.nativeDescriptor');
 
 /**
  * A JavaScript wrapper for an Apple event descriptor.
@@ -95,6 +89,14 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
         this.nativeDescriptor = nativeDescriptor;
     }
 
+    /**
+     * Gets the native descriptor, without copying it.
+     * @returns The native descriptor.
+     */
+    public get [nativeDescriptorKey](): T {
+        return this.nativeDescriptor;
+    }
+
     /**
      * Gets the type of the descriptor.
      * @returns The type of the descriptor.
@@ -119,6 +121,32 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
             ) as AEJSDescriptor<T>;
     }
 
+    /**
+     * Casts each descriptor to the given type in a single native call.
+     * @param descriptors - The descriptors to cast.
+     * @param descriptorType - The type to cast them to.
+     * @returns The cast descriptors, with null for each that couldn't be
+     *  cast, and each one's OSErr code (0 on success).
+     */
+    public static coerceAll(
+        descriptors: AEJSDescriptor<AEJSBridgeNative.AEDescriptor>[],
+        descriptorType: AEJSBridgeNative.DescType
+    ): {
+        results: (AEJSDescriptor<AEJSBridgeNative.AEDescriptor> | null)[];
+        errors: Int32Array;
+    } {
+        const { results, errors } = AEDescriptor.coerceAll(
+            descriptors.map(descriptor => descriptor.nativeDescriptor),
+            descriptorType
+        );
+        return {
+            results: results.map(result => result === null
+                ? null
+                : AEJSDescriptor.fromNative(result)),
+            errors,
+        };
+    }
+
     /**
      * Creates a new Apple event descriptor wrapper from a native descriptor.
      * @param nativeDescriptor - The native descriptor.
@@ -152,12 +180,13 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
     }
 
     /**
-     * Gets a copy of the native descriptor.
-     * @returns A copy of the native descriptor.
+     * Gets a new native wrapper for the descriptor. The descriptor itself is
+     *  shared rather than copied, which is safe because it never changes.
+     * @returns A native wrapper sharing the descriptor.
      */
     public toNative(): T {
         return this.nativeDescriptor
-            // Use coercion to the same type in lieu of a copy constructor.
+            // Casting to the same type shares the descriptor in O(1).
             .as(this.nativeDescriptor.descriptorType);
     }
 
@@ -177,9 +206,7 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
      * @returns The string value of the descriptor.
      */
     public toString(): string {
-        const asString: AEJSBridgeNative.AEDataDescriptor
-            = this.nativeDescriptor.as('utf8');
-        return new TextDecoder('utf-8').decode(asString.data);
+        return this.nativeDescriptor.asUtf8String();
     }
 
     /**
@@ -201,12 +228,25 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
      * @returns The number value of the descriptor.
      */
     public asNumber(): number {
-        const asNumber: AEJSBridgeNative.AEDataDescriptor
-            // 'doub' is IEEE 64-bit floating point number, the
-            //  same as JavaScript's Number type.
-            = this.nativeDescriptor.as('doub');
-        return new DataView(asNumber.data.buffer)
-            .getFloat64(0, endianness() === 'LE');
+        // 'doub' is IEEE 64-bit floating point number, the
+        //  same as JavaScript's Number type.
+        return this.nativeDescriptor.asFloat64();
+    }
+
+    /**
+     * Gets the value of the descriptor as a signed 32-bit integer.
+     * @returns The integer value of the descriptor.
+     */
+    public asInt32(): number {
+        return this.nativeDescriptor.asInt32();
+    }
+
+    /**
+     * Gets the value of the descriptor as a signed 64-bit integer.
+     * @returns The integer value of the descriptor.
+     */
+    public asInt64(): bigint {
+        return this.nativeDescriptor.asInt64();
     }
 
     /**
@@ -226,10 +266,7 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
      */
     public asBoolean(): boolean {
         try {
-            const asBoolean: AEJSBridgeNative.AEDataDescriptor
-                = this.nativeDescriptor.as('bool');
-            return new DataView(asBoolean.data.buffer)
-                .getUint8(0) !== 0;
+            return this.nativeDescriptor.asBool();
         }
         catch (_) {
             throw new TypeError('Descriptor cannot be converted to a boolean');
@@ -313,72 +350,48 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
             | Record<AEJSBridgeNative.AEKeyword, ConvertibleValue>,
         descriptorType: AEJSBridgeNative.DescType | undefined = undefined
     ): AEJSDescriptor<AEJSBridgeNative.AEDescriptor> {
-        // Handle special cases used for convenience
         if (value instanceof AEJSDescriptor) {
             return value;
         }
-        if (isValueCoercionSpec(value)) {
-            return AEJSDescriptor.fromValue(value.value).as(value.as);
-        }
-        if (isDataValueSpec(value)) {
-            return new AEJSDataDescriptor(
-                new AEDataDescriptor(value.type, value.data)
-            );
-        }
+        return AEJSDescriptor.fromNative(
+            AEDescriptor.fromJSValue(value, { descriptorType })
+        );
+    }
 
-        // Handle primitive values
-        if (value === null) {
-            return new AEJSNullDescriptor();
-        }
-        if (typeof value === 'string') {
-            return AEJSDescriptor.fromString(value);
-        }
-        if (typeof value === 'number') {
-            return AEJSDescriptor.fromNumber(value);
-        }
-        if (typeof value === 'boolean') {
-            return AEJSDescriptor.fromBoolean(value);
-        }
+    /**
+     * Flattens the descriptor tree into bytes.
+     * @returns The flattened descriptor.
+     */
+    public serialize(): Buffer {
+        return this.nativeDescriptor.serialize();
+    }
 
-        // Handle array values
-        if (Array.isArray(value)) {
-            return new AEJSListDescriptor(
-                new AEListDescriptor(
-                    descriptorType ?? 'list',
-                    value.map(
-                        item =>
-                            AEJSDescriptor
-                                .fromValue(item)
-                                .toNative()
-                    )
-                )
-            );
-        }
+    /**
+     * Computes a 64-bit hash of the whole descriptor tree.
+     * @returns The hash of the descriptor.
+     */
+    public hash(): bigint {
+        return this.nativeDescriptor.hash();
+    }
 
-        // Handle record values
-        if (typeof value === 'object' && value !== null) {
-            return new AEJSRecordDescriptor(
-                new AERecordDescriptor(
-                    descriptorType ?? 'reco',
-                    Object
-                        .fromEntries(
-                            Object
-                                .entries(value)
-                                .map(
-                                    ([key, value]) =>
-                                        [
-                                            key,
-                                            AEJSDescriptor
-                                                .fromValue(value)
-                                                .toNative()
-                                        ]
-                                )
-                        )
-                )
-            );
-        }
+    /**
+     * Compares two descriptor trees structurally.
+     * @param other - The descriptor wrapper to compare with.
+     * @returns Whether the descriptors are equal.
+     */
+    public equals(other: AEJSDescriptor<AEJSBridgeNative.AEDescriptor>): boolean {
+        return this.nativeDescriptor.equals(other.nativeDescriptor);
+    }
 
-        throw new TypeError('Invalid value');
+    /**
+     * Recreates a descriptor wrapper from the bytes returned by `serialize`.
+     * @param bytes - The flattened descriptor.
+     * @returns The Apple event descriptor wrapper.
+     */
+    public static deserialize(
+        bytes: Uint8Array
+    ): AEJSDescriptor<AEJSBridgeNative.AEDescriptor> {
+        return AEJSDescriptor.fromNative(AEDescriptor.deserialize(bytes));
     }
 
     /**
@@ -386,62 +399,18 @@ abstract class AEJSDescriptor<T extends AEJSBridgeNative.AEDescriptor> {
      * @returns The value of the descriptor.
      */
     public valueOf(): unknown {
-        if (this.nativeDescriptor instanceof AENullDescriptor) {
-            return null;
-        }
-        if (this.nativeDescriptor instanceof AEDataDescriptor) {
-            return {
-                type: this.nativeDescriptor.descriptorType,
-                data: Buffer.from(this.nativeDescriptor.data)
-                    .toString('base64'),
-            };
-        }
-        if (this.nativeDescriptor instanceof AEListDescriptor) {
-            return this.nativeDescriptor.items
-                .map(item => AEJSDescriptor.fromNative(item).valueOf());
-        }
-        if (this.nativeDescriptor instanceof AERecordDescriptor) {
-            return Object
-                .fromEntries(Object
-                    .entries(this.nativeDescriptor.fields)
-                    .map(([key, value]) => [
-                        key,
-                        AEJSDescriptor
-                            .fromNative(value)
-                            .valueOf()
-                    ]));
-        }
-        if (this.nativeDescriptor instanceof AEEventDescriptor) {
-            return {
-                type: this.nativeDescriptor.descriptorType,
-                eventClass: this.nativeDescriptor.eventClass,
-                eventID: this.nativeDescriptor.eventID,
-                target: AEJSDescriptor.fromNative(this.nativeDescriptor.target)
-                    .valueOf(),
-                returnID: this.nativeDescriptor.returnID,
-                transactionID: this.nativeDescriptor.transactionID,
-                parameters: Object
-                    .fromEntries(
-                        Object
-                            .entries(this.nativeDescriptor.parameters)
-                            .map(
-                                ([key, value]) => [
-                                    key,
-                                    AEJSDescriptor
-                                        .fromNative(value)
-                                        .valueOf()
-                                ]
-                            )
-                    ),
-                // Attributes are not iterable, and are thus not serializable.
-            };
-        }
-        if (this.nativeDescriptor instanceof AEUnknownDescriptor) {
-            return {
-                type: this.nativeDescriptor.descriptorType,
-            };
-        }
-        throw new TypeError('Descriptor cannot be converted to a value');
+        return this.nativeDescriptor.toJSValue();
+    }
+
+    /**
+     * Converts the descriptor tree to plain JavaScript values in a single
+     *  native pass.
+     * @param options - The conversion options. Subtrees deeper than
+     *  `maxDepth` are returned as native descriptors.
+     * @returns The value of the descriptor.
+     */
+    public toJSValue(options?: AEJSBridgeNative.ToJSValueOptions): unknown {
+        return this.nativeDescriptor.toJSValue(options);
     }
 
     /**
@@ -477,6 +446,26 @@ class AEJSDataDescriptor
         return this.nativeDescriptor.data;
     }
 
+    /**
+     * Gets a read-only view of the data of the descriptor. The data is copied
+     *  once per descriptor and shared by every view, so treat the view as
+     *  read-only; use `data` for a copy of your own.
+     * @returns A view of the data of the descriptor.
+     */
+    public dataView(): DataView {
+        return this.nativeDescriptor.dataView();
+    }
+
+    /**
+     * Reads part of the data of the descriptor.
+     * @param offset - The byte offset to start reading at.
+     * @param length - The number of bytes to read.
+     * @returns A copy of the requested bytes.
+     */
+    public dataRange(offset: number, length: number): Uint8Array {
+        return this.nativeDescriptor.dataRange(offset, length);
+    }
+
     /**
      * Creates a new JavaScript wrapper for an Apple event data descriptor.
      */
@@ -498,6 +487,91 @@ class AEJSListDescriptor
             .map(item => AEJSDescriptor.fromNative(item));
     }
 
+    /**
+     * The number of items in the descriptor.
+     */
+    public get count(): number {
+        return this.nativeDescriptor.count;
+    }
+
+    /**
+     * Gets a single item of the descriptor without reading the others.
+     * @param index - The zero-based index of the item.
+     * @returns The item, or undefined if the index is out of range.
+     */
+    public itemAt(index: number):
+        AEJSDescriptor<AEJSBridgeNative.AEDescriptor> | undefined {
+        const item = this.nativeDescriptor.itemAt(index);
+        return item === undefined
+            ? undefined
+            : AEJSDescriptor.fromNative(item);
+    }
+
+    /**
+     * Iterates over the items of the descriptor, reading each one
+     *  only when it is reached.
+     */
+    public *[Symbol.iterator]():
+        IterableIterator<AEJSDescriptor<AEJSBridgeNative.AEDescriptor>> {
+        for (const item of this.nativeDescriptor) {
+            yield AEJSDescriptor.fromNative(item);
+        }
+    }
+
+    /**
+     * Iterates over the items of the descriptor in batches, copying and
+     *  classifying them on a worker thread so that huge lists don't stall
+     *  the event loop.
+     * @param options - How to batch the items.
+     */
+    public async *iterate(
+        options?: Omit<AEJSBridgeNative.ListBatchOptions, 'values'>
+    ): AsyncIterableIterator<AEJSDescriptor<AEJSBridgeNative.AEDescriptor>[]> {
+        for await (const batch of this.nativeDescriptor.iterate(options)) {
+            yield batch.map(item => AEJSDescriptor.fromNative(item));
+        }
+    }
+
+    /**
+     * Reads every item as a number in one native call.
+     * @returns The items as 64-bit floats.
+     */
+    public toFloat64Array(): Float64Array {
+        return this.nativeDescriptor.toFloat64Array();
+    }
+
+    /**
+     * Reads every item as a 32-bit integer in one native call.
+     * @returns The items as 32-bit integers.
+     */
+    public toInt32Array(): Int32Array {
+        return this.nativeDescriptor.toInt32Array();
+    }
+
+    /**
+     * Reads every item as a string in one native call.
+     * @returns The items as strings.
+     */
+    public toStringArray(): string[] {
+        return this.nativeDescriptor.toStringArray();
+    }
+
+    /**
+     * Builds a list of numbers in one native call.
+     * @param type - The item type: 'shor', 'long', 'magn', 'comp', 'ucom',
+     *  'sing' or 'doub'.
+     * @param array - The values of the items.
+     * @returns The list descriptor.
+     */
+    public static fromTypedArray(
+        type: AEJSBridgeNative.DescType,
+        array: AEJSBridgeNative.NumericTypedArray
+    ): AEJSListDescriptor {
+        return new AEJSListDescriptor(
+            AEListDescriptor.fromTypedArray(type, array)
+        );
+    }
+
     /**
      * Creates a new JavaScript wrapper for an Apple event list descriptor.
      */
@@ -521,6 +595,65 @@ class AEJSRecordDescriptor
                 .map(([key, value]) => [key, AEJSDescriptor.fromNative(value)]));
     }
 
+    /**
+     * The number of fields in the descriptor.
+     */
+    public get count(): number {
+        return this.nativeDescriptor.count;
+    }
+
+    /**
+     * Gets a single field of the descriptor without reading the others.
+     * @param keyword - The keyword of the field.
+     * @returns The field, or undefined if the descriptor has no such field.
+     */
+    public getField(keyword: AEJSBridgeNative.AEKeyword):
+        AEJSDescriptor<AEJSBridgeNative.AEDescriptor> | undefined {
+        const field = this.nativeDescriptor.getField(keyword);
+        return field === undefined
+            ? undefined
+            : AEJSDescriptor.fromNative(field);
+    }
+
+    /**
+     * Checks for a field without copying it out of the descriptor.
+     * @param keyword - The keyword of the field.
+     * @returns Whether the descriptor has a field with the keyword.
+     */
+    public hasField(keyword: AEJSBridgeNative.AEKeyword): boolean {
+        return this.nativeDescriptor.hasField(keyword);
+    }
+
+    /**
+     * Lists the keywords of the descriptor's fields without reading the
+     *  fields themselves.
+     * @returns The keywords of the fields, in order.
+     */
+    public keys(): AEJSBridgeNative.AEKeyword[] {
+        return this.nativeDescriptor.keys();
+    }
+
+    /**
+     * @deprecated Use `getField`.
+     */
+    public fieldAt(keyword: AEJSBridgeNative.AEKeyword):
+        AEJSDescriptor<AEJSBridgeNative.AEDescriptor> | undefined {
+        return this.getField(keyword);
+    }
+
+    /**
+     * Iterates over the `[keyword, field]` entries of the descriptor,
+     *  reading each one only when it is reached.
+     */
+    public *[Symbol.iterator](): IterableIterator<[
+        AEJSBridgeNative.AEKeyword,
+        AEJSDescriptor<AEJSBridgeNative.AEDescriptor>
+    ]> {
+        for (const [keyword, field] of this.nativeDescriptor) {
+            yield [keyword, AEJSDescriptor.fromNative(field)];
+        }
+    }
+
     /**
      * Creates a new JavaScript wrapper for an Apple event record descriptor.
      */
@@ -590,6 +723,42 @@ class AEJSEventDescriptor
             );
     }
 
+    /**
+     * Gets a single parameter of the descriptor without reading the others.
+     * @param keyword - The keyword of the parameter.
+     * @returns The parameter, or undefined if there is no such parameter.
+     */
+    public getParameter(keyword: AEJSBridgeNative.AEKeyword):
+        AEJSDescriptor<AEJSBridgeNative.AEDescriptor> | undefined {
+        const parameter = this.nativeDescriptor.getParameter(keyword);
+        return parameter === undefined
+            ? undefined
+            : AEJSDescriptor.fromNative(parameter);
+    }
+
+    /**
+     * Reads a parameter as text, without wrapping it in a descriptor.
+     * @param keyword - The keyword of the parameter.
+     * @returns The text, or undefined if there is no such parameter.
+     */
+    public getParameterString(
+        keyword: AEJSBridgeNative.AEKeyword
+    ): string | undefined {
+        return this.nativeDescriptor.getParameterString(keyword);
+    }
+
+    /**
+     * Reads a parameter as a 32-bit signed integer, without wrapping it in a
+     *  descriptor.
+     * @param keyword - The keyword of the parameter.
+     * @returns The integer, or undefined if there is no such parameter.
+     */
+    public getParameterInt32(
+        keyword: AEJSBridgeNative.AEKeyword
+    ): number | undefined {
+        return this.nativeDescriptor.getParameterInt32(keyword);
+    }
+
     /**
      * Gets an attribute of the descriptor.
      * @param keyword - The keyword of the attribute.
@@ -603,6 +772,21 @@ class AEJSEventDescriptor
             : AEJSDescriptor.fromNative(attribute);
     }
 
+    /**
+     * Gets several attributes of the descriptor in one call.
+     * @param keywords - The keywords of the attributes.
+     * @returns The attributes, in the same order as `keywords`, with undefined
+     *  for any the descriptor doesn't have.
+     */
+    public getAttributes(keywords: AEJSBridgeNative.AEKeyword[]):
+        (AEJSDescriptor<AEJSBridgeNative.AEDescriptor> | undefined)[] {
+        return this.nativeDescriptor
+            .getAttributes(keywords)
+            .map(attribute => attribute === undefined
+                ? undefined
+                : AEJSDescriptor.fromNative(attribute));
+    }
+
     /**
      * Creates a new JavaScript wrapper for an Apple event event descriptor.
      */
@@ -618,29 +802,207 @@ class AEJSUnknownDescriptor
     extends AEJSDescriptor<AEJSBridgeNative.AEUnknownDescriptor> {
 }
 
+/**
+ * A JavaScript wrapper for a target application, whose address descriptor is
+ *  built once and reused for every event created against it.
+ */
+class AEJSTarget {
+    private readonly nativeTarget: AEJSBridgeNative.AETarget;
+
+    /**
+     * Creates a new target, resolving it if it is given by bundle ID.
+     * @param spec - How to address the target.
+     */
+    public constructor(spec: AEJSBridgeNative.AETargetSpec) {
+        this.nativeTarget = new AETarget(spec);
+    }
+
+    /**
+     * The address descriptor events are created with.
+     */
+    public get address(): AEJSDescriptor<AEJSBridgeNative.AEDescriptor> {
+        return AEJSDescriptor.fromNative(this.nativeTarget.address);
+    }
+
+    /**
+     * The process the target is addressed to, or null if it isn't addressed
+     *  by process ID.
+     */
+    public get pid(): number | null {
+        return this.nativeTarget.pid;
+    }
+
+    /**
+     * Checks whether the target is running.
+     * @returns Whether the target is running, or null for URL targets.
+     */
+    public isAlive(): boolean | null {
+        return this.nativeTarget.isAlive();
+    }
+
+    /**
+     * Looks the target's bundle ID up again. Meant for after a send has
+     *  failed with `procNotFound`.
+     * @returns Whether the target is running afterwards, or null for URL
+     *  targets.
+     */
+    public resolve(): boolean | null {
+        return this.nativeTarget.resolve();
+    }
+
+    /**
+     * Creates an event addressed to the target.
+     * @param eventClass - The event class of the event.
+     * @param eventID - The event ID of the event.
+     * @param parameters - The parameters of the event.
+     * @param attributes - The attributes of the event.
+     * @param returnID - The return ID of the event, an integer from -32768
+     *  to 32767; anything else throws a RangeError.
+     * @param transactionID - The transaction ID of the event, an integer from
+     *  -2147483648 to 2147483647; anything else throws a RangeError.
+     */
+    public createEvent(
+        eventClass: AEJSBridgeNative.AEEventClass,
+        eventID: AEJSBridgeNative.AEEventID,
+        parameters: Record<
+            AEJSBridgeNative.AEKeyword,
+            AEJSDescriptor<AEJSBridgeNative.AEDescriptor>
+        > = {},
+        attributes: Record<
+            AEJSBridgeNative.AEKeyword,
+            AEJSDescriptor<AEJSBridgeNative.AEDescriptor>
+        > = {},
+        returnID?: number,
+        transactionID?: number
+    ): AEJSEventDescriptor {
+        const toNative = (
+            map: Record<
+                AEJSBridgeNative.AEKeyword,
+                AEJSDescriptor<AEJSBridgeNative.AEDescriptor>
+            >
+        ) => Object.fromEntries(Object
+            .entries(map)
+            .map(([key, value]) => [key, value[nativeDescriptorKey]]));
+        return new AEJSEventDescriptor(this.nativeTarget.createEvent(
+            eventClass,
+            eventID,
+            toNative(parameters),
+            toNative(attributes),
+            returnID,
+            transactionID
+        ));
+    }
+
+    /**
+     * Gets the native target.
+     */
+    public toNative(): AEJSBridgeNative.AETarget {
+        return this.nativeTarget;
+    }
+}
+
 /**
  * Sends an Apple event.
  * @param event - The event to send.
- * @param expectReply - Whether to expect a reply from the event.
- * @returns The reply to the event.
+ * @param expectReply - Whether to expect a reply from the event. May be left
+ *  out, in which case `options.expectReply` decides (defaulting to true).
+ * @param options - How to send the event and return its reply.
+ * @returns The reply to the event, or its decoded parameters when
+ *  `options.decodeReply` is set.
  */
 async function sendJSAppleEvent(
     event: AEJSEventDescriptor,
-    expectReply: true
+    expectReply: true,
+    options: AEJSBridgeNative.SendAppleEventOptions & {
+        decodeReply: true | AEJSBridgeNative.ToJSValueOptions
+    }
+): Promise<Record<AEJSBridgeNative.AEKeyword, unknown>>;
+async function sendJSAppleEvent(
+    event: AEJSEventDescriptor,
+    expectReply: true,
+    options?: AEJSBridgeNative.SendAppleEventOptions & { decodeReply?: false }
 ): Promise<AEJSEventDescriptor>;
 async function sendJSAppleEvent(
     event: AEJSEventDescriptor,
-    expectReply: false
+    expectReply: false,
+    options?: AEJSBridgeNative.SendAppleEventOptions
 ): Promise<null>;
 async function sendJSAppleEvent(
     event: AEJSEventDescriptor,
-    expectReply: boolean
-): Promise<AEJSEventDescriptor | null> {
-    const nativeResult =
-        await sendAppleEvent(event.toNative(), expectReply);
-    return nativeResult === null
-        ? null
-        : new AEJSEventDescriptor(nativeResult);
+    expectReply: boolean,
+    options?: AEJSBridgeNative.SendAppleEventOptions
+): Promise<
+    AEJSEventDescriptor | Record<AEJSBridgeNative.AEKeyword, unknown> | null
+>;
+async function sendJSAppleEvent(
+    event: AEJSEventDescriptor,
+    options: AEJSBridgeNative.SendAppleEventOptions & {
+        expectReply?: true,
+        decodeReply: true | AEJSBridgeNative.ToJSValueOptions
+    }
+): Promise<Record<AEJSBridgeNative.AEKeyword, unknown>>;
+async function sendJSAppleEvent(
+    event: AEJSEventDescriptor,
+    options?: AEJSBridgeNative.SendAppleEventOptions & {
+        expectReply?: true,
+        decodeReply?: false
+    }
+): Promise<AEJSEventDescriptor>;
+async function sendJSAppleEvent(
+    event: AEJSEventDescriptor,
+    options: AEJSBridgeNative.SendAppleEventOptions & { expectReply: false }
+): Promise<null>;
+async function sendJSAppleEvent(
+    event: AEJSEventDescriptor,
+    options?: AEJSBridgeNative.SendAppleEventOptions
+): Promise<
+    AEJSEventDescriptor | Record<AEJSBridgeNative.AEKeyword, unknown> | null
+>;
+async function sendJSAppleEvent(
+    event: AEJSEventDescriptor,
+    expectReplyOrOptions?: boolean | AEJSBridgeNative.SendAppleEventOptions,
+    options?: AEJSBridgeNative.SendAppleEventOptions
+): Promise<
+    AEJSEventDescriptor | Record<AEJSBridgeNative.AEKeyword, unknown> | null
+> {
+    const nativeResult = typeof expectReplyOrOptions === 'boolean'
+        ? await sendAppleEvent(event.toNative(), expectReplyOrOptions, options)
+        : await sendAppleEvent(event.toNative(), expectReplyOrOptions);
+    if (nativeResult === null)
+        return null;
+    return nativeResult instanceof AEEventDescriptor
+        ? new AEJSEventDescriptor(nativeResult)
+        : nativeResult;
+}
+
+/**
+ * Sends a batch of Apple events in one call. The sends are pipelined across
+ *  the send threads, and one failing doesn't fail the others.
+ * @param events - The events to send.
+ * @param options - How to send the events and return their replies, for all
+ *  of them.
+ * @returns Each send's reply (or decoded parameters, or null) and error (or
+ *  null), in the order of `events`.
+ */
+async function sendJSAppleEvents(
+    events: AEJSEventDescriptor[],
+    options?: AEJSBridgeNative.SendAppleEventOptions
+): Promise<{
+    results: (
+        AEJSEventDescriptor | Record<AEJSBridgeNative.AEKeyword, unknown> | null
+    )[];
+    errors: (Error | null)[];
+}> {
+    const { results, errors } = await sendAppleEvents(
+        events.map(event => event.toNative()),
+        options
+    );
+    return {
+        results: results.map(result => result instanceof AEEventDescriptor
+            ? new AEJSEventDescriptor(result)
+            : result),
+        errors,
+    };
 }
 
 
@@ -702,6 +1064,8 @@ function jsResultToNativeResult(
  *  is received with the given event class and event ID.
  * The handler function should return an object of parameters if
  *  a reply is expected, or null if a reply is not expected.
+ * Throws for `aevt/ansr`, which the bridge handles itself to match
+ *  replies to `queueReply` sends.
  */
 function handleJSAppleEvent(
     eventClass: AEJSBridgeNative.AEEventClass,
@@ -741,7 +1105,8 @@ function handleJSAppleEvent(
 }
 /**
  * Deregisters an Apple event handler for the given event class and event ID.
- * If no handler is registered for the pair, this is a no-op.
+ * If no handler is registered for the pair, this is a no-op. Throws for
+ *  `aevt/ansr`, whose handler belongs to the bridge.
  * @param eventClass - The event class of the Apple event handler.
  * @param eventID - The event ID of the Apple event handler.
  */
@@ -759,8 +1124,15 @@ export {
     AEJSRecordDescriptor,
     AEJSEventDescriptor,
     AEJSUnknownDescriptor,
+    AEJSTarget,
     OSError, // re-export for convenience
     sendJSAppleEvent,
+    sendJSAppleEvents,
     handleJSAppleEvent,
     unhandleJSAppleEvent,
+    setFourCharCodeMode, // re-export for convenience
+    getDescriptorCopyCounts, // re-export for convenience
+    configureSendExecutor, // re-export for convenience
+    getSendExecutorStats, // re-export for convenience
+    FourCharCodes,
 };
@@ -14,10 +14,16 @@ const {
     AERecordDescriptor,
     AEEventDescriptor,
     AEUnknownDescriptor,
+    AETarget,
     OSError,
     sendAppleEvent,
+    sendAppleEvents,
+    configureSendExecutor,
+    getSendExecutorStats,
     handleAppleEvent,
     unhandleAppleEvent,
+    setFourCharCodeMode,
+    getDescriptorCopyCounts,
 } = _binding;
 export {
     AEDescriptor,
@@ -27,9 +33,15 @@ export {
     AERecordDescriptor,
     AEEventDescriptor,
     AEUnknownDescriptor,
+    AETarget,
     OSError,
     sendAppleEvent,
+    sendAppleEvents,
+    configureSendExecutor,
+    getSendExecutorStats,
     handleAppleEvent,
     unhandleAppleEvent,
+    setFourCharCodeMode,
+    getDescriptorCopyCounts,
 };
 export type { _bindingType as AEJSBridgeNative };
@@ -0,0 +1,596 @@
+// Round-trips descriptors through CoreServices' flattened form, checks
+//  that truncated or damaged input is turned away instead of read past its
+//  end, and checks the coercions the engine stands in for CoreServices with.
+//  Run as `build/Release/ae_js_descriptor_engine_test`.
+
+#include "AEPortable.h"
+#include "TestSupport.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Engine = ae_js_bridge::DescriptorEngine;
+
+namespace {
+constexpr AEKeyword kNameKey = Engine::MakeCode("name");
+constexpr AEKeyword kListKey = Engine::MakeCode("list");
+constexpr AEKeyword kNoneKey = Engine::MakeCode("none");
+
+std::vector<char> Flatten(const AEDesc &desc) {
+  std::vector<char> bytes(static_cast<size_t>(AESizeOfFlattenedDesc(&desc)));
+  Size written = 0;
+  AEJS_CHECK(AEFlattenDesc(&desc, bytes.data(),
+                           static_cast<Size>(bytes.size()), &written) == noErr);
+  AEJS_CHECK(written == static_cast<Size>(bytes.size()));
+  return bytes;
+}
+
+// Unflattens `desc`'s flattened form, and checks that flattening the result
+//  gives the same bytes back.
+void CheckRoundTrip(const AEDesc &desc) {
+  const std::vector<char> bytes = Flatten(desc);
+  AEDesc unflattened;
+  if (!AEJS_CHECK(AEUnflattenDesc(bytes.data(), &unflattened) == noErr)) {
+    return;
+  }
+  AEJS_CHECK(unflattened.descriptorType == desc.descriptorType);
+  AEJS_CHECK(Flatten(unflattened) == bytes);
+  AEDisposeDesc(&unflattened);
+}
+
+AEDesc MakeText(const char *text) {
+  AEDesc desc;
+  AECreateDesc(typeUTF8Text, text, static_cast<Size>(std::strlen(text)),
+               &desc);
+  return desc;
+}
+
+AEDesc MakeInt(int32_t value) {
+  AEDesc desc;
+  AECreateDesc(typeSInt32, &value, sizeof(value), &desc);
+  return desc;
+}
+
+// Coerces `desc` to `toType` and reads the result back as a `T`, checking it
+//  is exactly that size.
+template <typename T>
+OSErr CoerceTo(const AEDesc &desc, DescType toType, T *out) {
+  AEDesc coerced;
+  const OSErr error = AECoerceDesc(&desc, toType, &coerced);
+  if (error != noErr) {
+    AEJS_CHECK(coerced.descriptorType == typeNull);
+    return error;
+  }
+  AEJS_CHECK(coerced.descriptorType == toType);
+  AEJS_CHECK(AEGetDescDataSize(&coerced) == sizeof(T));
+  AEGetDescData(&coerced, out, sizeof(T));
+  AEDisposeDesc(&coerced);
+  return noErr;
+}
+
+// Like `CoerceTo`, for text types; 'utxt' is read back by way of 'utf8'.
+OSErr CoerceToText(const AEDesc &desc, DescType toType, std::string *out) {
+  AEDesc coerced;
+  OSErr error = AECoerceDesc(&desc, toType, &coerced);
+  if (error != noErr) {
+    AEJS_CHECK(coerced.descriptorType == typeNull);
+    return error;
+  }
+  AEJS_CHECK(coerced.descriptorType == toType);
+  if (toType == typeUnicodeText) {
+    AEDesc utf8;
+    error = AECoerceDesc(&coerced, typeUTF8Text, &utf8);
+    AEDisposeDesc(&coerced);
+    if (error != noErr) {
+      return error;
+    }
+    coerced = utf8;
+  }
+  out->resize(static_cast<size_t>(AEGetDescDataSize(&coerced)));
+  AEGetDescData(&coerced, out->data(), static_cast<Size>(out->size()));
+  AEDisposeDesc(&coerced);
+  return noErr;
+}
+
+// A record holding a list holding a record, with a few scalars throughout.
+AEDesc MakeNested() {
+  AEDesc inner;
+  AECreateList(nullptr, 0, true, &inner);
+  AEDesc text = MakeText("inner");
+  AEPutKeyDesc(&inner, kNameKey, &text);
+  AEDisposeDesc(&text);
+
+  AEDesc list;
+  AECreateList(nullptr, 0, false, &list);
+  for (int32_t index = 0; index < 3; ++index) {
+    AEDesc item = MakeInt(index);
+    AEPutDesc(&list, 0, &item);
+    AEDisposeDesc(&item);
+  }
+  AEPutDesc(&list, 0, &inner);
+  AEDisposeDesc(&inner);
+
+  AEDesc outer;
+  AECreateList(nullptr, 0, true, &outer);
+  AEPutKeyDesc(&outer, kListKey, &list);
+  AEDisposeDesc(&list);
+  AEDesc null;
+  AEInitializeDesc(&null);
+  AEPutKeyDesc(&outer, kNoneKey, &null);
+  return outer;
+}
+
+void TestScalarsRoundTrip() {
+  AEDesc null;
+  AEInitializeDesc(&null);
+  CheckRoundTrip(null);
+
+  AEDesc text = MakeText("hello, world");
+  CheckRoundTrip(text);
+  AEDisposeDesc(&text);
+
+  AEDesc empty = MakeText("");
+  CheckRoundTrip(empty);
+  AEDisposeDesc(&empty);
+
+  const double number = 2.5;
+  AEDesc doub;
+  AECreateDesc(typeIEEE64BitFloatingPoint, &number, sizeof(number), &doub);
+  CheckRoundTrip(doub);
+  AEDisposeDesc(&doub);
+}
+
+void TestNestedRoundTrip() {
+  AEDesc nested = MakeNested();
+  CheckRoundTrip(nested);
+
+  const std::vector<char> bytes = Flatten(nested);
+  AEDesc unflattened;
+  AEJS_CHECK(AEUnflattenDesc(bytes.data(), &unflattened) == noErr);
+  long count = 0;
+  AEJS_CHECK(AECountItems(&unflattened, &count) == noErr && count == 2);
+  AEDesc list;
+  AEJS_CHECK(AEGetKeyDesc(&unflattened, kListKey, typeWildCard, &list) ==
+             noErr);
+  AEJS_CHECK(AECountItems(&list, &count) == noErr && count == 4);
+  AEDisposeDesc(&list);
+  AEDisposeDesc(&unflattened);
+
+  // Retyped records keep their type.
+  nested.descriptorType = typeObjectSpecifier;
+  CheckRoundTrip(nested);
+  AEDisposeDesc(&nested);
+}
+
+void TestEventRoundTrip() {
+  const int32_t pid = 42;
+  AEDesc target;
+  AECreateDesc(typeKernelProcessID, &pid, sizeof(pid), &target);
+  AEDesc event;
+  AEJS_CHECK(AECreateAppleEvent(Engine::MakeCode("core"),
+                                Engine::MakeCode("getd"), &target, 7, 0,
+                                &event) == noErr);
+  AEDisposeDesc(&target);
+
+  AEDesc nested = MakeNested();
+  AEPutParamDesc(&event, keyDirectObject, &nested);
+  AEDisposeDesc(&nested);
+  CheckRoundTrip(event);
+
+  const std::vector<char> bytes = Flatten(event);
+  AEDesc unflattened;
+  AEJS_CHECK(AEUnflattenDesc(bytes.data(), &unflattened) == noErr);
+  AEReturnID returnID = 0;
+  AEJS_CHECK(AEGetAttributePtr(&unflattened, keyReturnIDAttr, typeSInt16,
+                               nullptr, &returnID, sizeof(returnID),
+                               nullptr) == noErr &&
+             returnID == 7);
+  AEDisposeDesc(&unflattened);
+  AEDisposeDesc(&event);
+}
+
+// The layout CoreServices flattens to, byte for byte.
+void TestFlattenedLayout() {
+  AEDesc text = MakeText("abc");
+  const std::vector<char> textBytes = Flatten(text);
+  // Odd-length data is padded to an even length, but its size isn't.
+  const char expectedText[] = "dle2\0\0\0\0utf8\0\0\0\x03"
+                              "abc\0";
+  AEJS_CHECK(textBytes == std::vector<char>(expectedText,
+                                            expectedText + 20));
+
+  AEDesc record;
+  AECreateList(nullptr, 0, true, &record);
+  AEPutKeyDesc(&record, kNameKey, &text);
+  AEDisposeDesc(&text);
+  const std::vector<char> recordBytes = Flatten(record);
+  const char expectedRecord[] = "dle2\0\0\0\0reco\0\0\0\x20"
+                                "\0\0\0\0\0\0\0\0reco\0\0\0\x01"
+                                "nameutf8\0\0\0\x03"
+                                "abc\0";
+  AEJS_CHECK(recordBytes == std::vector<char>(expectedRecord,
+                                              expectedRecord + 48));
+  size_t declared = 0;
+  AEJS_CHECK(Engine::FlattenedSizeFromHeader(recordBytes.data(), &declared) ==
+                 noErr &&
+             declared == recordBytes.size());
+
+  // A retyped record keeps its header, which is what tells it apart from data
+  //  of the same type.
+  record.descriptorType = typeObjectSpecifier;
+  std::vector<char> retyped = Flatten(record);
+  AEDesc out;
+  AEJS_CHECK(AEUnflattenDesc(retyped.data(), &out) == noErr &&
+             out.descriptorType == typeObjectSpecifier && AECheckIsRecord(&out));
+  AEDisposeDesc(&out);
+  retyped[27] = 'x';
+  AEJS_CHECK(AEUnflattenDesc(retyped.data(), &out) == noErr &&
+             out.descriptorType == typeObjectSpecifier &&
+             !AECheckIsRecord(&out) && AEGetDescDataSize(&out) == 32);
+  AEDisposeDesc(&out);
+  AEDisposeDesc(&record);
+}
+
+// How many nodes copy-on-write has cloned since `start`.
+uint64_t ClonedSince(const Engine::CopyCounts &start) {
+  return Engine::GetCopyCounts().clonedNodes - start.clonedNodes;
+}
+
+void TestSharingClonesOnlyOnWrite() {
+  AEDesc nested = MakeNested();
+  Engine::CopyCounts start = Engine::GetCopyCounts();
+
+  // Duplicating shares the whole tree.
+  AEDesc duplicate;
+  AEJS_CHECK(AEDuplicateDesc(&nested, &duplicate) == noErr &&
+             duplicate.dataHandle == nested.dataHandle);
+  AEJS_CHECK(ClonedSince(start) == 0);
+
+  // So does putting it into a parent that isn't shared.
+  AEDesc parent;
+  AECreateList(nullptr, 0, false, &parent);
+  AEJS_CHECK(AEPutDesc(&parent, 0, &nested) == noErr);
+  AEJS_CHECK(AEPutKeyDesc(&duplicate, kNoneKey, &parent) == noErr);
+  // ...except that `duplicate` is shared with `nested`, so the record itself
+  //  is cloned, once, and none of its fields are.
+  AEJS_CHECK(ClonedSince(start) == 1);
+  AEJS_CHECK(Engine::GetCopyCounts().clonedBytes == start.clonedBytes);
+  AEJS_CHECK(duplicate.dataHandle != nested.dataHandle);
+  AEDesc field;
+  AEJS_CHECK(AEGetKeyDesc(&nested, kNoneKey, typeWildCard, &field) == noErr &&
+             field.descriptorType == typeNull);
+  AEDisposeDesc(&field);
+
+  // Once unshared, `duplicate` takes writes without cloning. `parent` is still
+  //  shared with the field it was put into, so writing to it clones it.
+  start = Engine::GetCopyCounts();
+  AEDesc text = MakeText("more");
+  AEJS_CHECK(AEPutKeyDesc(&duplicate, kNameKey, &text) == noErr);
+  AEJS_CHECK(ClonedSince(start) == 0);
+  AEJS_CHECK(AEPutDesc(&parent, 1, &text) == noErr);
+  AEJS_CHECK(AEPutDesc(&parent, 0, &text) == noErr);
+  AEJS_CHECK(ClonedSince(start) == 1);
+
+  // A field read back out is shared with its record, so writing to it clones
+  //  that one node and leaves the record's copy alone.
+  AEDesc list;
+  AEJS_CHECK(AEGetKeyDesc(&nested, kListKey, typeWildCard, &list) == noErr);
+  start = Engine::GetCopyCounts();
+  AEJS_CHECK(AEPutDesc(&list, 0, &text) == noErr);
+  AEJS_CHECK(ClonedSince(start) == 1);
+  long count = 0;
+  AEJS_CHECK(AECountItems(&list, &count) == noErr && count == 5);
+  AEDisposeDesc(&list);
+  AEJS_CHECK(AEGetKeyDesc(&nested, kListKey, typeWildCard, &list) == noErr);
+  AEJS_CHECK(AECountItems(&list, &count) == noErr && count == 4);
+  AEDisposeDesc(&list);
+  AEDisposeDesc(&text);
+
+  AEDisposeDesc(&parent);
+  AEDisposeDesc(&duplicate);
+  AEDisposeDesc(&nested);
+}
+
+// Putting a container into itself puts its contents as they were, rather
+//  than making it its own descendant.
+void TestPuttingIntoItself() {
+  AEDesc list;
+  AECreateList(nullptr, 0, false, &list);
+  AEDesc item = MakeInt(1);
+  AEPutDesc(&list, 0, &item);
+  AEDisposeDesc(&item);
+  Engine::CopyCounts start = Engine::GetCopyCounts();
+  AEJS_CHECK(AEPutDesc(&list, 0, &list) == noErr);
+  // The list had to be cloned to leave the item it now holds unchanged.
+  AEJS_CHECK(ClonedSince(start) == 1);
+  long count = 0;
+  AEJS_CHECK(AECountItems(&list, &count) == noErr && count == 2);
+  AEDesc inner;
+  AEJS_CHECK(AEGetNthDesc(&list, 2, typeWildCard, nullptr, &inner) == noErr);
+  AEJS_CHECK(AECountItems(&inner, &count) == noErr && count == 1);
+  AEJS_CHECK(inner.dataHandle != list.dataHandle);
+  AEDisposeDesc(&inner);
+  // Replacing an item with the list works the same way.
+  AEJS_CHECK(AEPutDesc(&list, 1, &list) == noErr);
+  CheckRoundTrip(list);
+  AEDisposeDesc(&list);
+
+  AEDesc record;
+  AECreateList(nullptr, 0, true, &record);
+  AEJS_CHECK(AEPutKeyDesc(&record, kNameKey, &record) == noErr);
+  AEDesc field;
+  AEJS_CHECK(AEGetKeyDesc(&record, kNameKey, typeWildCard, &field) == noErr);
+  AEJS_CHECK(AECountItems(&field, &count) == noErr && count == 0);
+  AEDisposeDesc(&field);
+  CheckRoundTrip(record);
+  AEDisposeDesc(&record);
+
+  AEDesc event;
+  AEJS_CHECK(AECreateAppleEvent(Engine::MakeCode("core"),
+                                Engine::MakeCode("getd"), nullptr, 7, 0,
+                                &event) == noErr);
+  AEJS_CHECK(AEPutAttributeDesc(&event, kNameKey, &event) == noErr);
+  AEDesc attribute;
+  AEJS_CHECK(AEGetAttributeDesc(&event, kNameKey, typeWildCard, &attribute) ==
+             noErr);
+  AEJS_CHECK(AEGetAttributeDesc(&attribute, kNameKey, typeWildCard, &field) ==
+             errAEDescNotFound);
+  AEDisposeDesc(&attribute);
+  CheckRoundTrip(event);
+  AEDisposeDesc(&event);
+}
+
+void TestShortInputIsRejected() {
+  AEDesc nested = MakeNested();
+  const std::vector<char> bytes = Flatten(nested);
+  AEDisposeDesc(&nested);
+
+  // Every prefix is too short, header or no header.
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    AEDesc out;
+    AEJS_CHECK(Engine::Unflatten(bytes.data(), size, &out) ==
+               errAECorruptData);
+    AEJS_CHECK(out.descriptorType == typeNull);
+  }
+
+  // The header gives the exact size, so a truncated buffer can be told apart
+  //  before anything past the header is read.
+  size_t declared = 0;
+  AEJS_CHECK(Engine::FlattenedSizeFromHeader(bytes.data(), &declared) ==
+             noErr);
+  AEJS_CHECK(declared == bytes.size());
+
+  std::vector<char> wrongMagic = bytes;
+  wrongMagic[0] ^= 0x01;
+  AEJS_CHECK(Engine::FlattenedSizeFromHeader(wrongMagic.data(), &declared) ==
+             errAECorruptData);
+  AEDesc out;
+  AEJS_CHECK(AEUnflattenDesc(wrongMagic.data(), &out) == errAECorruptData);
+
+  // Trailing bytes aren't part of any descriptor.
+  std::vector<char> padded = bytes;
+  padded.push_back(0);
+  AEJS_CHECK(Engine::Unflatten(padded.data(), padded.size(), &out) ==
+             errAECorruptData);
+}
+
+void TestDamagedInputIsContained() {
+  AEDesc nested = MakeNested();
+  const std::vector<char> bytes = Flatten(nested);
+  AEDisposeDesc(&nested);
+
+  // Whatever a damaged byte does to the sizes inside, the reader stays within
+  //  the buffer: each attempt either fails or yields a whole descriptor.
+  for (size_t index = Engine::FlattenedHeaderSize; index < bytes.size();
+       ++index) {
+    for (int bit = 0; bit < 8; ++bit) {
+      std::vector<char> damaged = bytes;
+      damaged[index] = static_cast<char>(damaged[index] ^ (1 << bit));
+      AEDesc out;
+      const OSErr error =
+          Engine::Unflatten(damaged.data(), damaged.size(), &out);
+      // Checking without building agrees with unflattening.
+      AEJS_CHECK(Engine::CheckFlattened(damaged.data(), damaged.size()) ==
+                 error);
+      if (error == noErr) {
+        AEJS_CHECK(Flatten(out).size() == damaged.size());
+        AEDisposeDesc(&out);
+      } else {
+        AEJS_CHECK(out.descriptorType == typeNull);
+      }
+    }
+  }
+}
+void TestNumericCoercions() {
+  AEDesc answer = MakeInt(42);
+  double doub = 0;
+  AEJS_CHECK(CoerceTo(answer, typeIEEE64BitFloatingPoint, &doub) == noErr &&
+             doub == 42);
+  uint64_t ucom = 0;
+  AEJS_CHECK(CoerceTo(answer, typeUInt64, &ucom) == noErr && ucom == 42);
+  std::string text;
+  AEJS_CHECK(CoerceToText(answer, typeChar, &text) == noErr && text == "42");
+  AEDisposeDesc(&answer);
+
+  // Values that don't fit the type they are coerced to fail, rather than wrap.
+  AEDesc big = MakeInt(70000);
+  int16_t shor = 0;
+  AEJS_CHECK(CoerceTo(big, typeSInt16, &shor) == errAECoercionFail);
+  AEDisposeDesc(&big);
+  AEDesc negative = MakeInt(-1);
+  uint32_t magn = 0;
+  AEJS_CHECK(CoerceTo(negative, typeUInt32, &magn) == errAECoercionFail);
+  AEDisposeDesc(&negative);
+  const uint64_t most = std::numeric_limits<uint64_t>::max();
+  AEDesc huge;
+  AECreateDesc(typeUInt64, &most, sizeof(most), &huge);
+  int64_t comp = 0;
+  AEJS_CHECK(CoerceTo(huge, typeSInt64, &comp) == errAECoercionFail);
+  AEJS_CHECK(CoerceToText(huge, typeUTF8Text, &text) == noErr &&
+             text == "18446744073709551615");
+  AEDisposeDesc(&huge);
+
+  // Floating point rounds to the nearest integer, and has to be finite.
+  const double fraction = 2.75;
+  AEDesc floating;
+  AECreateDesc(typeIEEE64BitFloatingPoint, &fraction, sizeof(fraction),
+               &floating);
+  int32_t integer = 0;
+  AEJS_CHECK(CoerceTo(floating, typeSInt32, &integer) == noErr &&
+             integer == 3);
+  float sing = 0;
+  AEJS_CHECK(CoerceTo(floating, typeIEEE32BitFloatingPoint, &sing) == noErr &&
+             sing == 2.75f);
+  AEJS_CHECK(CoerceToText(floating, typeUTF8Text, &text) == noErr &&
+             text == "2.75");
+  AEDisposeDesc(&floating);
+  const double infinity = std::numeric_limits<double>::infinity();
+  AEDesc infinite;
+  AECreateDesc(typeIEEE64BitFloatingPoint, &infinity, sizeof(infinity),
+               &infinite);
+  AEJS_CHECK(CoerceTo(infinite, typeSInt64, &comp) == errAECoercionFail);
+  AEDisposeDesc(&infinite);
+
+  // Data too short for its own type is corrupt, not merely uncoercible.
+  const int16_t half = 1;
+  AEDesc truncated;
+  AECreateDesc(typeSInt32, &half, sizeof(half), &truncated);
+  AEJS_CHECK(CoerceTo(truncated, typeIEEE64BitFloatingPoint, &doub) ==
+             errAECorruptData);
+  AEDisposeDesc(&truncated);
+}
+
+void TestTextAndBooleanCoercions() {
+  AEDesc number = MakeText(" -17 ");
+  int32_t integer = 0;
+  AEJS_CHECK(CoerceTo(number, typeSInt32, &integer) == noErr &&
+             integer == -17);
+  AEDisposeDesc(&number);
+  AEDesc fraction = MakeText("0.5");
+  double doub = 0;
+  AEJS_CHECK(CoerceTo(fraction, typeIEEE64BitFloatingPoint, &doub) == noErr &&
+             doub == 0.5);
+  AEDisposeDesc(&fraction);
+  AEDesc notANumber = MakeText("12 apples");
+  AEJS_CHECK(CoerceTo(notANumber, typeSInt32, &integer) == errAECoercionFail);
+  AEDisposeDesc(&notANumber);
+
+  // Text survives a trip through UTF-16, astral plane and all.
+  const std::string accented = "caf\xC3\xA9 \xF0\x9F\x8D\xB5";
+  AEDesc utf8 = MakeText(accented.c_str());
+  std::string text;
+  AEJS_CHECK(CoerceToText(utf8, typeUnicodeText, &text) == noErr &&
+             text == accented);
+  AEDisposeDesc(&utf8);
+
+  AEDesc yes = MakeText("  TRUE ");
+  uint8_t boolean = 0;
+  AEJS_CHECK(CoerceTo(yes, typeBoolean, &boolean) == noErr && boolean == 1);
+  AEDesc affirmed;
+  AEJS_CHECK(AECoerceDesc(&yes, typeTrue, &affirmed) == noErr &&
+             affirmed.descriptorType == typeTrue &&
+             AEGetDescDataSize(&affirmed) == 0);
+  AEDisposeDesc(&affirmed);
+  // 'fals' only holds false, so true can't become one.
+  AEJS_CHECK(AECoerceDesc(&yes, typeFalse, &affirmed) == errAECoercionFail);
+  AEDisposeDesc(&yes);
+  AEDesc maybe = MakeText("maybe");
+  AEJS_CHECK(CoerceTo(maybe, typeBoolean, &boolean) == errAECoercionFail);
+  AEDisposeDesc(&maybe);
+
+  AEDesc no;
+  AECreateDesc(typeFalse, nullptr, 0, &no);
+  AEJS_CHECK(CoerceToText(no, typeChar, &text) == noErr && text == "false");
+  int16_t shor = -1;
+  AEJS_CHECK(CoerceTo(no, typeSInt16, &shor) == noErr && shor == 0);
+  AEDisposeDesc(&no);
+
+  // Only 0 and 1 are booleans.
+  AEDesc one = MakeInt(1);
+  AEJS_CHECK(CoerceTo(one, typeBoolean, &boolean) == noErr && boolean == 1);
+  AEDisposeDesc(&one);
+  AEDesc two = MakeInt(2);
+  AEJS_CHECK(CoerceTo(two, typeBoolean, &boolean) == errAECoercionFail);
+  AEDisposeDesc(&two);
+
+  // Four-character codes only retype among themselves.
+  const DescType code = Engine::MakeCode("pnam");
+  AEDesc type;
+  AECreateDesc(typeType, &code, sizeof(code), &type);
+  DescType retyped = 0;
+  AEJS_CHECK(CoerceTo(type, typeEnumerated, &retyped) == noErr &&
+             retyped == code);
+  AEJS_CHECK(CoerceToText(type, typeUTF8Text, &text) == errAECoercionFail);
+  AEDisposeDesc(&type);
+}
+
+void TestStructuralCoercions() {
+  // Coercing to a descriptor's own type, or to the wild card, shares it.
+  AEDesc text = MakeText("shared");
+  for (const DescType toType : {typeUTF8Text, typeWildCard}) {
+    AEDesc same;
+    AEJS_CHECK(AECoerceDesc(&text, toType, &same) == noErr &&
+               same.descriptorType == typeUTF8Text &&
+               same.dataHandle == text.dataHandle);
+    AEDisposeDesc(&same);
+  }
+
+  // Anything that isn't a list is wrapped in one.
+  AEDesc wrapped;
+  AEJS_CHECK(AECoerceDesc(&text, typeAEList, &wrapped) == noErr &&
+             wrapped.descriptorType == typeAEList);
+  long count = 0;
+  AEJS_CHECK(AECountItems(&wrapped, &count) == noErr && count == 1);
+  AEDisposeDesc(&text);
+
+  // A single-item list coerces as its item does, and a longer one doesn't.
+  std::string unwrapped;
+  AEJS_CHECK(CoerceToText(wrapped, typeUnicodeText, &unwrapped) == noErr &&
+             unwrapped == "shared");
+  AEDesc item = MakeInt(7);
+  AEPutDesc(&wrapped, 0, &item);
+  AEDisposeDesc(&item);
+  AEJS_CHECK(CoerceToText(wrapped, typeUTF8Text, &unwrapped) ==
+             errAECoercionFail);
+  AEDisposeDesc(&wrapped);
+
+  // Records take on other types with their fields, but can't become events.
+  AEDesc nested = MakeNested();
+  AEDesc specifier;
+  AEJS_CHECK(AECoerceDesc(&nested, typeObjectSpecifier, &specifier) == noErr &&
+             specifier.descriptorType == typeObjectSpecifier);
+  AEJS_CHECK(AECountItems(&specifier, &count) == noErr && count == 2);
+  AEJS_CHECK(nested.descriptorType == typeAERecord);
+  AEDisposeDesc(&specifier);
+  AEDesc event;
+  AEJS_CHECK(AECoerceDesc(&nested, typeAppleEvent, &event) ==
+             errAECoercionFail);
+  AEJS_CHECK(event.descriptorType == typeNull);
+  AEDisposeDesc(&nested);
+
+  // Null descriptors have nothing to coerce.
+  AEDesc null;
+  AEInitializeDesc(&null);
+  int32_t integer = 0;
+  AEJS_CHECK(CoerceTo(null, typeSInt32, &integer) == errAECoercionFail);
+}
+} // namespace
+
+int main() {
+  return ae_js_bridge::Testing::RunTests({
+      {"scalars round-trip", TestScalarsRoundTrip},
+      {"nested lists and records round-trip", TestNestedRoundTrip},
+      {"events round-trip", TestEventRoundTrip},
+      {"flattened layout", TestFlattenedLayout},
+      {"sharing clones only on write", TestSharingClonesOnlyOnWrite},
+      {"putting into itself", TestPuttingIntoItself},
+      {"short input is rejected", TestShortInputIsRejected},
+      {"damaged input is contained", TestDamagedInputIsContained},
+      {"numeric coercions", TestNumericCoercions},
+      {"text and boolean coercions", TestTextAndBooleanCoercions},
+      {"structural coercions", TestStructuralCoercions},
+  });
+}
@@ -0,0 +1,254 @@
+// Checks `InFlightTable` on its own, and with threads inserting, taking,
+//  removing and sweeping the same slots at once: every request parked must be
+//  handed out exactly once, to whichever of them got there first. Run as
+//  `build/Release/ae_js_in_flight_table_test`.
+
+#include "InFlightTable.h"
+#include "TestSupport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using ae_js_bridge::InFlightTable;
+using Clock = InFlightTable::Clock;
+
+namespace {
+constexpr auto kNever = Clock::time_point::max();
+
+// A parked request: which return ID it was parked on, and how many times it
+//  has been handed out.
+struct Request {
+  int16_t returnID = 0;
+  std::atomic<uint32_t> deliveries{0};
+};
+
+void Deliver(void *cookie) {
+  static_cast<Request *>(cookie)->deliveries.fetch_add(1);
+}
+
+void TestInsertTakeRemove() {
+  auto table = std::make_unique<InFlightTable>();
+  int first = 0;
+  int second = 0;
+
+  AEJS_CHECK(!table->Insert(1, nullptr, kNever));
+  AEJS_CHECK(table->Insert(1, &first, kNever));
+  AEJS_CHECK(!table->Insert(1, &second, kNever));
+  // Return IDs are signed, and -1 is a slot of its own.
+  AEJS_CHECK(table->Insert(-1, &second, kNever));
+  AEJS_CHECK(table->Size() == 2);
+
+  AEJS_CHECK(table->Take(2) == nullptr);
+  AEJS_CHECK(table->Take(1) == &first);
+  AEJS_CHECK(table->Take(1) == nullptr);
+  AEJS_CHECK(table->Size() == 1);
+
+  AEJS_CHECK(!table->Remove(-1, &first));
+  AEJS_CHECK(table->Size() == 1);
+  AEJS_CHECK(table->Remove(-1, &second));
+  AEJS_CHECK(!table->Remove(-1, &second));
+  AEJS_CHECK(table->Size() == 0);
+
+  // A slot can be reused once it has been emptied.
+  AEJS_CHECK(table->Insert(1, &second, kNever));
+  AEJS_CHECK(table->Take(1) == &second);
+}
+
+void TestDeadlines() {
+  auto table = std::make_unique<InFlightTable>();
+  const Clock::time_point start = Clock::now();
+  Request past;
+  Request later;
+  Request never;
+  AEJS_CHECK(table->Insert(10, &past, start - std::chrono::seconds(1)));
+  AEJS_CHECK(table->Insert(12, &later, start + std::chrono::seconds(60)));
+  AEJS_CHECK(table->Insert(13, &never, kNever));
+
+  std::vector<int16_t> expired;
+  auto collect = [&](int16_t returnID, void *cookie) {
+    expired.push_back(returnID);
+    Deliver(cookie);
+  };
+  AEJS_CHECK(table->Sweep(start, collect) == 1);
+  AEJS_CHECK(expired == std::vector<int16_t>{10});
+  AEJS_CHECK(past.deliveries.load() == 1);
+
+  // Deadlines a tenth of a millisecond apart, so that some sweep falls in the
+  //  same millisecond as a deadline just after it: none may expire early.
+  constexpr int kSpread = 10;
+  std::vector<Clock::time_point> deadlines;
+  std::vector<Request> spread(kSpread);
+  for (int index = 0; index < kSpread; ++index) {
+    deadlines.push_back(start + std::chrono::milliseconds(20) +
+                        std::chrono::microseconds(100 * index));
+    spread[index].returnID = static_cast<int16_t>(20 + index);
+    AEJS_CHECK(table->Insert(spread[index].returnID, &spread[index],
+                             deadlines.back()));
+  }
+  size_t spreadExpired = 0;
+  for (int index = 0; index < kSpread; ++index) {
+    const Clock::time_point now =
+        deadlines[index] - std::chrono::microseconds(50);
+    spreadExpired += table->Sweep(now, [&](int16_t returnID, void *cookie) {
+      AEJS_CHECK(deadlines[returnID - 20] <= now);
+      Deliver(cookie);
+    });
+  }
+  spreadExpired += table->Sweep(start + std::chrono::milliseconds(25),
+                                [](int16_t, void *cookie) { Deliver(cookie); });
+  AEJS_CHECK(spreadExpired == kSpread);
+  for (const Request &request : spread) {
+    AEJS_CHECK(request.deliveries.load() == 1);
+    // A slot that expired can't be taken as well.
+    AEJS_CHECK(table->Take(request.returnID) == nullptr);
+  }
+
+  expired.clear();
+  AEJS_CHECK(table->Sweep(kNever, collect) == 1);
+  AEJS_CHECK(expired == std::vector<int16_t>{12});
+  AEJS_CHECK(table->Take(13) == &never);
+  AEJS_CHECK(table->Size() == 0);
+  AEJS_CHECK(table->Sweep(kNever, collect) == 0);
+}
+
+// Deadlines far enough off that only a deliberately late sweep expires them.
+void TestSweepSkipsUnexpired() {
+  auto table = std::make_unique<InFlightTable>();
+  const Clock::time_point start = Clock::now();
+  std::vector<Request> requests(64);
+  for (size_t index = 0; index < requests.size(); ++index) {
+    requests[index].returnID = static_cast<int16_t>(index * 1000);
+    AEJS_CHECK(table->Insert(requests[index].returnID, &requests[index],
+                             start + std::chrono::seconds(index + 1)));
+  }
+  size_t expired = 0;
+  auto count = [&](int16_t returnID, void *cookie) {
+    AEJS_CHECK(static_cast<Request *>(cookie)->returnID == returnID);
+    Deliver(cookie);
+    ++expired;
+  };
+  AEJS_CHECK(table->Sweep(start + std::chrono::milliseconds(32500), count) ==
+             32);
+  AEJS_CHECK(expired == 32);
+  for (size_t index = 0; index < requests.size(); ++index) {
+    AEJS_CHECK(requests[index].deliveries.load() == (index < 32 ? 1u : 0u));
+  }
+  AEJS_CHECK(table->Size() == 32);
+}
+
+// Inserting threads each own a range of return IDs and keep re-parking new
+//  requests on them, some already expired, and sometimes give one up with
+//  `Remove`. Taking threads and a sweeping thread race them for every slot.
+void TestConcurrentRaces() {
+  constexpr unsigned kInserters = 4;
+  constexpr unsigned kTakers = 3;
+  constexpr size_t kIDsPerInserter = 512;
+  constexpr size_t kRounds = 40;
+  auto table = std::make_unique<InFlightTable>();
+
+  std::vector<std::unique_ptr<Request>> requests(
+      kInserters * kIDsPerInserter * kRounds);
+  for (std::unique_ptr<Request> &request : requests) {
+    request = std::make_unique<Request>();
+  }
+
+  std::atomic<bool> inserting{true};
+  std::atomic<uint64_t> staleRemoves{0};
+  std::atomic<uint64_t> wrongSweepIDs{0};
+
+  std::vector<std::thread> threads;
+  for (unsigned inserter = 0; inserter < kInserters; ++inserter) {
+    threads.emplace_back([&, inserter] {
+      const Clock::time_point start = Clock::now();
+      for (size_t round = 0; round < kRounds; ++round) {
+        for (size_t offset = 0; offset < kIDsPerInserter; ++offset) {
+          const size_t id = inserter * kIDsPerInserter + offset;
+          const int16_t returnID = static_cast<int16_t>(id * 31);
+          Request &request =
+              *requests[(round * kInserters * kIDsPerInserter) + id];
+          request.returnID = returnID;
+          const Clock::time_point deadline =
+              (round + offset) % 3 == 0 ? start : kNever;
+          // The previous request on this ID is still parked until a taker or
+          //  the sweeper gets to it.
+          while (!table->Insert(returnID, &request, deadline)) {
+            std::this_thread::yield();
+          }
+          if (round > 0) {
+            Request &previous =
+                *requests[((round - 1) * kInserters * kIDsPerInserter) + id];
+            // Whatever was parked before has been handed out, so removing it
+            //  must not touch the request parked now.
+            if (table->Remove(returnID, &previous)) {
+              staleRemoves.fetch_add(1);
+              Deliver(&previous);
+            }
+          }
+          if (offset % 5 == 0 && table->Remove(returnID, &request)) {
+            Deliver(&request);
+          }
+        }
+      }
+    });
+  }
+  for (unsigned taker = 0; taker < kTakers; ++taker) {
+    threads.emplace_back([&, taker] {
+      while (inserting.load()) {
+        for (size_t id = taker; id < kInserters * kIDsPerInserter;
+             id += kTakers) {
+          if (void *cookie = table->Take(static_cast<int16_t>(id * 31))) {
+            Deliver(cookie);
+          }
+        }
+      }
+    });
+  }
+  threads.emplace_back([&] {
+    while (inserting.load()) {
+      table->Sweep(Clock::now(), [&](int16_t returnID, void *cookie) {
+        if (static_cast<Request *>(cookie)->returnID != returnID) {
+          wrongSweepIDs.fetch_add(1);
+        }
+        Deliver(cookie);
+      });
+    }
+  });
+
+  for (unsigned inserter = 0; inserter < kInserters; ++inserter) {
+    threads[inserter].join();
+  }
+  inserting.store(false);
+  for (size_t index = kInserters; index < threads.size(); ++index) {
+    threads[index].join();
+  }
+
+  // Hand out whatever the last round left parked.
+  for (size_t id = 0; id < kInserters * kIDsPerInserter; ++id) {
+    if (void *cookie = table->Take(static_cast<int16_t>(id * 31))) {
+      Deliver(cookie);
+    }
+  }
+
+  AEJS_CHECK(table->Size() == 0);
+  AEJS_CHECK(staleRemoves.load() == 0);
+  AEJS_CHECK(wrongSweepIDs.load() == 0);
+  size_t deliveredOnce = 0;
+  for (const std::unique_ptr<Request> &request : requests) {
+    deliveredOnce += request->deliveries.load() == 1;
+  }
+  AEJS_CHECK(deliveredOnce == requests.size());
+}
+} // namespace
+
+int main() {
+  return ae_js_bridge::Testing::RunTests({
+      {"insert, take and remove", TestInsertTakeRemove},
+      {"deadlines", TestDeadlines},
+      {"sweep skips unexpired", TestSweepSkipsUnexpired},
+      {"concurrent races", TestConcurrentRaces},
+  });
+}
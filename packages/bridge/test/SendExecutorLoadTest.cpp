@@ -0,0 +1,320 @@
+// Puts `SendExecutor` under load, with the portable engine's `AESendMessage`
+//  standing in for the round trip to a target (see `AEPortableSimulateSends`).
+//  Checks the per-target cap, work stealing, turning jobs away when the queue
+//  or one target's share of it is full, and the gauges `GetStats` reports. Run as
+//  `build/Release/ae_js_send_executor_load_test`.
+
+#include "AEPortable.h"
+#include "SendExecutor.h"
+#include "TestSupport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Engine = ae_js_bridge::DescriptorEngine;
+using ae_js_bridge::SendExecutor;
+
+namespace {
+constexpr AEEventClass kTestClass = Engine::MakeCode("test");
+constexpr AEEventID kTestID = Engine::MakeCode("load");
+constexpr std::chrono::microseconds kSendLatency{500};
+
+// Sends one event the way the bridge's send jobs do, and checks the reply is
+//  the one for that event.
+void SendOne() {
+  AEAddressDesc target;
+  AEInitializeDesc(&target);
+  AppleEvent event;
+  if (!AEJS_CHECK(AECreateAppleEvent(kTestClass, kTestID, &target,
+                                     kAutoGenerateReturnID, kAnyTransactionID,
+                                     &event) == noErr)) {
+    return;
+  }
+  AppleEvent reply;
+  AEJS_CHECK(AESendMessage(&event, &reply, kAEWaitReply | kAENeverInteract,
+                           kAEDefaultTimeout) == noErr);
+
+  AEReturnID sent = 0;
+  AEReturnID answered = -1;
+  AEGetAttributePtr(&event, keyReturnIDAttr, typeSInt16, nullptr, &sent,
+                    sizeof(sent), nullptr);
+  AEGetAttributePtr(&reply, keyReturnIDAttr, typeSInt16, nullptr, &answered,
+                    sizeof(answered), nullptr);
+  AEJS_CHECK(answered == sent);
+  AEDisposeDesc(&reply);
+  AEDisposeDesc(&event);
+}
+
+// How many jobs for one target are running right now, and the most there
+//  have ever been at once.
+struct Concurrency {
+  std::atomic<unsigned> running{0};
+  std::atomic<unsigned> peak{0};
+
+  void Enter() {
+    const unsigned now = running.fetch_add(1) + 1;
+    unsigned seen = peak.load();
+    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+    }
+  }
+  void Leave() { running.fetch_sub(1); }
+};
+
+// Polls until `done` holds, for at most ten seconds.
+template <typename Predicate> bool WaitFor(Predicate done) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!done()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+// A job counts as completed a moment before it stops counting as in flight,
+//  so this waits for both.
+bool WaitForCompleted(const SendExecutor &executor, uint64_t count) {
+  return WaitFor([&] {
+    const SendExecutor::Stats stats = executor.GetStats();
+    return stats.completed >= count && stats.inFlight == 0;
+  });
+}
+
+// Checks the gauges of an executor that has nothing left to do.
+void CheckIdleStats(const SendExecutor &executor, uint64_t completed) {
+  const SendExecutor::Stats stats = executor.GetStats();
+  AEJS_CHECK(stats.queueDepth == 0);
+  AEJS_CHECK(stats.inFlight == 0);
+  AEJS_CHECK(stats.submitted == completed);
+  AEJS_CHECK(stats.completed == completed);
+  AEJS_CHECK(stats.threads.size() == executor.GetOptions().threads);
+
+  uint64_t threadCompleted = 0;
+  for (const SendExecutor::ThreadStats &thread : stats.threads) {
+    threadCompleted += thread.completed;
+    AEJS_CHECK(thread.utilization >= 0 && thread.utilization <= 1);
+    AEJS_CHECK(thread.completed == 0 || thread.busy.count() > 0);
+  }
+  AEJS_CHECK(threadCompleted == completed);
+}
+
+void TestPerTargetCap() {
+  SendExecutor::Options options;
+  options.threads = 8;
+  options.maxPerTarget = 2;
+  // Outlives the executor, whose threads are the last to touch it.
+  Concurrency concurrency;
+  SendExecutor executor(options);
+
+  constexpr unsigned kJobs = 200;
+  for (unsigned index = 0; index < kJobs; ++index) {
+    AEJS_CHECK(executor.Submit(1, [&] {
+      concurrency.Enter();
+      SendOne();
+      concurrency.Leave();
+    }));
+  }
+  AEJS_CHECK(WaitForCompleted(executor, kJobs));
+  // Six threads stay idle however long the target's queue is.
+  AEJS_CHECK(concurrency.peak.load() == options.maxPerTarget);
+  CheckIdleStats(executor, kJobs);
+}
+
+void TestWorkStealing() {
+  SendExecutor::Options options;
+  options.threads = 4;
+  options.maxPerTarget = 4;
+  Concurrency concurrency;
+  SendExecutor executor(options);
+
+  // Every job for one target is queued on the same thread, so any other
+  //  thread that runs one has stolen it.
+  constexpr unsigned kJobs = 200;
+  for (unsigned index = 0; index < kJobs; ++index) {
+    AEJS_CHECK(executor.Submit(7, [&] {
+      concurrency.Enter();
+      SendOne();
+      concurrency.Leave();
+    }));
+  }
+  AEJS_CHECK(WaitForCompleted(executor, kJobs));
+  AEJS_CHECK(concurrency.peak.load() > 1);
+
+  const SendExecutor::Stats stats = executor.GetStats();
+  AEJS_CHECK(stats.stolen > 0);
+  const auto busyThreads = std::count_if(
+      stats.threads.begin(), stats.threads.end(),
+      [](const SendExecutor::ThreadStats &thread) {
+        return thread.completed > 0;
+      });
+  AEJS_CHECK(busyThreads > 1);
+  // Stolen jobs are the ones the home thread didn't run.
+  uint64_t mostByOneThread = 0;
+  for (const SendExecutor::ThreadStats &thread : stats.threads) {
+    mostByOneThread = std::max(mostByOneThread, thread.completed);
+  }
+  AEJS_CHECK(stats.stolen >= kJobs - mostByOneThread);
+  CheckIdleStats(executor, kJobs);
+}
+
+void TestQueueFull() {
+  SendExecutor::Options options;
+  options.threads = 1;
+  options.queueCapacity = 4;
+  // Lets one target fill the whole queue, to check the queue's own limit.
+  options.maxQueuedPerTarget = options.queueCapacity;
+  SendExecutor executor(options);
+
+  // Holds the only thread, so everything after it stays queued.
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  AEJS_CHECK(executor.Submit(1, [released] { released.wait(); }));
+  AEJS_CHECK(WaitFor([&] { return executor.GetStats().inFlight == 1; }));
+
+  for (size_t index = 0; index < options.queueCapacity; ++index) {
+    AEJS_CHECK(executor.Submit(2, SendOne));
+  }
+  AEJS_CHECK(!executor.Submit(2, SendOne));
+  AEJS_CHECK(!executor.Submit(3, SendOne));
+
+  SendExecutor::Stats stats = executor.GetStats();
+  AEJS_CHECK(stats.queueDepth == options.queueCapacity);
+  AEJS_CHECK(stats.inFlight == 1);
+  AEJS_CHECK(stats.rejected == 2);
+  AEJS_CHECK(stats.rejectedForTarget == 1);
+  AEJS_CHECK(stats.submitted == options.queueCapacity + 1);
+
+  release.set_value();
+  AEJS_CHECK(WaitForCompleted(executor, options.queueCapacity + 1));
+  CheckIdleStats(executor, options.queueCapacity + 1);
+  // Room again once the queue has drained.
+  AEJS_CHECK(executor.Submit(2, SendOne));
+  AEJS_CHECK(WaitForCompleted(executor, options.queueCapacity + 2));
+  AEJS_CHECK(executor.GetStats().rejected == 2);
+}
+
+// A target that stops answering can only queue up its own share, and holds
+//  up nothing queued for other targets, even on the same thread.
+void TestStuckTarget() {
+  SendExecutor::Options options;
+  options.threads = 2;
+  options.maxPerTarget = 1;
+  options.queueCapacity = 16;
+  options.maxQueuedPerTarget = 4;
+  Concurrency stuck;
+  SendExecutor executor(options);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  auto hang = [&stuck, released] {
+    stuck.Enter();
+    released.wait();
+    stuck.Leave();
+  };
+  AEJS_CHECK(executor.Submit(1, hang));
+  AEJS_CHECK(WaitFor([&] { return executor.GetStats().inFlight == 1; }));
+  for (size_t index = 0; index < options.maxQueuedPerTarget; ++index) {
+    AEJS_CHECK(executor.Submit(1, hang));
+  }
+  AEJS_CHECK(!executor.Submit(1, hang));
+  SendExecutor::Stats stats = executor.GetStats();
+  AEJS_CHECK(stats.rejected == 1 && stats.rejectedForTarget == 1);
+  AEJS_CHECK(stats.queueDepth == options.maxQueuedPerTarget);
+
+  // Everyone else still has room, and a thread to run on.
+  constexpr unsigned kOthers = 64;
+  uint64_t accepted = 0;
+  for (unsigned index = 0; index < kOthers; ++index) {
+    accepted += executor.Submit(2 + index % 8, SendOne);
+  }
+  AEJS_CHECK(accepted >= options.queueCapacity - options.maxQueuedPerTarget);
+  AEJS_CHECK(WaitFor([&] {
+    stats = executor.GetStats();
+    return stats.completed == accepted &&
+           stats.queueDepth == options.maxQueuedPerTarget;
+  }));
+  AEJS_CHECK(stats.inFlight == 1);
+  AEJS_CHECK(stuck.peak.load() == 1);
+
+  release.set_value();
+  const uint64_t total = accepted + 1 + options.maxQueuedPerTarget;
+  AEJS_CHECK(WaitForCompleted(executor, total));
+  CheckIdleStats(executor, total);
+  AEJS_CHECK(stuck.peak.load() == 1);
+}
+
+// Many targets at once, as a busy script sends to several apps. Checks the
+//  cap holds for each target and the gauges stay in bounds while the load is
+//  on, and reports the throughput.
+void TestManyTargets() {
+  SendExecutor::Options options;
+  options.threads = 8;
+  options.maxPerTarget = 2;
+  constexpr unsigned kTargets = 32;
+  constexpr unsigned kJobsPerTarget = 50;
+  constexpr uint64_t kJobs = kTargets * kJobsPerTarget;
+  std::vector<std::unique_ptr<Concurrency>> targets;
+  for (unsigned target = 0; target < kTargets; ++target) {
+    targets.push_back(std::make_unique<Concurrency>());
+  }
+  SendExecutor executor(options);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned index = 0; index < kJobsPerTarget; ++index) {
+    for (unsigned target = 0; target < kTargets; ++target) {
+      Concurrency &concurrency = *targets[target];
+      AEJS_CHECK(executor.Submit(target, [&concurrency] {
+        concurrency.Enter();
+        SendOne();
+        concurrency.Leave();
+      }));
+    }
+  }
+  AEJS_CHECK(WaitFor([&] {
+    const SendExecutor::Stats stats = executor.GetStats();
+    AEJS_CHECK(stats.inFlight <= options.threads);
+    AEJS_CHECK(stats.queueDepth <= kJobs);
+    return stats.completed >= kJobs && stats.inFlight == 0;
+  }));
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  for (const std::unique_ptr<Concurrency> &concurrency : targets) {
+    AEJS_CHECK(concurrency->peak.load() <= options.maxPerTarget);
+  }
+  CheckIdleStats(executor, kJobs);
+
+  const SendExecutor::Stats stats = executor.GetStats();
+  double utilization = 0;
+  for (const SendExecutor::ThreadStats &thread : stats.threads) {
+    utilization += thread.utilization;
+  }
+  std::printf("     %llu sends of %lld us in %.3f s (%.0f/s), %llu stolen, "
+              "%.0f%% mean utilization\n",
+              static_cast<unsigned long long>(kJobs),
+              static_cast<long long>(kSendLatency.count()), elapsed.count(),
+              kJobs / elapsed.count(),
+              static_cast<unsigned long long>(stats.stolen),
+              100 * utilization / stats.threads.size());
+}
+} // namespace
+
+int main() {
+  AEPortableSimulateSends(kSendLatency, noErr);
+  return ae_js_bridge::Testing::RunTests({
+      {"per-target cap", TestPerTargetCap},
+      {"work stealing", TestWorkStealing},
+      {"queue full", TestQueueFull},
+      {"stuck target", TestStuckTarget},
+      {"many targets", TestManyTargets},
+  });
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// Just enough of a harness for the targets that test the parts of the bridge
+//  that build without Node: checks that report where they failed and keep
+//  going, and a `main` that runs each test and exits non-zero if any check
+//  failed.
+
+#include <cstdio>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ae_js_bridge {
+namespace Testing {
+inline int &FailureCount() {
+  static int failures = 0;
+  return failures;
+}
+
+inline bool Check(bool passed, const char *expression, const char *file,
+                  int line) {
+  if (!passed) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    ++FailureCount();
+  }
+  return passed;
+}
+
+struct Test {
+  const char *name;
+  std::function<void()> run;
+};
+
+inline int RunTests(const std::vector<Test> &tests) {
+  for (const Test &test : tests) {
+    const int failuresBefore = FailureCount();
+    test.run();
+    std::printf("%s %s\n", FailureCount() == failuresBefore ? "ok  " : "FAIL",
+                test.name);
+  }
+  if (FailureCount() != 0) {
+    std::printf("%d check(s) failed\n", FailureCount());
+    return 1;
+  }
+  return 0;
+}
+} // namespace Testing
+} // namespace ae_js_bridge
+
+#define AEJS_CHECK(expression)                                                 \
+  ::ae_js_bridge::Testing::Check(static_cast<bool>(expression), #expression,   \
+                                 __FILE__, __LINE__)
@@ -1,8 +1,10 @@
 declare module '#ae_js_bridge_native' {
     /**
-     * A 4-character code.
+     * A 4-character code. Native APIs accept either form: a string of four
+     *  latin1 characters, or the code as a uint32. They return strings unless
+     *  `setFourCharCodeMode('number')` has been called.
      */
-    type FourCharCode = string;
+    type FourCharCode = string | number;
 
     /**
      * A descriptor type.
@@ -24,6 +26,38 @@ declare module '#ae_js_bridge_native' {
      */
     type AEEventID = FourCharCode;
 
+    /**
+     * Options for converting a descriptor tree to plain JavaScript values.
+     */
+    export interface ToJSValueOptions {
+        /**
+         * How the bytes of data descriptors are emitted. Defaults to
+         *  `'base64'`.
+         */
+        dataEncoding?: 'base64' | 'buffer';
+        /**
+         * Descriptors nested deeper than this are returned as descriptors
+         *  instead of being converted. The root is at depth 0. Defaults to
+         *  `Infinity`.
+         */
+        maxDepth?: number;
+        /**
+         * Whether text, numeric and boolean data descriptors are converted to
+         *  JavaScript primitives. Defaults to `false`.
+         */
+        decodeScalars?: boolean;
+    }
+
+    /**
+     * Hints for building a descriptor tree from JavaScript values.
+     */
+    export interface FromJSValueHints {
+        /**
+         * The type to set on the root descriptor, if it is a list or a record.
+         *  If not provided, the type is inferred from the value.
+         */
+        descriptorType?: DescType;
+    }
 
     /**
      * Base class for all Apple event descriptors.
@@ -37,10 +71,115 @@ declare module '#ae_js_bridge_native' {
 
         /**
          * Casts the descriptor to the given type.
+         * Casting to the descriptor's own type is O(1): descriptors never
+         *  change, so the result shares this descriptor instead of copying it.
+         *  Each wrapper remembers its last few successful casts, so repeating
+         *  one is answered without coercing again; failed casts are retried.
          * @param descriptorType - The type of the descriptor to cast to.
          * @returns The descriptor cast to the given type.
          */
         public as<T extends AEDescriptor>(descriptorType: DescType): T;
+
+        /**
+         * Converts the whole descriptor tree to plain JavaScript values in a
+         *  single native pass.
+         * @param options - The conversion options.
+         * @returns The converted value.
+         */
+        public toJSValue(options?: ToJSValueOptions): unknown;
+
+        /**
+         * Reads the descriptor as UTF-8 text, coercing it to 'utf8' first if
+         *  it has a different type.
+         * @returns The text of the descriptor.
+         */
+        public asUtf8String(): string;
+
+        /**
+         * Reads the descriptor as an IEEE 64-bit float, coercing it to 'doub'
+         *  first if it has a different type.
+         * @returns The number value of the descriptor.
+         */
+        public asFloat64(): number;
+
+        /**
+         * Reads the descriptor as a signed 32-bit integer, coercing it to
+         *  'long' first if it has a different type.
+         * @returns The integer value of the descriptor.
+         */
+        public asInt32(): number;
+
+        /**
+         * Reads the descriptor as a signed 64-bit integer, coercing it to
+         *  'comp' first if it has a different type.
+         * @returns The integer value of the descriptor.
+         */
+        public asInt64(): bigint;
+
+        /**
+         * Reads the descriptor as a boolean, coercing it to 'bool' first if it
+         *  has a different type.
+         * @returns The boolean value of the descriptor.
+         */
+        public asBool(): boolean;
+
+        /**
+         * Flattens the whole descriptor tree into bytes, for storing or sending
+         *  elsewhere, in the same form as `AEFlattenDesc` on every platform.
+         *  Use `AEDescriptor.deserialize` to get it back.
+         * @returns The flattened descriptor.
+         */
+        public serialize(): Buffer;
+
+        /**
+         * Computes a 64-bit hash of the whole descriptor tree. Descriptors
+         *  that are `equals` to each other hash the same.
+         * @returns The hash of the descriptor.
+         */
+        public hash(): bigint;
+
+        /**
+         * Compares two descriptor trees structurally: same types, same data,
+         *  and the same children in the same order.
+         * @param other - The descriptor to compare with.
+         * @returns Whether the descriptors are equal.
+         */
+        public equals(other: AEDescriptor): boolean;
+
+        /**
+         * Builds a descriptor tree from nested JavaScript values in a single
+         *  native pass. Accepts the same values as `AEJSDescriptor.fromValue`.
+         * @param value - The value to build the descriptor from.
+         * @param hints - The build hints.
+         * @returns The built descriptor.
+         */
+        public static fromJSValue<T extends AEDescriptor>(
+            value: unknown,
+            hints?: FromJSValueHints
+        ): T;
+
+        /**
+         * Casts each descriptor to the given type in a single native call,
+         *  through the same per-wrapper memo as `as()`.
+         * @param descriptors - The descriptors to cast.
+         * @param descriptorType - The type to cast them to.
+         * @returns The cast descriptors, with null for each that couldn't be
+         *  cast, and each one's OSErr code (0 on success).
+         */
+        public static coerceAll<T extends AEDescriptor>(
+            descriptors: AEDescriptor[],
+            descriptorType: DescType
+        ): { results: (T | null)[]; errors: Int32Array };
+
+        /**
+         * Recreates a descriptor from the bytes returned by `serialize` or
+         *  `AEFlattenDesc`. Input that is shorter or longer than its header
+         *  says, or whose contents run past it, throws before any of it is
+         *  unflattened.
+         * @param bytes - The flattened descriptor.
+         * @returns The descriptor, wrapped in the class for its kind.
+         */
+        public static deserialize<T extends AEDescriptor>(bytes: Uint8Array): T;
     }
 
     /**
@@ -68,6 +207,25 @@ declare module '#ae_js_bridge_native' {
          * The data of the descriptor.
          */
         public readonly data: Uint8Array;
+
+        /**
+         * Gets a view of the data of the descriptor. The data is copied out
+         *  once per descriptor, on the first call, and the same buffer backs
+         *  every view after that, so inspecting a large payload repeatedly
+         *  costs one copy. The view is read-only by contract: writing through
+         *  it changes what every other view of the descriptor sees (but never
+         *  the descriptor itself). Use `data` for a copy of your own.
+         * @returns A view of the data of the descriptor.
+         */
+        public dataView(): DataView;
+
+        /**
+         * Reads part of the data of the descriptor, without reading the rest.
+         * @param offset - The byte offset to start reading at.
+         * @param length - The number of bytes to read.
+         * @returns A copy of the requested bytes.
+         */
+        public dataRange(offset: number, length: number): Uint8Array;
     }
 
     /**
@@ -85,6 +243,120 @@ declare module '#ae_js_bridge_native' {
          * The items of the descriptor.
          */
         public readonly items: AEDescriptor[];
+
+        /**
+         * The number of items in the descriptor.
+         */
+        public readonly count: number;
+
+        /**
+         * Gets a single item of the descriptor without reading the others.
+         * @param index - The zero-based index of the item.
+         * @returns The item, or undefined if the index is out of range.
+         */
+        public itemAt(index: number): AEDescriptor | undefined;
+
+        /**
+         * Iterates over the items of the descriptor, reading each one
+         *  only when it is reached.
+         */
+        public [Symbol.iterator](): IterableIterator<AEDescriptor>;
+
+        /**
+         * Iterates over the items of the descriptor in batches, copying and
+         *  classifying them on a worker thread so that huge lists don't stall
+         *  the event loop. With `options.values`, items are decoded there too,
+         *  leaving only their JS values to be built on the event loop.
+         * @param options - How to batch the items.
+         * @returns An async iterator of wrapper arrays, or of `toJSValue()`
+         *  results when `options.values` is set.
+         */
+        public iterate(
+            options?: ListBatchOptions & { values?: false }
+        ): AsyncIterableIterator<AEDescriptor[]>;
+        public iterate(
+            options: ListBatchOptions & { values: true | ToJSValueOptions }
+        ): AsyncIterableIterator<unknown[]>;
+
+        /**
+         * Reads every item as a number in one call. Items of type 'shor',
+         *  'long', 'sing' or 'doub' are read as they are; others are coerced
+         *  to 'doub', and an item that can't be throws.
+         * @returns The items as 64-bit floats.
+         */
+        public toFloat64Array(): Float64Array;
+
+        /**
+         * Reads every item as a 32-bit integer in one call. Items of type
+         *  'shor' or 'long' are read as they are; others are coerced to
+         *  'long', and an item that can't be throws.
+         * @returns The items as 32-bit integers.
+         */
+        public toInt32Array(): Int32Array;
+
+        /**
+         * Reads every item as a string in one call. 'utxt' and 'utf8' items
+         *  are read as they are; others (such as 'TEXT') are coerced to
+         *  'utf8', and an item that can't be throws.
+         * @returns The items as strings.
+         */
+        public toStringArray(): string[];
+
+        /**
+         * Builds a list of numbers in one call. The array's values are
+         *  widened to the item type as needed; a type that can't hold every
+         *  value of the array's element type (such as 'long' for a
+         *  Float64Array) throws. BigInt64Array and BigUint64Array only
+         *  fit 'comp' and 'ucom', since no other item type holds every
+         *  64-bit integer.
+         * @param type - The item type: 'shor', 'long', 'magn' (uint32),
+         *  'comp' (int64), 'ucom' (uint64), 'sing' or 'doub'.
+         * @param array - The values of the items.
+         * @returns The list descriptor.
+         */
+        public static fromTypedArray(
+            type: DescType,
+            array: NumericTypedArray
+        ): AEListDescriptor;
+    }
+
+    /**
+     * The typed arrays `AEListDescriptor.fromTypedArray()` accepts.
+     */
+    type NumericTypedArray =
+        | Int8Array
+        | Uint8Array
+        | Uint8ClampedArray
+        | Int16Array
+        | Uint16Array
+        | Int32Array
+        | Uint32Array
+        | BigInt64Array
+        | BigUint64Array
+        | Float32Array
+        | Float64Array;
+
+    /**
+     * Options for `AEListDescriptor.iterate()`.
+     */
+    export interface ListBatchOptions {
+        /**
+         * Items per batch, from 1 to 1048576. Bounds both how many items are
+         *  held natively at once and how long the event loop spends on each
+         *  batch. Defaults to 1024.
+         */
+        batchSize?: number;
+        /**
+         * Whether the next batch is read while the current one is consumed.
+         *  Turning this off trades latency for never holding a batch nobody
+         *  has asked for yet. Defaults to true.
+         */
+        readAhead?: boolean;
+        /**
+         * Yields `toJSValue()` results (with these options, if an object)
+         *  instead of wrappers. Defaults to false.
+         */
+        values?: boolean | ToJSValueOptions;
     }
 
     /**
@@ -105,6 +377,45 @@ declare module '#ae_js_bridge_native' {
          * The fields of the descriptor.
          */
         public readonly fields: Record<AEKeyword, AEDescriptor>;
+
+        /**
+         * The number of fields in the descriptor.
+         */
+        public readonly count: number;
+
+        /**
+         * Gets a single field of the descriptor without reading the others.
+         *  Large records build an index of their keywords on first use, so
+         *  later lookups don't scan the record.
+         * @param keyword - The keyword of the field.
+         * @returns The field, or undefined if the descriptor has no such field.
+         */
+        public getField(keyword: AEKeyword): AEDescriptor | undefined;
+
+        /**
+         * Checks for a field without copying it out of the descriptor.
+         * @param keyword - The keyword of the field.
+         * @returns Whether the descriptor has a field with the keyword.
+         */
+        public hasField(keyword: AEKeyword): boolean;
+
+        /**
+         * Lists the keywords of the descriptor's fields, in order, without
+         *  reading the fields themselves.
+         * @returns The keywords of the fields.
+         */
+        public keys(): AEKeyword[];
+
+        /**
+         * @deprecated Use `getField`.
+         */
+        public fieldAt(keyword: AEKeyword): AEDescriptor | undefined;
+
+        /**
+         * Iterates over the `[keyword, field]` entries of the descriptor,
+         *  reading each one only when it is reached.
+         */
+        public [Symbol.iterator](): IterableIterator<[AEKeyword, AEDescriptor]>;
     }
 
     /**
@@ -117,8 +428,11 @@ declare module '#ae_js_bridge_native' {
          * @param eventClass - The event class of the descriptor.
          * @param eventID - The event ID of the descriptor.
          * @param target - The target of the descriptor.
-         * @param returnID - The return ID of the descriptor.
-         * @param transactionID - The transaction ID of the descriptor.
+         * @param returnID - The return ID of the descriptor, an integer
+         *  from -32768 to 32767; anything else throws a RangeError.
+         * @param transactionID - The transaction ID of the descriptor, an
+         *  integer from -2147483648 to 2147483647; anything else throws a
+         *  RangeError.
          * @param parameters - The parameters of the descriptor.
          * @param attributes - The attributes of the descriptor.
          */
@@ -162,12 +476,47 @@ declare module '#ae_js_bridge_native' {
          */
         public readonly parameters: Record<AEKeyword, AEDescriptor>;
 
+        /**
+         * Gets a single parameter of the descriptor without reading the others.
+         * @param keyword - The keyword of the parameter.
+         * @returns The parameter, or undefined if the event has no such
+         *  parameter.
+         */
+        public getParameter(keyword: AEKeyword): AEDescriptor | undefined;
+
+        /**
+         * Reads a parameter as text, coercing it if needed, without wrapping
+         *  it in a descriptor.
+         * @param keyword - The keyword of the parameter.
+         * @returns The text, or undefined if the event has no such parameter.
+         */
+        public getParameterString(keyword: AEKeyword): string | undefined;
+
+        /**
+         * Reads a parameter as a 32-bit signed integer, coercing it if needed,
+         *  without wrapping it in a descriptor.
+         * @param keyword - The keyword of the parameter.
+         * @returns The integer, or undefined if the event has no such
+         *  parameter.
+         */
+        public getParameterInt32(keyword: AEKeyword): number | undefined;
+
         /**
          * Gets an attribute of the descriptor.
          * @param keyword - The keyword of the attribute.
          * @returns The attribute of the descriptor.
          */
         public getAttribute(keyword: AEKeyword): AEDescriptor | undefined;
+
+        /**
+         * Gets several attributes of the descriptor in one call.
+         * @param keywords - The keywords of the attributes.
+         * @returns The attributes, in the same order as `keywords`, with
+         *  undefined for any the event doesn't have.
+         */
+        public getAttributes(
+            keywords: AEKeyword[]
+        ): (AEDescriptor | undefined)[];
     }
 
     /**
@@ -176,6 +525,83 @@ declare module '#ae_js_bridge_native' {
     export class AEUnknownDescriptor extends AEDescriptor {
     }
 
+    /**
+     * How to address an `AETarget`: by bundle ID, process ID or
+     *  `typeApplicationURL` URL.
+     */
+    export type AETargetSpec =
+        | { bundleID: string }
+        | { pid: number }
+        | { url: string };
+
+    /**
+     * An application to send events to. Its address descriptor is built
+     *  once and kept, and events are created against it directly.
+     *
+     * A bundle ID is resolved to the process running it, if any, and then
+     *  addressed by process ID. Once that process is gone (sends fail with
+     *  `procNotFound`), `resolve()` looks the bundle ID up again.
+     */
+    export class AETarget {
+        /**
+         * Creates a new target, resolving it if it is given by bundle ID.
+         * @param spec - How to address the target.
+         */
+        public constructor(spec: AETargetSpec);
+
+        /**
+         * The address descriptor events are created with. Shared with the
+         *  target rather than copied.
+         */
+        public readonly address: AEDescriptor;
+
+        /**
+         * The process the target is addressed to, or null if it isn't
+         *  addressed by process ID (a URL, or a bundle ID that wasn't running
+         *  when last resolved).
+         */
+        public readonly pid: number | null;
+
+        /**
+         * Checks whether the target is running. A target resolved from a
+         *  bundle ID only counts as running while its process still has that
+         *  bundle ID.
+         * @returns Whether the target is running, or null for URL targets,
+         *  which can't be told without sending to them.
+         */
+        public isAlive(): boolean | null;
+
+        /**
+         * Looks the target's bundle ID up again, readdressing it if the
+         *  application is now running as a different process. Events already
+         *  created keep their address. Other targets have nothing to look up.
+         * @returns What `isAlive()` returns afterwards.
+         */
+        public resolve(): boolean | null;
+
+        /**
+         * Creates an event addressed to the target.
+         * @param eventClass - The event class of the event.
+         * @param eventID - The event ID of the event.
+         * @param parameters - The parameters of the event.
+         * @param attributes - The attributes of the event.
+         * @param returnID - The return ID of the event, an integer from
+         *  -32768 to 32767; anything else throws a RangeError. Defaults to
+         *  `kAutoGenerateReturnID`.
+         * @param transactionID - The transaction ID of the event, an integer
+         *  from -2147483648 to 2147483647; anything else throws a RangeError.
+         *  Defaults to `kAnyTransactionID`.
+         */
+        public createEvent(
+            eventClass: AEEventClass,
+            eventID: AEEventID,
+            parameters?: Record<AEKeyword, AEDescriptor>,
+            attributes?: Record<AEKeyword, AEDescriptor>,
+            returnID?: number,
+            transactionID?: number
+        ): AEEventDescriptor;
+    }
+
     /**
      * Error class for native API failures. Exposes the underlying OSErr as
      * a numeric `code` property.
@@ -187,25 +613,275 @@ declare module '#ae_js_bridge_native' {
         public readonly code: number;
     }
 
+    /**
+     * Options for `sendAppleEvent`.
+     */
+    export interface SendAppleEventOptions {
+        /**
+         * Decodes the reply's parameters on the worker thread, and resolves to
+         *  them as plain values (as `toJSValue()` would, with these options
+         *  if an object) instead of a reply descriptor. This keeps decoding
+         *  large replies off the event loop. Defaults to false.
+         */
+        decodeReply?: boolean | ToJSValueOptions;
+        /**
+         * Whether to wait for a reply. Only read when `expectReply` isn't
+         *  passed as its own argument. Defaults to true.
+         */
+        expectReply?: boolean;
+        /**
+         * How long to wait for a reply, in milliseconds, before rejecting with
+         *  `errAETimeout`. Rounded up to whole ticks (1/60 s); `Infinity`
+         *  waits indefinitely. Defaults to the system timeout (about a
+         *  minute).
+         */
+        timeoutMs?: number;
+        /**
+         * Additional send-mode flags.
+         */
+        mode?: {
+            /**
+             * Never let the target interact with the user (`kAENeverInteract`).
+             */
+            neverInteract?: boolean;
+            /**
+             * Let the target come to the front if it needs to interact with
+             *  the user (`kAECanSwitchLayer`).
+             */
+            canSwitchLayer?: boolean;
+            /**
+             * Don't record the event (`kAEDontRecord`).
+             */
+            dontRecord?: boolean;
+        };
+        /**
+         * Rejects the promise with the signal's reason as soon as it aborts.
+         *  A send still waiting for a thread is dropped unsent; one already
+         *  underway can't be recalled, so its reply (if any) is discarded
+         *  once it arrives or times out.
+         */
+        signal?: AbortSignal;
+        /**
+         * Sends with `kAEQueueReply` instead of waiting on a thread for the
+         *  reply. The reply comes back as an `aevt/ansr` event, which the
+         *  bridge's own handler matches to the send by its return ID, so any
+         *  number of sends can wait at once without blocking a thread. This
+         *  needs Apple events to be dispatched to the process, as
+         *  `handleAppleEvent` does, which is why it won't take `aevt/ansr`.
+         *  Two sends can't wait on the same return ID at once, so
+         *  sending one event again before its reply arrives rejects.
+         *  `timeoutMs` still applies, checked about every 100 ms. Not
+         *  supported by `sendAppleEvents`. Defaults to false.
+         */
+        queueReply?: boolean;
+    }
+
     /**
      * Sends an Apple event and returns a promise that resolves to the reply.
      * @param event - The event to send.
      * @param expectReply - Whether to expect a reply from the Apple event.
-     * @returns A promise that resolves to the reply event, or
-     *  null if no reply is expected.
+     * @param options - How to send the event and return its reply.
+     * @returns A promise that resolves to the reply event (or its decoded
+     *  parameters, keyed by keyword), or null if no reply is expected.
      */
     export function sendAppleEvent(
         event: AEEventDescriptor,
-        expectReply: true
+        expectReply: true,
+        options: SendAppleEventOptions & {
+            decodeReply: true | ToJSValueOptions
+        }
+    ): Promise<Record<AEKeyword, unknown>>;
+    export function sendAppleEvent(
+        event: AEEventDescriptor,
+        expectReply: true,
+        options?: SendAppleEventOptions & { decodeReply?: false }
     ): Promise<AEEventDescriptor>;
     export function sendAppleEvent(
         event: AEEventDescriptor,
-        expectReply: false
+        expectReply: false,
+        options?: SendAppleEventOptions
     ): Promise<null>;
     export function sendAppleEvent(
         event: AEEventDescriptor,
-        expectReply: boolean
-    ): Promise<AEEventDescriptor | null>;
+        expectReply: boolean,
+        options?: SendAppleEventOptions
+    ): Promise<AEEventDescriptor | Record<AEKeyword, unknown> | null>;
+    export function sendAppleEvent(
+        event: AEEventDescriptor,
+        options: SendAppleEventOptions & {
+            expectReply?: true,
+            decodeReply: true | ToJSValueOptions
+        }
+    ): Promise<Record<AEKeyword, unknown>>;
+    export function sendAppleEvent(
+        event: AEEventDescriptor,
+        options?: SendAppleEventOptions & {
+            expectReply?: true,
+            decodeReply?: false
+        }
+    ): Promise<AEEventDescriptor>;
+    export function sendAppleEvent(
+        event: AEEventDescriptor,
+        options: SendAppleEventOptions & { expectReply: false }
+    ): Promise<null>;
+    export function sendAppleEvent(
+        event: AEEventDescriptor,
+        options?: SendAppleEventOptions
+    ): Promise<AEEventDescriptor | Record<AEKeyword, unknown> | null>;
+
+    /**
+     * What a batch of sends produced, in the order the events were given.
+     */
+    interface SendAppleEventsResult<T> {
+        /**
+         * Each send's reply (or decoded parameters), or null if it failed or
+         *  no reply was expected.
+         */
+        results: (T | null)[];
+        /**
+         * What each send failed with (usually an `OSError`), or null if it
+         *  succeeded.
+         */
+        errors: (Error | null)[];
+    }
+
+    /**
+     * Sends a batch of Apple events from a single call, with the same options
+     *  for each. The sends are pipelined across the send threads, and the
+     *  promise resolves once all of them have finished; one failing doesn't
+     *  fail the others. Aborting `options.signal` rejects the whole batch.
+     * @param events - The events to send.
+     * @param options - How to send the events and return their replies.
+     * @returns A promise that resolves to each send's reply and error.
+     */
+    export function sendAppleEvents(
+        events: AEEventDescriptor[],
+        options: SendAppleEventOptions & {
+            expectReply?: true,
+            decodeReply: true | ToJSValueOptions
+        }
+    ): Promise<SendAppleEventsResult<Record<AEKeyword, unknown>>>;
+    export function sendAppleEvents(
+        events: AEEventDescriptor[],
+        options?: SendAppleEventOptions & {
+            expectReply?: true,
+            decodeReply?: false
+        }
+    ): Promise<SendAppleEventsResult<AEEventDescriptor>>;
+    export function sendAppleEvents(
+        events: AEEventDescriptor[],
+        options: SendAppleEventOptions & { expectReply: false }
+    ): Promise<SendAppleEventsResult<never>>;
+    export function sendAppleEvents(
+        events: AEEventDescriptor[],
+        options?: SendAppleEventOptions
+    ): Promise<
+        SendAppleEventsResult<AEEventDescriptor | Record<AEKeyword, unknown>>
+    >;
+
+    /**
+     * How the threads that send Apple events are set up. Sends don't use
+     *  libuv's thread pool, so a slow target can't hold up `fs`, `crypto`
+     *  or `zlib`.
+     */
+    interface SendExecutorOptions {
+        /**
+         * Threads sends block on. Defaults to 4.
+         */
+        threads?: number;
+        /**
+         * Sends that can wait for a thread, across all targets. A send past
+         *  this rejects with `memFullErr`. Defaults to 4096.
+         */
+        queueCapacity?: number;
+        /**
+         * Sends to the same target that can be in progress at once, so one
+         *  unresponsive target can't take every thread. 0 (the default) means
+         *  half the threads, but at least one.
+         */
+        maxPerTarget?: number;
+        /**
+         * Sends to the same target that can wait for a thread, so one
+         *  unresponsive target can't fill the queue for every other. A send
+         *  past this rejects with `memFullErr`. 0 (the default) means a
+         *  quarter of `queueCapacity`, but at least one.
+         */
+        maxQueuedPerTarget?: number;
+    }
+
+    /**
+     * Configures the send threads. Only possible before the first send, as
+     *  the threads are fixed once started.
+     * @param options - How to set up the threads.
+     */
+    export function configureSendExecutor(options: SendExecutorOptions): void;
+
+    /**
+     * A reading of the send threads' gauges and counters.
+     */
+    interface SendExecutorStats {
+        /**
+         * Sends waiting for a thread.
+         */
+        queueDepth: number;
+        /**
+         * The most sends that can wait for a thread.
+         */
+        queueCapacity: number;
+        /**
+         * The most sends to one target that can wait for a thread.
+         */
+        maxQueuedPerTarget: number;
+        /**
+         * Sends in progress.
+         */
+        inFlight: number;
+        /**
+         * Sends queued so far.
+         */
+        submitted: number;
+        /**
+         * Sends finished so far.
+         */
+        completed: number;
+        /**
+         * Sends turned away because the queue, or their target's share of
+         *  it, was full.
+         */
+        rejected: number;
+        /**
+         * Of `rejected`, those turned away by `maxQueuedPerTarget`.
+         */
+        rejectedForTarget: number;
+        /**
+         * Sends run by a thread other than the one their target queues on.
+         */
+        stolen: number;
+        /**
+         * Per-thread figures, since the threads started.
+         */
+        threads: {
+            /**
+             * Time spent sending, including any send in progress.
+             */
+            busyMs: number;
+            /**
+             * `busyMs` as a fraction of the time since the threads started.
+             */
+            utilization: number;
+            /**
+             * Sends finished on this thread.
+             */
+            completed: number;
+        }[];
+    }
+
+    /**
+     * Reads the send threads' gauges, starting the threads if they haven't
+     *  been yet.
+     * @returns The current reading.
+     */
+    export function getSendExecutorStats(): SendExecutorStats;
 
     /**
      * An object of parameters for an Apple event handler to
@@ -221,6 +897,8 @@ declare module '#ae_js_bridge_native' {
      *  is received with the given event class and event ID.
      * The handler function should return an object of parameters if
      *  a reply is expected, or null if a reply is not expected.
+     * Throws for `aevt/ansr`, which the bridge handles itself to match
+     *  replies to `queueReply` sends.
      */
     export function handleAppleEvent(
         eventClass: AEEventClass,
@@ -231,7 +909,8 @@ declare module '#ae_js_bridge_native' {
 
     /**
      * Deregisters an Apple event handler for the given event class and event ID.
-     * If no handler is registered for the pair, this is a no-op.
+     * If no handler is registered for the pair, this is a no-op. Throws for
+     *  `aevt/ansr`, whose handler belongs to the bridge.
      * @param eventClass - The event class of the Apple event handler.
      * @param eventID - The event ID of the Apple event handler.
      */
@@ -239,4 +918,41 @@ declare module '#ae_js_bridge_native' {
         eventClass: AEEventClass,
         eventID: AEEventID
     ): void;
+
+    /**
+     * Chooses how native APIs return codes (`descriptorType`, record keys,
+     *  event classes and IDs): as 4-character strings (the default) or as
+     *  uint32s, which compare without any string conversion. In numeric
+     *  mode, objects keyed by keyword (such as record fields) also accept
+     *  decimal keys, since JS turns numeric keys into strings; elsewhere,
+     *  numeric codes must be passed as numbers.
+     * @param mode - The form to return codes in.
+     */
+    export function setFourCharCodeMode(mode: 'string' | 'number'): void;
+
+    /**
+     * How much descriptor copying the bridge has done so far, process-wide.
+     *  Take a reading before and after an operation to see what it copied.
+     */
+    interface DescriptorCopyCounts {
+        /**
+         * Descriptors duplicated because the bridge needed one of its own.
+         */
+        duplicates: number;
+        /**
+         * Nodes the portable engine cloned to change a shared descriptor.
+         *  Always 0 on CoreServices.
+         */
+        clonedNodes: number;
+        /**
+         * Bytes of data copied by those clones. Always 0 on CoreServices.
+         */
+        clonedBytes: number;
+    }
+
+    /**
+     * Reads the bridge's descriptor copy counters.
+     * @returns The counts so far.
+     */
+    export function getDescriptorCopyCounts(): DescriptorCopyCounts;
 }
\ No newline at end of file